@@ -10,17 +10,22 @@
 #include "Game.hpp"
 #include "Review.hpp"
 #include "Platform.hpp"
+#include "ScreenRenderer.hpp"
+#include "TerminalInput.hpp"
+#include "TableView.hpp"
+#include "EntityPicker.hpp"
+#include "NameTrie.hpp"
+#include "CompletionPrompt.hpp"
+#include "EntityLoader.hpp"
+#include "CatalogStore.hpp"
+#include "CatalogSnapshot.hpp"
+#include "SyncEngine.hpp"
+#include "GameSummary.hpp"
+#include "GameRecommender.hpp"
+#include "ReviewAnomalyDetector.hpp"
+#include "ReviewCardinality.hpp"
 #include <sstream>
 
-// Для работы со стрелочками и Enter на Windows/Linux/macOS
-#ifdef _WIN32
-    #include <conio.h>
-    #include <windows.h>
-#else
-    #include <unistd.h>
-    #include <termios.h>
-#endif
-
 class AdminPanel {
 private:
     std::shared_ptr<DatabaseConnection> db;
@@ -28,6 +33,17 @@ private:
     std::shared_ptr<Game> gameMgr;
     std::shared_ptr<Review> reviewMgr;
     std::shared_ptr<Platform> platformMgr;
+    ScreenRenderer screen;
+    TerminalInput input;
+
+    // Кэш статистики главного экрана, обновляется по таймеру
+    struct DashboardStats {
+        int games = 0;
+        int categories = 0;
+        int users = 0;
+        int platforms = 0;
+    };
+    DashboardStats stats;
 
     // Текущее состояние меню
     enum MenuState {
@@ -45,11 +61,14 @@ private:
 
     // Вспомогательные функции
     void clearScreen();
-    int getKeyPress(); // Получить нажатую клавишу (стрелочка, Enter, ESC)
-    void displayMenu(const std::vector<std::string>& options, int selected);
-    void printHeader(const std::string& title);
+    KeyEvent getKeyPress(); // Получить нажатую клавишу (стрелочки, PgUp/PgDn, Home/End, Enter, ESC)
+    void displayMenu(const std::vector<std::string>& options, int selected,
+                     std::ostream& out = std::cout);
+    void printHeader(const std::string& title, std::ostream& out = std::cout);
     void printSeparator();
     void pause();
+    void refreshStatistics();
+    void renderMainMenu(const std::vector<std::string>& options, int selected);
 
     // Обработчики меню
     void handleMainMenu();
@@ -91,19 +110,72 @@ private:
 
     private:
     // Display functions - показываем списки
-    void displayAvailableUsers();
-    void displayAvailableGames();
     void displayAvailablePlatforms();
     void displayAvailableCategories();
 
+    // Прокручиваемые таблицы со страницами из менеджеров
+    TableView makeUsersTable();
+    TableView makeGamesTable();
+    TableView makeReviewsTable(int gameId, const std::string& title);
+
     // Validation functions - везде проверки
-    bool validateUserId(int userId);
-    bool validateGameId(int gameId);
-    bool validatePlatformId(int platformId);
-    bool validateCategoryId(int categoryId);
     bool validateMarkRange(int mark);
     bool validateStringInput(const std::string& input, int minLen, int maxLen);
 
+    // Снимок каталога (читается без блокировок) и индексы имен для выбора сущностей.
+    // Записи менеджеров приходят событиями EventBus и точечно меняют снимок;
+    // изменения других клиентов подтягивает syncCatalog по таймеру.
+    CatalogStore catalogStore;
+    std::string catalogSnapshotPath;    // пусто - снимок на диск не сохраняется
+    bool catalogSyncEnabled = false;    // нужна миграция add_change_tracking.sql
+    std::unique_ptr<SyncEngine> syncEngine;
+    CatalogStore::ReadGuard readCatalog();
+    void loadCatalog();
+    bool reloadCatalog();
+    void syncCatalog();
+    void resetSearchIndexes();
+    void saveCatalogSnapshot();
+    void applyCatalogChange(const std::function<bool(Catalog&)>& change);
+    std::shared_ptr<EventBus> events;
+    std::vector<int> eventSubscriptions;
+    void subscribeCatalogEvents();
+    std::shared_ptr<GameSummary> gameSummary;   // nullptr - game_summary не ведется
+    std::unique_ptr<FuzzyIndex> userIndex;
+    std::unique_ptr<FuzzyIndex> gameIndex;
+    std::unique_ptr<FuzzyIndex> platformIndex;
+    std::unique_ptr<FuzzyIndex> categoryIndex;
+    int pickEntity(const FuzzyIndex& index, const std::string& title);
+    // Дополнение имен и проверка занятости без запросов к БД; строятся из каталога
+    // и обновляются событиями менеджеров. score игры - число отзывов
+    std::unique_ptr<NameTrie> usernameTrie;
+    std::unique_ptr<NameTrie> gameTitleTrie;
+    NameTrie& getUsernameTrie();
+    NameTrie& getGameTitleTrie();
+    uint32_t catalogReviewCount(int gameId);
+
+    // Соседи игр по оценкам; строятся вручную (Rebuild Recommendations) и хранятся в файле
+    GameRecommender recommender;
+    std::string recommendationsPath;    // пусто - списки живут только до выхода
+    uint32_t recommendationNeighbors = GameRecommender::DEFAULT_NEIGHBORS;
+    bool ensureRecommendations();
+
+    // Всплески отзывов: при первом открытии Review Alerts - отзывы за последние
+    // anomalyBackfillDays дней, дальше - отзывы новее учтенных (при синхронизации и открытии)
+    ReviewAnomalyDetector anomalyDetector;
+    int anomalyBackfillDays = 14;
+    bool anomaliesBackfilled = false;
+    void pollReviewAnomalies();
+
+    // Скетчи различных авторов и игр по дням: файл при выходе, при первом
+    // открытии Distinct Reviewers - файл, при каждом - отзывы новее учтенных
+    ReviewCardinality reviewCardinality;
+    std::string reviewCardinalityPath;  // пусто - скетчи строятся заново при каждом запуске
+    bool reviewCardinalityReady = false;
+    bool ensureReviewCardinality();
+
+    std::string exportPath;             // пусто - экспорт выключен
+    void exportJson();
+
     // Input functions - ввод с проверкой
     int getValidatedUserId();
     int getValidatedGameId();
@@ -126,16 +198,24 @@ private:
     void updateGame();
     void deleteGame();
     void manageCategories();
+    void rebuildGameSummary();
 
     // Review operations
     void addReview();
     void viewGameReviews();
     void deleteGameReviews();
+    void showSimilarGames();
+    void showUserRecommendations();
+    void rebuildRecommendations();
+    void showReviewAnomalies();
+    void showDistinctReviewers();
 
     // Platform operations
     void showAllPlatforms();
     void addNewPlatform();
     void deletePlatform();
+    // Игры, доступные на всех выбранных платформах, и их цены (индекс связей каталога)
+    void showCrossPlatformPrices();
 
 public:
     AdminPanel(std::shared_ptr<DatabaseConnection> connection,
@@ -143,6 +223,35 @@ public:
                std::shared_ptr<Game> game,
                std::shared_ptr<Review> review,
                std::shared_ptr<Platform> platform);
+    ~AdminPanel();
+
+    // Подписка каталога на изменения, которые публикуют менеджеры
+    void setEventBus(std::shared_ptr<EventBus> bus);
+    // Таблица game_summary для GET /api/games (config.json: game_summary)
+    void setGameSummary(std::shared_ptr<GameSummary> summary) { gameSummary = summary; }
+
+    // Файл снимка каталога для быстрого старта (config.json: catalog_snapshot)
+    void setCatalogSnapshotPath(const std::string& path) { catalogSnapshotPath = path; }
+    void setCatalogSync(bool enabled) { catalogSyncEnabled = enabled; }
+
+    // Файл списков похожих игр и их длина (config.json: recommendations)
+    void setRecommendations(const std::string& path, uint32_t neighbors) {
+        recommendationsPath = path;
+        recommendationNeighbors = neighbors;
+    }
+
+    // Файл скетчей различных авторов (config.json: review_cardinality)
+    void setReviewCardinalityPath(const std::string& path) { reviewCardinalityPath = path; }
+
+    // Файл выгрузки Export to JSON (config.json: features.enable_export, export_file)
+    void setExportPath(const std::string& path) { exportPath = path; }
+
+    // Порог и размер корзин детектора всплесков (config.json: review_anomalies)
+    void setReviewAnomalies(const ReviewAnomalyDetector::Settings& settings, int backfillDays) {
+        anomalyDetector = ReviewAnomalyDetector(settings);
+        anomalyBackfillDays = backfillDays;
+        anomaliesBackfilled = false;
+    }
 
     void run();
 };
@@ -0,0 +1,45 @@
+#ifndef AUDIT_LOG_HPP
+#define AUDIT_LOG_HPP
+
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "EventBus.hpp"
+
+// Журнал изменений (config.json: features.log_file): одна строка на событие
+// EventBus, только изменившиеся поля. Строки формируются в потоке писателя,
+// в файл их пачками пишет фоновый поток - меню не ждет диска.
+// События не схлопываются: в журнал попадает каждая запись.
+class AuditLog {
+private:
+    std::shared_ptr<EventBus> bus;
+    std::ofstream out;
+    std::vector<int> subscriptions;
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::vector<std::string> pending;
+    bool stopping = false;
+    std::thread worker;
+
+    template <typename Entity>
+    void track();
+    void enqueue(std::string line);
+    void run();
+
+public:
+    AuditLog(std::shared_ptr<EventBus> eventBus, const std::string& path);
+    // Отписка и запись оставшихся строк
+    ~AuditLog();
+
+    AuditLog(const AuditLog&) = delete;
+    AuditLog& operator=(const AuditLog&) = delete;
+
+    bool isOpen() const { return out.is_open(); }
+};
+
+#endif // AUDIT_LOG_HPP
@@ -0,0 +1,203 @@
+#ifndef CATALOG_HPP
+#define CATALOG_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "ColumnStore.hpp"
+#include "User.hpp"
+#include "Game.hpp"
+#include "Platform.hpp"
+#include "Review.hpp"
+
+// Колонки таблиц каталога: строка i каждой колонки - одна сущность
+struct UserColumns {
+    Column<int32_t> id;
+    Column<StringRef> name;
+    Column<uint16_t> privilege;     // код в словаре привилегий
+    Column<uint8_t> active;
+};
+
+struct CategoryColumns {
+    Column<int32_t> id;
+    Column<uint16_t> name;          // код в словаре названий категорий
+    Column<StringRef> description;
+};
+
+struct GameColumns {
+    Column<int32_t> id;
+    Column<StringRef> name;
+    Column<StringRef> description;
+    Column<int16_t> releaseYear;
+    Column<double> productionCost;
+    Column<uint16_t> category;      // строка в CategoryColumns, NO_ROW16 - неизвестна
+    Column<StringRef> imageURL;
+    Column<uint8_t> active;
+    Column<uint32_t> reviewCount;   // агрегаты отзывов: среднее = markSum / reviewCount
+    Column<uint32_t> markSum;
+};
+
+struct PlatformColumns {
+    Column<int32_t> id;
+    Column<StringRef> name;
+    Column<uint16_t> type;          // код в словаре типов платформ
+    Column<StringRef> description;
+};
+
+// Связи игра-платформа (game_s_platfo), хранятся по ID
+struct GamePlatformColumns {
+    Column<int32_t> game;
+    Column<int32_t> platform;
+    Column<StringRef> releaseDate;
+    Column<double> price;
+};
+
+// Весь справочник в памяти в виде колонок (struct-of-arrays): строки лежат
+// в общей арене, повторяющиеся значения закодированы словарями.
+// Хэши паролей сюда не попадают.
+class Catalog {
+private:
+    friend class CatalogSnapshot;
+
+    StringArena strings;
+    StringDictionary privileges;
+    StringDictionary categoryNames;
+    StringDictionary platformTypes;
+
+    UserColumns users;
+    CategoryColumns categories;
+    GameColumns games;
+    PlatformColumns platforms;
+    GamePlatformColumns gamePlatforms;
+
+    // Номера строк, отсортированные по ID - поиск строки бинарным поиском
+    Column<uint32_t> usersById;
+    Column<uint32_t> categoriesById;
+    Column<uint32_t> gamesById;
+    Column<uint32_t> platformsById;
+
+    // Связи игра-платформа в формате CSR в обе стороны: ключи по возрастанию,
+    // строки ключа k - links*[offsets[k] .. offsets[k + 1])
+    Column<int32_t> linkGames;
+    Column<uint32_t> linkGameOffsets;
+    Column<uint32_t> linksByGame;       // строки gamePlatforms по (game, platform)
+    Column<int32_t> linkPlatforms;
+    Column<uint32_t> linkPlatformOffsets;
+    Column<uint32_t> linksByPlatform;   // строки gamePlatforms по (platform, game)
+    Column<int32_t> platformGames;      // game для linksByPlatform[i] - пересечение без обращения к строкам
+
+    // Время сервера (NOW()) на момент загрузки - с него catchUp берет изменения
+    std::string watermark;
+    // Файл снимка, из которого заимствованы колонки; живет, пока жива любая копия каталога
+    std::shared_ptr<const void> backing;
+
+    void compactGames(const std::vector<uint8_t>& keep);
+    void compactGamePlatforms(const std::vector<uint8_t>& keep);
+
+    static void buildIdOrder(const Column<int32_t>& ids, Column<uint32_t>& order);
+    static uint32_t findRow(const Column<int32_t>& ids, const Column<uint32_t>& order, int id);
+    // Сортировка подсчетом строк связей по from, внутри ключа - по to
+    static void buildAdjacency(const Column<int32_t>& from, const Column<int32_t>& to, Column<int32_t>& keys,
+                               Column<uint32_t>& offsets, Column<uint32_t>& rows);
+    static std::pair<size_t, size_t> adjacencyRange(const Column<int32_t>& keys,
+                                                    const Column<uint32_t>& offsets, int key);
+
+public:
+    static constexpr uint32_t NO_ROW = UINT32_MAX;
+    static constexpr uint16_t NO_ROW16 = 0xFFFF;
+
+    // Полная загрузка из БД; false - каталог пуст
+    bool load(User& userMgr, Game& gameMgr, Platform& platformMgr, Review& reviewMgr);
+    const std::string& getWatermark() const { return watermark; }
+    void setWatermark(const std::string& serverTime) { watermark = serverTime; }
+    void clear();
+
+    void addUser(int id, std::string_view name, std::string_view privilege, bool active);
+    void addCategory(int id, std::string_view name, std::string_view description);
+    // Категории добавляются раньше игр
+    void addGame(int id, std::string_view name, std::string_view description, int releaseYear,
+                 double productionCost, int idCategory, std::string_view imageURL, bool active);
+    void addPlatform(int id, std::string_view name, std::string_view type,
+                     std::string_view description);
+    void addGamePlatform(int gameId, int platformId, std::string_view releaseDate, double price);
+    // add*, если ID нет в индексе, иначе обновление строки на месте
+    void upsertUser(int id, std::string_view name, std::string_view privilege, bool active);
+    void upsertCategory(int id, std::string_view name, std::string_view description);
+    void upsertGame(int id, std::string_view name, std::string_view description, int releaseYear,
+                    double productionCost, int idCategory, std::string_view imageURL, bool active);
+    void upsertPlatform(int id, std::string_view name, std::string_view type,
+                        std::string_view description);
+    void upsertGamePlatform(int gameId, int platformId, std::string_view releaseDate, double price);
+    // После add*/upsert*: пересобрать индексы по ID
+    void buildIndexes();
+
+    // Строки из scan*-запросов менеджеров: новые ID добавляются, известные обновляются.
+    // Связи и рейтинги - после игр; после applyGamePlatforms нужен buildIndexes.
+    void applyUsers(ResultSet userRows);
+    void applyCategories(ResultSet categoryRows);
+    void applyGames(ResultSet gameRows);
+    void applyPlatforms(ResultSet platformRows);
+    void applyGamePlatforms(ResultSet linkRows);
+    void applyRatings(ResultSet ratingRows);
+
+    // Точечные изменения для писателя CatalogStore (на своей копии каталога).
+    // Вызывают buildIndexes сами; старые строки остаются в арене до следующей загрузки.
+    bool removeUser(int userId);
+    bool setUserPrivilege(int userId, std::string_view privilege);
+    bool removeCategory(int categoryId);
+    bool removeGame(int gameId);
+    // Пачкой: один проход по колонкам и одна пересборка индексов; вернет число удаленных
+    size_t removeGames(const std::vector<int>& gameIds);
+    bool removePlatform(int platformId);
+    bool removeGamePlatform(int gameId, int platformId);
+    size_t removeGamePlatforms(const std::vector<std::pair<int, int>>& links);
+    bool setGamePlatformPrice(int gameId, int platformId, double price);
+    bool setGameRating(int gameId, uint32_t reviewCount, uint32_t markSum);
+    // Один отзыв добавлен (+1, +mark), удален (-1, -mark) или изменена оценка (0, разница)
+    bool adjustGameRating(int gameId, int reviewDelta, int markDelta);
+
+    const UserColumns& getUsers() const { return users; }
+    const CategoryColumns& getCategories() const { return categories; }
+    const GameColumns& getGames() const { return games; }
+    const PlatformColumns& getPlatforms() const { return platforms; }
+    const GamePlatformColumns& getGamePlatforms() const { return gamePlatforms; }
+
+    size_t getUserCount() const { return users.id.size(); }
+    size_t getCategoryCount() const { return categories.id.size(); }
+    size_t getGameCount() const { return games.id.size(); }
+    size_t getPlatformCount() const { return platforms.id.size(); }
+    size_t getGamePlatformCount() const { return gamePlatforms.game.size(); }
+
+    uint32_t findUser(int userId) const;
+    uint32_t findCategory(int categoryId) const;
+    uint32_t findGame(int gameId) const;
+    uint32_t findPlatform(int platformId) const;
+    uint32_t findGamePlatform(int gameId, int platformId) const;
+    // Строки gamePlatforms для игры: linkRow(i) для i в [first, second)
+    std::pair<size_t, size_t> gamePlatformRange(int gameId) const;
+    uint32_t linkRow(size_t position) const { return linksByGame[position]; }
+    // Строки gamePlatforms для платформы (по возрастанию game): platformLinkRow(i) для i в [first, second)
+    std::pair<size_t, size_t> platformGameRange(int platformId) const;
+    uint32_t platformLinkRow(size_t position) const { return linksByPlatform[position]; }
+    // Игры, которые есть на всех платформах с ценой не выше maxPrice на каждой
+    // (maxPrice < 0 - без ограничения); по возрастанию ID
+    std::vector<int> gamesOnAllPlatforms(const std::vector<int>& platformIds, double maxPrice) const;
+
+    std::string_view text(StringRef ref) const { return strings.get(ref); }
+    std::string_view userName(uint32_t row) const;
+    std::string_view userPrivilege(uint32_t row) const;
+    std::string_view categoryName(uint32_t row) const;
+    std::string_view gameName(uint32_t row) const;
+    std::string_view gameCategoryName(uint32_t row) const;
+    double gameAverageMark(uint32_t row) const;
+    std::string_view platformName(uint32_t row) const;
+    std::string_view platformType(uint32_t row) const;
+
+    // Сколько байт занимает каталог (для сравнения с vector<GameData> и т.п.)
+    size_t memoryUsage() const;
+};
+
+#endif // CATALOG_HPP
@@ -0,0 +1,69 @@
+#ifndef CATALOG_SNAPSHOT_HPP
+#define CATALOG_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Catalog.hpp"
+
+// Файл, отображенный в память только для чтения. Страницы общие для всех
+// процессов, отобразивших тот же файл, и подгружаются ОС по мере обращения.
+class MappedFile {
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+// Снимок каталога на диске: колонки лежат в файле в том же виде, что и в памяти,
+// и после отображения заимствуются без разбора и копирования (Column::borrow).
+// Формат зависит от архитектуры; при изменении колонок Catalog поднять FORMAT_VERSION.
+//
+// Раскладка: SnapshotHeader, таблица секций, данные секций (выравнивание 8 байт).
+// checksum - FNV-1a 64 по всему, что после заголовка.
+class CatalogSnapshot {
+public:
+    static const uint32_t FORMAT_VERSION = 2;
+
+    struct SnapshotHeader {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t sectionCount;
+        uint64_t fileSize;
+        uint64_t checksum;
+        char watermark[32];     // время сервера, на которое снимок актуален
+    };
+
+    struct SnapshotSection {
+        uint32_t id;
+        uint32_t elementSize;
+        uint64_t offset;        // от начала файла
+        uint64_t count;
+    };
+
+    // Запись во временный файл и атомарная подмена (rename).
+    // watermark - время сервера, до которого изменения в catalog уже применены
+    static bool write(const Catalog& catalog, const std::string& path, const std::string& watermark);
+    // Каталог заимствует колонки из отображенного файла; false - файла нет или он поврежден
+    static bool read(const std::string& path, Catalog& catalog);
+
+private:
+    template <typename CatalogType, typename Visitor>
+    static void forEachColumn(CatalogType& catalog, Visitor&& visit);
+};
+
+#endif // CATALOG_SNAPSHOT_HPP
@@ -0,0 +1,94 @@
+#ifndef CATALOG_STORE_HPP
+#define CATALOG_STORE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Catalog.hpp"
+
+// Общий для потоков неизменяемый снимок каталога (RCU).
+// Читатели берут текущую версию без блокировок: объявляют эпоху в своем слоте
+// и читают атомарный указатель. Писатель (один, под writerMutex) собирает новую
+// версию на копии, атомарно подменяет указатель и освобождает старые версии,
+// когда ни один читатель больше не может их видеть.
+class CatalogStore {
+private:
+    static const size_t MAX_READERS = 64;
+
+    // Эпоха, объявленная читателем; 0 - слот свободен
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};
+    };
+
+    struct Snapshot {
+        Catalog catalog;
+        uint64_t version;
+    };
+
+    struct RetiredSnapshot {
+        const Snapshot* snapshot;
+        uint64_t retireEpoch;
+    };
+
+    std::atomic<const Snapshot*> current{nullptr};
+    std::atomic<uint64_t> globalEpoch{1};
+    std::atomic<uint64_t> publishedVersion{0};
+    ReaderSlot slots[MAX_READERS];
+
+    std::mutex writerMutex;
+    std::vector<RetiredSnapshot> retired;
+    uint64_t nextVersion = 1;
+
+    ReaderSlot* acquireSlot();
+    void publishLocked(std::unique_ptr<Snapshot> next);
+    size_t reclaimLocked();
+
+public:
+    // Держит снимок, пока жив; на время чтения слот занят
+    class ReadGuard {
+    private:
+        ReaderSlot* slot;
+        const Snapshot* snapshot;
+
+    public:
+        ReadGuard(ReaderSlot* s, const Snapshot* snap) : slot(s), snapshot(snap) {}
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard(ReadGuard&& other) noexcept : slot(other.slot), snapshot(other.snapshot) {
+            other.slot = nullptr;
+            other.snapshot = nullptr;
+        }
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+        bool isValid() const { return snapshot != nullptr; }
+        explicit operator bool() const { return isValid(); }
+        const Catalog& operator*() const { return snapshot->catalog; }
+        const Catalog* operator->() const { return &snapshot->catalog; }
+        uint64_t getVersion() const { return snapshot ? snapshot->version : 0; }
+    };
+
+    CatalogStore() = default;
+    ~CatalogStore();
+
+    CatalogStore(const CatalogStore&) = delete;
+    CatalogStore& operator=(const CatalogStore&) = delete;
+
+    // Читатели: без блокировок, писатель их не задерживает
+    ReadGuard read();
+    bool hasSnapshot() const;
+    uint64_t getVersion() const;
+
+    // Писатель
+    void publish(std::unique_ptr<Catalog> catalog);
+    bool reload(User& userMgr, Game& gameMgr, Platform& platformMgr, Review& reviewMgr);
+    // Копия текущей версии -> change(копия) -> публикация; false, если change вернул false
+    bool update(const std::function<bool(Catalog&)>& change);
+    size_t getRetiredCount();
+};
+
+#endif // CATALOG_STORE_HPP
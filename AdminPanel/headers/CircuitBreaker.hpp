@@ -0,0 +1,38 @@
+#ifndef CIRCUIT_BREAKER_HPP
+#define CIRCUIT_BREAKER_HPP
+
+#include <chrono>
+#include <mutex>
+
+// Пока БД недоступна, запросы отклоняются сразу, без ожидания таймаутов.
+// CLOSED -> (threshold ошибок подряд) -> OPEN -> (cooldown) -> HALF_OPEN -> одна проба.
+// Пока проба не завершилась (recordSuccess/recordFailure), остальные запросы отклоняются;
+// проба без результата дольше cooldown считается потерянной, и пропускается следующая.
+class CircuitBreaker {
+public:
+    enum class State {
+        CLOSED,
+        OPEN,
+        HALF_OPEN
+    };
+
+private:
+    int failureThreshold;
+    std::chrono::milliseconds cooldown;
+    int consecutiveFailures = 0;
+    State state = State::CLOSED;
+    std::chrono::steady_clock::time_point openedAt{};
+    bool probeInFlight = false;
+    std::chrono::steady_clock::time_point probeStartedAt{};
+    mutable std::mutex mutex;
+
+public:
+    CircuitBreaker(int threshold, int cooldownMs);
+
+    bool allowRequest();
+    void recordSuccess();
+    void recordFailure();
+    State getState() const;
+};
+
+#endif // CIRCUIT_BREAKER_HPP
@@ -0,0 +1,186 @@
+#ifndef COLUMN_STORE_HPP
+#define COLUMN_STORE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+// Колонка фиксированного размера: либо свой вектор, либо чужой буфер
+// (например, отображенный в память файл), который колонка только читает.
+template <typename T>
+class Column {
+private:
+    std::vector<T> owned;
+    const T* values = nullptr;
+    size_t count = 0;
+    bool borrowed = false;
+
+    // Перед записью в заимствованную колонку копируем данные к себе;
+    // дальше чтение идет из своей копии, а не из буфера
+    void detach() {
+        if (borrowed) {
+            owned.assign(values, values + count);
+            values = owned.data();
+            count = owned.size();
+            borrowed = false;
+        }
+    }
+
+public:
+    Column() = default;
+
+    // Копия своей колонки указывает на свой вектор, заимствованной - на тот же буфер
+    Column(const Column& other)
+        : owned(other.owned), values(other.borrowed ? other.values : owned.data()),
+          count(other.count), borrowed(other.borrowed) {}
+
+    Column(Column&& other) noexcept
+        : owned(std::move(other.owned)), values(other.values), count(other.count),
+          borrowed(other.borrowed) {
+        other.values = nullptr;
+        other.count = 0;
+        other.borrowed = false;
+    }
+
+    Column& operator=(const Column& other) {
+        if (this != &other) {
+            owned = other.owned;
+            borrowed = other.borrowed;
+            values = borrowed ? other.values : owned.data();
+            count = other.count;
+        }
+        return *this;
+    }
+
+    Column& operator=(Column&& other) noexcept {
+        if (this != &other) {
+            owned = std::move(other.owned);
+            values = other.values;
+            count = other.count;
+            borrowed = other.borrowed;
+            other.values = nullptr;
+            other.count = 0;
+            other.borrowed = false;
+        }
+        return *this;
+    }
+
+    void push_back(const T& value) {
+        detach();
+        owned.push_back(value);
+        values = owned.data();
+        count = owned.size();
+    }
+
+    void append(const T* data, size_t size) {
+        detach();
+        owned.insert(owned.end(), data, data + size);
+        values = owned.data();
+        count = owned.size();
+    }
+
+    void set(size_t index, const T& value) {
+        detach();
+        owned[index] = value;
+    }
+
+    void erase(size_t index) {
+        detach();
+        owned.erase(owned.begin() + index);
+        values = owned.data();
+        count = owned.size();
+    }
+
+    // Оставить строки с keep[i] != 0 в прежнем порядке - удаление пачки за один проход
+    void compact(const std::vector<uint8_t>& keep) {
+        detach();
+        size_t kept = 0;
+        for (size_t i = 0; i < owned.size(); ++i) {
+            if (keep[i]) {
+                owned[kept++] = owned[i];
+            }
+        }
+        owned.resize(kept);
+        values = owned.data();
+        count = kept;
+    }
+
+    void reserve(size_t capacity) {
+        detach();
+        owned.reserve(capacity);
+        values = owned.data();
+    }
+
+    void clear() {
+        owned.clear();
+        values = nullptr;
+        count = 0;
+        borrowed = false;
+    }
+
+    // Без копирования: буфер должен жить дольше колонки
+    void borrow(const T* data, size_t size) {
+        owned.clear();
+        owned.shrink_to_fit();
+        values = data;
+        count = size;
+        borrowed = true;
+    }
+
+    const T& operator[](size_t index) const { return values[index]; }
+    const T* data() const { return values; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool isBorrowed() const { return borrowed; }
+    size_t memoryUsage() const { return borrowed ? 0 : owned.capacity() * sizeof(T); }
+};
+
+// Ссылка на строку в StringArena
+struct StringRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+// Все имена и описания подряд в одном буфере, без заголовков std::string.
+// Если буфер заимствован (файл снимка), новые строки пишутся в хвост
+// с продолжением смещений - заимствованная часть не копируется.
+class StringArena {
+private:
+    Column<char> buffer;
+    std::vector<char> tail;
+
+public:
+    StringRef add(std::string_view text);
+    std::string_view get(StringRef ref) const;
+    void reserve(size_t bytes) { buffer.reserve(bytes); }
+    void clear() { buffer.clear(); tail.clear(); }
+    size_t size() const { return buffer.size() + tail.size(); }
+    // Для записи снимка: буфер, затем хвост
+    const Column<char>& getBuffer() const { return buffer; }
+    const std::vector<char>& getTail() const { return tail; }
+    void borrow(const char* data, size_t size) { buffer.borrow(data, size); tail.clear(); }
+    size_t memoryUsage() const { return buffer.memoryUsage() + tail.capacity(); }
+};
+
+// Словарь для колонок с несколькими различными значениями
+// (привилегия, тип платформы, название категории): строка -> код.
+class StringDictionary {
+private:
+    std::vector<std::string> values;
+    std::unordered_map<std::string, uint16_t> codes;
+
+public:
+    static constexpr uint16_t NO_CODE = 0xFFFF;
+
+    uint16_t intern(std::string_view value);
+    uint16_t find(std::string_view value) const;
+    std::string_view value(uint16_t code) const;
+    size_t size() const { return values.size(); }
+    void clear();
+    size_t memoryUsage() const;
+};
+
+#endif // COLUMN_STORE_HPP
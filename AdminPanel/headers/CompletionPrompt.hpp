@@ -0,0 +1,28 @@
+#ifndef COMPLETION_PROMPT_HPP
+#define COMPLETION_PROMPT_HPP
+
+#include <string>
+#include "NameTrie.hpp"
+#include "ScreenRenderer.hpp"
+#include "TerminalInput.hpp"
+
+// Ввод имени с дополнением: под строкой - самые популярные имена с этим префиксом,
+// Tab подставляет выбранное. Отмечает, если такое имя уже есть.
+class CompletionPrompt {
+private:
+    const NameTrie& trie;
+    std::string title;
+    std::string label;
+    std::string existsNote;     // текст, когда введенное имя уже занято
+    std::string message;        // ошибка проверки; стирается следующим нажатием
+
+public:
+    CompletionPrompt(const NameTrie& trie, const std::string& title, const std::string& label,
+                     const std::string& existsNote);
+
+    void setMessage(const std::string& text) { message = text; }
+    // text - начальное значение и результат; false - нажат ESC
+    bool read(ScreenRenderer& screen, TerminalInput& input, std::string& text);
+};
+
+#endif // COMPLETION_PROMPT_HPP
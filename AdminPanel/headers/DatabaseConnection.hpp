@@ -2,34 +2,169 @@
 #define DATABASE_CONNECTION_HPP
 
 #include <mysql.h>
+#include <cstdint>
 #include <string>
 #include <vector>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #include <stdexcept>
+#include "CircuitBreaker.hpp"
+
+// Таймауты, повторы и circuit breaker (секция database в config.json)
+struct ConnectionOptions {
+    unsigned int connectTimeoutSec = 5;
+    unsigned int readTimeoutSec = 30;
+    unsigned int writeTimeoutSec = 30;
+    unsigned int queryTimeoutSec = 0;   // > 0: KILL QUERY для зависших запросов
+    int maxRetries = 3;                 // только для чтения (идемпотентно)
+    int backoffBaseMs = 100;
+    int backoffMaxMs = 2000;
+    int breakerThreshold = 5;
+    int breakerCooldownMs = 5000;
+};
+
+// Реплика только для чтения (get* методы менеджеров)
+struct ReplicaEndpoint {
+    std::string host;
+    unsigned int port;
+    MYSQL* connection;
+    bool isConnected;
+    std::chrono::steady_clock::time_point retryAt;
+    uint64_t appliedWrite = 0;      // writeSequence, GTID которой реплика уже применила
+};
 
 class DatabaseConnection {
+public:
+    // Как гарантируем, что админ видит свои изменения после записи
+    enum class ReadConsistency {
+        PIN_AFTER_WRITE,   // читать с primary в течение окна после записи
+        GTID_WAIT          // ждать на реплике GTID последней записи
+    };
+
 private:
     MYSQL* connection;
     std::string host;
     std::string user;
     std::string password;
     std::string database;
+    unsigned int port;
     bool isConnected;
+    unsigned long long lastInsertId = 0;    // запоминается до служебных запросов после записи
+    ConnectionOptions options;
+    CircuitBreaker breaker;
+
+    // Read replicas
+    std::vector<ReplicaEndpoint> replicas;
+    size_t nextReplica = 0;
+    ReadConsistency consistency = ReadConsistency::PIN_AFTER_WRITE;
+    std::chrono::milliseconds readYourWritesWindow{2000};
+    std::chrono::steady_clock::time_point lastWriteTime{};
+    bool hasWritten = false;
+    bool gtidTracking = false;          // session_track_gtids = OWN_GTID включен на primary
+    std::string lastWriteGtid;          // пусто после записи - GTID неизвестен; сбрасывается после окна
+    uint64_t writeSequence = 0;         // номер записи, к которой относится lastWriteGtid
+    int primaryReads = 0;               // открытых PrimaryReads: getReadResult идет на primary
+
+    // Запрос, который сейчас выполняется (для KILL QUERY из watchdog)
+    struct InFlightQuery {
+        bool active = false;
+        bool cancelled = false;
+        std::string host;
+        unsigned int port = 0;
+        unsigned long threadId = 0;
+        std::chrono::steady_clock::time_point startedAt{};
+    };
+    std::mutex inFlightMutex;
+    InFlightQuery inFlight;
+
+    std::thread watchdog;
+    std::mutex watchdogMutex;
+    std::condition_variable watchdogWake;
+    bool stopWatchdog = false;
+
+    // Флаги у каждого соединения свои: у OutboxRelay отдельное соединение в своем потоке
+    std::atomic<bool> queryRunning{false};
+    std::atomic<bool> interruptRequested{false};
+    // Соединение, запрос которого отменяет Ctrl+C (соединение TUI)
+    static std::atomic<DatabaseConnection*> interruptTarget;
+    static void (*volatile interruptExitHook)();
+
+    MYSQL* openConnection(const std::string& h, unsigned int p);
+    MYSQL_RES* runSelect(MYSQL* conn, const std::string& h, unsigned int p,
+                         const std::string& query);
+    int runQuery(MYSQL* conn, const std::string& h, unsigned int p, const std::string& query);
+    void beginInFlight(MYSQL* conn, const std::string& h, unsigned int p);
+    void endInFlight();
+    void watchdogLoop();
+    bool killQuery(const std::string& h, unsigned int p, unsigned long threadId);
+    void markPrimaryLost();
+    void backoff(int attempt);
+    static bool isConnectionError(unsigned int errorCode);
+
+    bool isWithinWriteWindow() const;
+    bool isPinnedToPrimary() const;
+    bool waitForGtid(ReplicaEndpoint& replica);
+    void enableGtidTracking();
+    std::string trackedGtid();
+    void rememberWrite();
 
 public:
-    DatabaseConnection(const std::string& h, const std::string& u, 
-                      const std::string& p, const std::string& d);
+    // Пока объект жив, все чтения соединения идут на primary. Для срезов, которые
+    // сверяются со временем сервера (загрузка каталога, SyncEngine::pull): реплика
+    // с отставанием больше перекрытия отметок потеряла бы строки навсегда
+    class PrimaryReads {
+    private:
+        DatabaseConnection& db;
+    public:
+        explicit PrimaryReads(DatabaseConnection& connection) : db(connection) { ++db.primaryReads; }
+        ~PrimaryReads() { --db.primaryReads; }
+        PrimaryReads(const PrimaryReads&) = delete;
+        PrimaryReads& operator=(const PrimaryReads&) = delete;
+    };
+
+    DatabaseConnection(const std::string& h, const std::string& u,
+                      const std::string& p, const std::string& d,
+                      unsigned int port = 3306,
+                      const ConnectionOptions& opts = ConnectionOptions());
     ~DatabaseConnection();
 
+    DatabaseConnection(const DatabaseConnection&) = delete;
+    DatabaseConnection& operator=(const DatabaseConnection&) = delete;
+
     bool connect();
     void disconnect();
     bool isActive() const;
     MYSQL* getConnection();
-    
+
+    // Replica routing
+    bool addReplica(const std::string& host, unsigned int port = 3306);
+    void setReadConsistency(ReadConsistency mode);
+    void setReadYourWritesWindow(int milliseconds);
+    size_t getReplicaCount() const;
+
+    // Cancellation: из другого потока или по Ctrl+C во время запроса
+    bool cancelCurrentQuery();
+    // Ctrl+C отменяет запрос этого соединения (SIGINT перехватывается здесь).
+    // Без активного запроса вызывается onExit (должна быть безопасна в обработчике сигнала)
+    // и процесс завершается
+    void cancelOnInterrupt(void (*onExit)() = nullptr);
+    static void handleInterrupt(int signal);
+    CircuitBreaker::State getBreakerState() const;
+
     // Query execution methods
-    bool executeQuery(const std::string& query);
-    MYSQL_RES* getQueryResult(const std::string& query);
+    bool executeQuery(const std::string& query);                 // всегда primary, без повторов
+    unsigned long long getLastInsertId() const;                  // AUTO_INCREMENT последнего INSERT
+    // Все запросы в одной транзакции; при ошибке ROLLBACK. insertIds - AUTO_INCREMENT каждого запроса
+    bool executeTransaction(const std::vector<std::string>& statements,
+                            std::vector<unsigned long long>* insertIds = nullptr);
+    MYSQL_RES* getQueryResult(const std::string& query);         // primary, с повторами
+    MYSQL_RES* getReadResult(const std::string& query);          // реплика, если можно
     void freeResult(MYSQL_RES* result);
+    std::string escapeString(const std::string& value);          // для строк внутри '...'
     std::string getLastError() const;
 };
 
-#endif // DATABASE_CONNECTION_HPP
\ No newline at end of file
+#endif // DATABASE_CONNECTION_HPP
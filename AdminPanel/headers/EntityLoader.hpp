@@ -0,0 +1,60 @@
+#ifndef ENTITY_LOADER_HPP
+#define ENTITY_LOADER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "User.hpp"
+#include "Game.hpp"
+#include "Platform.hpp"
+#include "Review.hpp"
+
+// Отзыв с уже подставленными именами
+struct ReviewView {
+    ReviewData review;
+    std::string username;
+    std::string gameName;
+    std::string platformName;
+};
+
+// Собирает ID за проход (отрисовка страницы, экспорт), загружает их одним
+// WHERE id IN (...) на тип сущности и запоминает до reset().
+class EntityLoader {
+private:
+    std::shared_ptr<User> userMgr;
+    std::shared_ptr<Game> gameMgr;
+    std::shared_ptr<Platform> platformMgr;
+
+    std::unordered_set<int> pendingUsers;
+    std::unordered_set<int> pendingGames;
+    std::unordered_set<int> pendingPlatforms;
+
+    std::unordered_map<int, UserData> users;
+    std::unordered_map<int, GameData> games;
+    std::unordered_map<int, PlatformData> platforms;
+
+public:
+    EntityLoader(std::shared_ptr<User> user, std::shared_ptr<Game> game,
+                 std::shared_ptr<Platform> platform);
+
+    void requestUser(int userId);
+    void requestGame(int gameId);
+    void requestPlatform(int platformId);
+    void load();
+    void reset();
+
+    const UserData* findUser(int userId) const;
+    const GameData* findGame(int gameId) const;
+    const PlatformData* findPlatform(int platformId) const;
+
+    std::string userName(int userId) const;
+    std::string gameName(int gameId) const;
+    std::string platformName(int platformId) const;
+
+    // Запросить все ID из отзывов, загрузить и собрать ReviewView
+    std::vector<ReviewView> joinReviews(const std::vector<ReviewData>& reviews);
+};
+
+#endif // ENTITY_LOADER_HPP
@@ -0,0 +1,24 @@
+#ifndef ENTITY_PICKER_HPP
+#define ENTITY_PICKER_HPP
+
+#include <string>
+#include "FuzzyIndex.hpp"
+#include "ScreenRenderer.hpp"
+#include "TerminalInput.hpp"
+
+// Выбор сущности по имени: список сужается на каждое нажатие
+class EntityPicker {
+private:
+    const FuzzyIndex& index;
+    std::string title;
+
+    static void eraseLastChar(std::string& text);
+
+public:
+    EntityPicker(const FuzzyIndex& index, const std::string& title);
+
+    // id выбранной записи или -1, если нажат ESC
+    int pick(ScreenRenderer& screen, TerminalInput& input);
+};
+
+#endif // ENTITY_PICKER_HPP
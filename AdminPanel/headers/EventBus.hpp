@@ -0,0 +1,240 @@
+#ifndef EVENT_BUS_HPP
+#define EVENT_BUS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+enum class ChangeType { INSERTED, UPDATED, DELETED };
+
+const char* changeTypeName(ChangeType type);
+
+// Изменение одной строки. before/after - значения из БД до и после записи:
+// у INSERTED нет before, у DELETED нет after.
+template <typename Entity>
+struct ChangeEvent {
+    ChangeType type;
+    int id;                         // первое ключевое поле
+    int id2;                        // второе поле составного ключа (game_s_platfo), иначе 0
+    std::optional<Entity> before;
+    std::optional<Entity> after;
+    uint64_t sequence;              // общий порядок публикации по всем типам
+
+    uint64_t key() const {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(id)) << 32) | static_cast<uint32_t>(id2);
+    }
+};
+
+// Поток изменений внутри процесса. Публикует Repository после успешной записи;
+// обработчики вызываются синхронно в потоке писателя, в порядке подписки.
+// Для тяжелой обработки - BatchingSubscriber (пачки в фоновом потоке).
+class EventBus {
+private:
+    struct ChannelBase {
+        virtual ~ChannelBase() = default;
+        virtual bool remove(int subscription) = 0;
+        virtual bool empty() const = 0;
+    };
+
+    template <typename Entity>
+    struct Channel : ChannelBase {
+        std::vector<std::pair<int, std::function<void(const ChangeEvent<Entity>&)>>> handlers;
+
+        bool remove(int subscription) override {
+            for (auto it = handlers.begin(); it != handlers.end(); ++it) {
+                if (it->first == subscription) {
+                    handlers.erase(it);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool empty() const override { return handlers.empty(); }
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::type_index, std::unique_ptr<ChannelBase>> channels;
+    int nextSubscription = 1;
+    std::atomic<uint64_t> sequence{0};
+
+public:
+    template <typename Entity>
+    int subscribe(std::function<void(const ChangeEvent<Entity>&)> handler) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unique_ptr<ChannelBase>& slot = channels[std::type_index(typeid(Entity))];
+        if (!slot) {
+            slot = std::make_unique<Channel<Entity>>();
+        }
+        int subscription = nextSubscription++;
+        static_cast<Channel<Entity>&>(*slot).handlers.emplace_back(subscription, std::move(handler));
+        return subscription;
+    }
+
+    void unsubscribe(int subscription);
+
+    // Без подписчиков Repository не читает before/after и ничего не публикует
+    template <typename Entity>
+    bool hasSubscribers() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = channels.find(std::type_index(typeid(Entity)));
+        return it != channels.end() && !it->second->empty();
+    }
+
+    template <typename Entity>
+    void publish(ChangeEvent<Entity> event) {
+        // Копия списка: обработчик может подписываться и отписываться
+        std::vector<std::pair<int, std::function<void(const ChangeEvent<Entity>&)>>> handlers;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = channels.find(std::type_index(typeid(Entity)));
+            if (it == channels.end()) {
+                return;
+            }
+            handlers = static_cast<Channel<Entity>&>(*it->second).handlers;
+            event.sequence = ++sequence;
+        }
+        for (const auto& handler : handlers) {
+            try {
+                handler.second(event);
+            } catch (const std::exception& e) {
+                std::cerr << "ERROR in EventBus handler: " << e.what() << "\n";
+            }
+        }
+    }
+};
+
+// Подписчик, который копит события и отдает их пачкой в своем потоке:
+// через delay после первого события или сразу при maxBatch событиях.
+// События одной строки схлопываются: INSERTED+UPDATED -> INSERTED,
+// UPDATED+DELETED -> DELETED, INSERTED+DELETED - ничего, и т.д.;
+// before берется из первого события, after - из последнего.
+template <typename Entity>
+class BatchingSubscriber {
+public:
+    using BatchHandler = std::function<void(std::vector<ChangeEvent<Entity>>&)>;
+
+private:
+    struct Pending {
+        ChangeEvent<Entity> event;
+        bool dropped;
+    };
+
+    std::shared_ptr<EventBus> bus;
+    BatchHandler handler;
+    std::chrono::milliseconds delay;
+    size_t maxBatch;
+    int subscription = 0;
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::vector<Pending> pending;
+    std::unordered_map<uint64_t, size_t> pendingByKey;
+    bool stopping = false;
+    std::thread worker;
+
+    static void coalesce(Pending& into, const ChangeEvent<Entity>& next) {
+        ChangeEvent<Entity>& first = into.event;
+        if (into.dropped) {
+            first = next;
+            into.dropped = false;
+            return;
+        }
+        if (first.type == ChangeType::INSERTED) {
+            into.dropped = next.type == ChangeType::DELETED;
+        } else if (first.type == ChangeType::DELETED) {
+            first.type = next.type == ChangeType::INSERTED ? ChangeType::UPDATED : next.type;
+        } else {
+            first.type = next.type;
+        }
+        first.after = next.after;
+        first.sequence = next.sequence;
+    }
+
+    void enqueue(const ChangeEvent<Entity>& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = pendingByKey.find(event.key());
+        if (it != pendingByKey.end()) {
+            coalesce(pending[it->second], event);
+        } else {
+            pendingByKey.emplace(event.key(), pending.size());
+            pending.push_back({event, false});
+        }
+        if (pending.size() == 1 || pending.size() >= maxBatch) {
+            wakeup.notify_one();
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wakeup.wait(lock, [this]() { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                break;
+            }
+            // Даем пачке набраться
+            wakeup.wait_for(lock, delay, [this]() { return stopping || pending.size() >= maxBatch; });
+
+            std::vector<ChangeEvent<Entity>> batch;
+            batch.reserve(pending.size());
+            for (Pending& item : pending) {
+                if (!item.dropped) {
+                    batch.push_back(std::move(item.event));
+                }
+            }
+            pending.clear();
+            pendingByKey.clear();
+
+            lock.unlock();
+            if (!batch.empty()) {
+                try {
+                    handler(batch);
+                } catch (const std::exception& e) {
+                    std::cerr << "ERROR in BatchingSubscriber: " << e.what() << "\n";
+                }
+            }
+            lock.lock();
+        }
+    }
+
+public:
+    BatchingSubscriber(std::shared_ptr<EventBus> eventBus, BatchHandler batchHandler,
+                       std::chrono::milliseconds batchDelay = std::chrono::milliseconds(100),
+                       size_t batchSize = 256)
+        : bus(std::move(eventBus)), handler(std::move(batchHandler)), delay(batchDelay),
+          maxBatch(batchSize > 0 ? batchSize : 1) {
+        if (!bus || !handler) {
+            throw std::runtime_error("ERROR: Null pointers passed to BatchingSubscriber constructor!");
+        }
+        worker = std::thread(&BatchingSubscriber::run, this);
+        subscription = bus->subscribe<Entity>([this](const ChangeEvent<Entity>& event) { enqueue(event); });
+    }
+
+    // Отписка, затем последняя пачка обрабатывается до выхода.
+    // Разрушать, когда другие потоки уже ничего не публикуют
+    ~BatchingSubscriber() {
+        bus->unsubscribe(subscription);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_one();
+        worker.join();
+    }
+
+    BatchingSubscriber(const BatchingSubscriber&) = delete;
+    BatchingSubscriber& operator=(const BatchingSubscriber&) = delete;
+};
+
+#endif // EVENT_BUS_HPP
@@ -0,0 +1,102 @@
+#ifndef EVENT_LOG_HPP
+#define EVENT_LOG_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Одна запись журнала: событие из outbox_event
+struct LogRecord {
+    uint64_t offset = 0;        // номер записи в журнале, с 0 подряд
+    uint64_t eventId = 0;       // outbox_event.idEvent
+    std::string table;
+    std::string changeType;     // INSERT / UPDATE / DELETE
+    int rowId = 0;
+    int rowId2 = 0;
+    std::string createdDate;
+    std::string payload;        // JSON строки (после записи, для DELETE - до)
+};
+
+// Журнал только на дозапись: каталог с сегментами <базовое смещение, 20 цифр>.log.
+// Запись: RecordHeader, затем тело (eventId, rowId, rowId2, длины строк и сами строки).
+// Каждая запись со своим CRC32; при открытии недописанный хвост последнего
+// сегмента обрезается. Один писатель на каталог (OutboxRelay).
+class EventLog {
+public:
+    struct RecordHeader {
+        uint32_t length;        // длина тела
+        uint32_t crc;           // CRC32 тела
+        uint64_t offset;
+    };
+
+    static const uint64_t DEFAULT_SEGMENT_BYTES = 64ull * 1024 * 1024;
+
+private:
+    std::string directory;
+    uint64_t segmentBytes;
+    std::FILE* segment = nullptr;
+    uint64_t segmentSize = 0;
+    uint64_t nextOffset = 0;
+    std::unordered_set<uint64_t> tailEventIds;
+
+    bool openSegment(uint64_t baseOffset);
+    bool recover();
+
+public:
+    explicit EventLog(const std::string& dir, uint64_t maxSegmentBytes = DEFAULT_SEGMENT_BYTES);
+    ~EventLog();
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    bool isOpen() const { return segment != nullptr; }
+    uint64_t getNextOffset() const { return nextOffset; }
+    // eventId последнего сегмента на момент открытия: пачка, записанная перед
+    // сбоем, могла остаться в outbox_event - повторно ее не пишем
+    bool containsRecent(uint64_t eventId) const { return tailEventIds.count(eventId) > 0; }
+
+    // Пачка целиком в одном сегменте; offset записей назначается здесь.
+    // После append данные сброшены на диск (fsync)
+    bool append(std::vector<LogRecord>& records);
+
+    static std::vector<uint64_t> listSegments(const std::string& dir);
+    static std::string segmentPath(const std::string& dir, uint64_t baseOffset);
+    static uint32_t crc32(const char* data, size_t length);
+    static void encode(const LogRecord& record, std::string& out);
+    // false - запись повреждена или дописана не до конца
+    static bool decode(const RecordHeader& header, const std::string& body, LogRecord& record);
+};
+
+// Последовательное чтение журнала для одного потребителя.
+// Смещение сохраняется в <dir>/consumers/<name>.offset только по commit():
+// после перезапуска чтение продолжается с первой неподтвержденной записи.
+class EventLogReader {
+private:
+    std::string directory;
+    std::string consumer;
+    std::ifstream segment;
+    uint64_t segmentBase = 0;
+    uint64_t position = 0;          // следующая запись
+    uint64_t committed = 0;
+    bool positioned = false;
+
+    bool openSegmentFor(uint64_t offset);
+    std::string offsetPath() const;
+
+public:
+    EventLogReader(const std::string& dir, const std::string& consumerName);
+
+    uint64_t getPosition() const { return position; }
+    uint64_t getCommitted() const { return committed; }
+
+    // false - новых записей пока нет (писатель может дописать позже)
+    bool next(LogRecord& record);
+    // Перейти к записи offset (повторное чтение или пропуск)
+    bool seek(uint64_t offset);
+    // Сохранить позицию: все прочитанные записи обработаны
+    bool commit();
+};
+
+#endif // EVENT_LOG_HPP
@@ -0,0 +1,43 @@
+#ifndef FUZZY_INDEX_HPP
+#define FUZZY_INDEX_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+struct FuzzyMatch {
+    int id;
+    const std::string* name;
+    double score;
+};
+
+// Индекс имен в памяти: префиксы по отсортированному списку, опечатки и
+// подстроки - по триграммам. Строится один раз, поиск - на каждое нажатие.
+class FuzzyIndex {
+private:
+    struct Entry {
+        int id;
+        std::string name;
+        std::string folded;   // в нижнем регистре (ASCII и кириллица)
+    };
+
+    std::vector<Entry> entries;
+    std::vector<int> byName;                                  // индексы entries по folded
+    std::unordered_map<uint32_t, std::vector<int>> trigrams;  // триграмма -> индексы entries
+    std::unordered_map<int, int> idToEntry;
+
+    static std::vector<uint32_t> extractTrigrams(const std::string& padded);
+
+public:
+    void add(int id, const std::string& name);
+    void build();
+    void clear();
+    size_t size() const;
+
+    std::vector<FuzzyMatch> search(const std::string& query, size_t limit) const;
+
+    static std::string foldCase(const std::string& text);
+};
+
+#endif // FUZZY_INDEX_HPP
@@ -4,7 +4,7 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include "DatabaseConnection.hpp"
+#include "Repository.hpp"
 
 struct CategoryData {
     int idCategory;
@@ -23,12 +23,40 @@ struct GameData {
     bool isActive;
 };
 
+template <>
+struct EntitySchema<CategoryData> {
+    static constexpr const char* table = "category";
+    static constexpr auto fields = std::make_tuple(
+        field("idCategory", &CategoryData::idCategory, FIELD_KEY | FIELD_GENERATED),
+        field("CategoryName", &CategoryData::categoryName),
+        field("Description", &CategoryData::description));
+};
+
+template <>
+struct EntitySchema<GameData> {
+    static constexpr const char* table = "game";
+    static constexpr auto fields = std::make_tuple(
+        field("idGame", &GameData::idGame, FIELD_KEY | FIELD_GENERATED),
+        field("Name", &GameData::name),
+        field("Release_year", &GameData::releaseYear),
+        field("Description", &GameData::description),
+        field("Production_cost", &GameData::productionCost),
+        field("idCategory", &GameData::idCategory),
+        field("ImageURL", &GameData::imageURL, FIELD_NULL_IF_EMPTY),
+        field("IsActive", &GameData::isActive, FIELD_GENERATED));
+};
+
 class Game {
 private:
-    std::shared_ptr<DatabaseConnection> db;
+    Repository<GameData> games;
+    Repository<CategoryData> categories;
 
 public:
     explicit Game(std::shared_ptr<DatabaseConnection> database);
+    // Все записи менеджера публикуются в bus
+    void setEventBus(std::shared_ptr<EventBus> bus);
+    // Записи идут в транзакции вместе с событием в outbox_event
+    void setOutbox(bool enabled);
     
     // Game CRUD operations
     bool addGame(const std::string& name, int releaseYear, const std::string& description,
@@ -46,7 +74,20 @@ public:
     // Read operations
     std::vector<GameData> getAllGames();
     GameData getGameById(int gameId);
+    std::vector<GameData> getGamesByIds(const std::vector<int>& ids);
     std::vector<GameData> getGamesByCategory(int categoryId);
+    std::vector<GameData> getGamesPage(int offset, int limit, const std::string& orderBy,
+                                       bool ascending);
+    // Без копирования строк: колонки в порядке EntitySchema<GameData>
+    ResultSet scanAllGames();
+    ResultSet scanAllCategories();
+    // Созданные или измененные начиная с since (время сервера)
+    ResultSet scanGamesChangedSince(const std::string& since);
+    ResultSet scanCategoriesChangedSince(const std::string& since);
+    std::string getServerTime();
+    ResultSet scanGamesPage(int offset, int limit, const std::string& orderBy, bool ascending);
+    // Все колонки game, как g.* в server/routes/games.js
+    ResultSet scanGameListing();
     std::vector<CategoryData> getAllCategories();
     CategoryData getCategoryById(int categoryId);
     int getGameCount();
@@ -0,0 +1,86 @@
+#ifndef GAME_API_HPP
+#define GAME_API_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GameFacets.hpp"
+#include "HttpServer.hpp"
+#include "TrendingGames.hpp"
+
+class Game;
+class Review;
+class Platform;
+class User;
+
+// Неизменяемый снимок для публичного API: JSON каждой игры собран заранее,
+// запрос только фильтрует и склеивает готовые куски
+struct ApiSnapshot {
+    struct GameEntry {
+        int idGame = 0;
+        int idCategory = 0;
+        bool hasYear = false;
+        int releaseYear = 0;
+        int reviewCount = 0;
+        int64_t avgMark = 0;            // AVG(Mark) * 10000, округление как в MySQL
+        std::string nameFolded;         // для поиска и сортировки по имени
+        std::string listJson;           // объект для GET /api/games
+    };
+
+    std::vector<GameEntry> games;                           // только IsActive = 1
+    std::unordered_map<int, size_t> gameIndex;              // idGame -> games
+    std::unordered_map<int, std::string> detailJson;        // GET /api/games/:id
+    std::unordered_map<int, std::string> reviewsJson;       // GET /api/reviews/game/:gameId
+    GameFacets facets;                                      // фильтры списка по ID игр
+
+    // Порядки sortBy: индексы в games
+    std::vector<uint32_t> byRating;
+    std::vector<uint32_t> byNewest;
+    std::vector<uint32_t> byName;
+    std::vector<uint32_t> byReviews;
+    std::string defaultList;                                // без фильтров, sortBy=rating
+
+    // GET /api/games/trending: объекты списка с trendingScore, по убыванию
+    std::vector<std::string> trending;
+    std::unordered_map<int, std::vector<std::string>> trendingByCategory;
+    std::unordered_map<int, std::vector<std::string>> trendingByPlatform;
+};
+
+// Обработчик HTTP для GET /api/games, /api/games/:id, /api/reviews/game/:gameId.
+// JSON совпадает с server/routes (mysql2: DECIMAL - строка, DATETIME - ISO в UTC).
+// Снимок заменяется целиком; запросы во время reload дочитывают старый.
+class GameApi {
+private:
+    std::shared_ptr<const ApiSnapshot> snapshot;    // std::atomic_load / atomic_store
+    std::vector<std::string> allowedOrigins;
+    // Живет между reload: каждый раз добавляются только отзывы с idReview > lastTrendingReview.
+    // Удаленные и измененные отзывы из счетчиков не вычитаются - они и так затухают
+    TrendingGames trending;
+    int lastTrendingReview = 0;
+
+    bool parseFilter(const ApiSnapshot& data, const HttpRequest& request, GameFacets::Filter& filter,
+                     RoaringBitmap& names) const;
+    void listGames(const ApiSnapshot& data, const HttpRequest& request, HttpResponse& response) const;
+    // GET /api/games/facets: число игр по каждому значению фильтра
+    void countFacets(const ApiSnapshot& data, const HttpRequest& request, HttpResponse& response) const;
+    // GET /api/games/trending?category=|platform=&limit=
+    void listTrending(const ApiSnapshot& data, const HttpRequest& request, HttpResponse& response) const;
+    void applyCors(const HttpRequest& request, HttpResponse& response) const;
+
+public:
+    explicit GameApi(std::vector<std::string> origins = {});
+
+    // Период полураспада веса отзыва и число кандидатов в top (config.json: api_server.trending)
+    void setTrending(double halfLifeSeconds, size_t candidates);
+
+    // Полная загрузка из БД; при ошибке остается прежний снимок
+    bool reload(Game& gameMgr, Review& reviewMgr, Platform& platformMgr, User& userMgr);
+    size_t getGameCount() const;
+
+    // HttpHandler; вызывается из потоков сервера
+    void handle(const HttpRequest& request, HttpResponse& response) const;
+};
+
+#endif // GAME_API_HPP
@@ -0,0 +1,77 @@
+#ifndef GAME_FACETS_HPP
+#define GAME_FACETS_HPP
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "RoaringBitmap.hpp"
+
+// Вторичные индексы по ID игр для фильтров списка: множество игр на каждое
+// значение (категория, платформа, год, целая часть оценки). Фильтр - AND
+// измерений, внутри измерения - OR перечисленных значений.
+class GameFacets {
+public:
+    static const int RATING_BUCKETS = 11;       // floor(AvgMark): 0..10
+
+    struct Filter {
+        std::vector<int> categories;
+        std::vector<int> reviewedOn;            // платформы активных отзывов (как в routes/games.js)
+        std::vector<int> availableOn;           // платформы из game_s_platfo
+        std::vector<int> years;
+        double minRating = -1;                  // <= 0 - без ограничения
+        const RoaringBitmap* only = nullptr;    // заранее отобранные ID (текстовый поиск)
+
+        bool isEmpty() const {
+            return categories.empty() && reviewedOn.empty() && availableOn.empty() && years.empty() &&
+                   minRating <= 0 && !only;
+        }
+    };
+
+    // Значение -> число игр. Для каждого измерения собственный фильтр не учитывается,
+    // остальные - учитываются: видно, сколько игр даст выбор другого значения
+    struct Counts {
+        uint64_t total = 0;
+        std::vector<std::pair<int, uint64_t>> categories;
+        std::vector<std::pair<int, uint64_t>> reviewedOn;
+        std::vector<std::pair<int, uint64_t>> availableOn;
+        std::vector<std::pair<int, uint64_t>> years;
+        std::vector<std::pair<int, uint64_t>> ratings;
+    };
+
+private:
+    RoaringBitmap all;
+    std::map<int, RoaringBitmap> byCategory;
+    std::map<int, RoaringBitmap> byReviewPlatform;
+    std::map<int, RoaringBitmap> byAvailablePlatform;
+    std::map<int, RoaringBitmap> byYear;
+    RoaringBitmap byRating[RATING_BUCKETS];
+    std::unordered_map<uint32_t, int64_t> avgMarks;     // для неполной корзины minRating
+
+    enum Dimension { CATEGORY, REVIEWED_ON, AVAILABLE_ON, YEAR, RATING, ONLY, DIMENSIONS };
+
+    static RoaringBitmap anyOf(const std::map<int, RoaringBitmap>& index, const std::vector<int>& values);
+    RoaringBitmap ratingAtLeast(double minRating) const;
+    // Множество каждого заданного измерения; false - измерение не задано
+    void resolve(const Filter& filter, RoaringBitmap (&sets)[DIMENSIONS], bool (&active)[DIMENSIONS]) const;
+    RoaringBitmap combine(const RoaringBitmap (&sets)[DIMENSIONS], const bool (&active)[DIMENSIONS],
+                          int skip) const;
+
+public:
+    // avgMark - AVG(Mark) * 10000; год не задан - hasYear = false
+    void addGame(int gameId, int categoryId, bool hasYear, int releaseYear, int64_t avgMark);
+    void addReviewPlatform(int gameId, int platformId);
+    void addAvailablePlatform(int gameId, int platformId);
+    void clear();
+
+    RoaringBitmap select(const Filter& filter) const;
+    Counts count(const Filter& filter) const;
+
+    const RoaringBitmap& allGames() const { return all; }
+    // Пустое множество, если категории нет
+    const RoaringBitmap& category(int categoryId) const;
+    size_t memoryUsage() const;
+};
+
+#endif // GAME_FACETS_HPP
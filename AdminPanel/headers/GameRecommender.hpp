@@ -0,0 +1,61 @@
+#ifndef GAME_RECOMMENDER_HPP
+#define GAME_RECOMMENDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ResultSet.hpp"
+
+struct Recommendation {
+    int gameId;
+    float score;        // сходство (similarGames) или прогноз оценки (recommendForUser)
+};
+
+// Item-item рекомендации по матрице оценок пользователь x игра из review.
+// Сходство - adjusted cosine (оценки центрируются средним пользователя),
+// для каждой игры хранятся только K самых похожих (CSR: offsets / neighbors / similarities).
+class GameRecommender {
+public:
+    static constexpr uint32_t DEFAULT_NEIGHBORS = 50;
+    static constexpr uint32_t MIN_COMMON_USERS = 2;     // меньше общих оценщиков - сходство не считается
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t gameCount;
+        uint64_t neighborCount;
+        uint64_t checksum;      // FNV-1a 64 по всему, что после заголовка
+    };
+
+private:
+    std::vector<int32_t> gameIds;           // по возрастанию; позиция - номер игры
+    std::vector<uint32_t> offsets;          // соседи игры g: [offsets[g], offsets[g + 1])
+    std::vector<uint32_t> neighbors;        // номера игр, по убыванию сходства
+    std::vector<float> similarities;
+
+    uint32_t gameIndex(int gameId) const;
+
+public:
+    // Строки (idUser, idGame, Mark); несколько отзывов одного пользователя на игру усредняются.
+    // threads = 0 - все ядра. false - оценок нет, прежние списки остаются
+    bool build(ResultSet markRows, uint32_t neighborsPerGame = DEFAULT_NEIGHBORS, unsigned threads = 0);
+
+    // Запись во временный файл и атомарная подмена (rename)
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    std::vector<Recommendation> similarGames(int gameId, size_t limit) const;
+    // userMarks - (idGame, Mark) пользователя; оцененные игры в ответ не попадают
+    std::vector<Recommendation> recommendForUser(const std::vector<std::pair<int, int>>& userMarks,
+                                                 size_t limit) const;
+
+    bool empty() const { return gameIds.empty(); }
+    size_t getGameCount() const { return gameIds.size(); }
+    size_t getNeighborCount() const { return neighbors.size(); }
+    size_t memoryUsage() const;
+};
+
+#endif // GAME_RECOMMENDER_HPP
@@ -0,0 +1,54 @@
+#ifndef GAME_SUMMARY_HPP
+#define GAME_SUMMARY_HPP
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "DatabaseConnection.hpp"
+#include "EventBus.hpp"
+#include "Game.hpp"
+#include "Review.hpp"
+
+// Денормализованная таблица game_summary (server/migrations/add_game_summary.sql):
+// игра + название категории, средняя оценка, число отзывов и платформы отзывов -
+// то же, что считает GET /api/games, но одной строкой на игру.
+// Обновляется по событиям менеджеров: пересчитываются только затронутые игры.
+// Игры и отзывы - пачками в фоновом потоке (BatchingSubscriber): серия записей
+// об одной строке дает один пересчет, меню не ждет REPLACE ... SELECT.
+// Соединение свое: им пользуются и фоновые пачки, и поток меню (под dbMutex).
+class GameSummary {
+private:
+    std::shared_ptr<DatabaseConnection> db;
+    std::mutex dbMutex;
+    std::shared_ptr<EventBus> events;
+    std::vector<int> subscriptions;
+    std::unique_ptr<BatchingSubscriber<GameData>> gameBatches;
+    std::unique_ptr<BatchingSubscriber<ReviewData>> reviewBatches;
+
+    bool execute(const std::string& query);
+    bool refreshWhere(const std::string& condition);
+    std::vector<int> selectIds(const std::string& query);
+    void subscribe();
+
+public:
+    static const int DEFAULT_CHUNK = 500;
+
+    explicit GameSummary(std::shared_ptr<DatabaseConnection> connection);
+    ~GameSummary();
+
+    GameSummary(const GameSummary&) = delete;
+    GameSummary& operator=(const GameSummary&) = delete;
+
+    void setEventBus(std::shared_ptr<EventBus> bus);
+
+    // Пересчитать строки игр
+    bool refreshGames(const std::vector<int>& gameIds);
+    // Полная перестройка диапазонами idGame по chunkSize, каждый диапазон - отдельный запрос.
+    // progress(готово, всего) - после каждого диапазона
+    bool rebuild(int chunkSize = DEFAULT_CHUNK,
+                 const std::function<void(int, int)>& progress = nullptr);
+};
+
+#endif // GAME_SUMMARY_HPP
@@ -0,0 +1,79 @@
+#ifndef HTTP_SERVER_HPP
+#define HTTP_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Разобранный запрос; string_view указывают в буфер соединения и живут до конца обработчика
+struct HttpRequest {
+    std::string_view method;
+    std::string_view path;          // без query string, не декодирован
+    std::string_view query;         // после '?', без него
+    std::vector<std::pair<std::string_view, std::string_view>> headers;
+    bool keepAlive = true;
+
+    // Имя без учета регистра; пусто, если заголовка нет
+    std::string_view header(std::string_view name) const;
+    // Декодированное значение (%XX, '+'); пусто, если параметра нет
+    std::string queryParam(std::string_view name) const;
+};
+
+struct HttpResponse {
+    int status = 200;
+    std::string contentType = "application/json; charset=utf-8";
+    std::string body;
+    std::vector<std::pair<std::string, std::string>> headers;
+};
+
+using HttpHandler = std::function<void(const HttpRequest&, HttpResponse&)>;
+
+// HTTP/1.1 сервер: keep-alive, конвейерные запросы, тело запроса пропускается.
+// Каждый поток - свой epoll и свой слушающий сокет (SO_REUSEPORT): ядро раскидывает
+// соединения по потокам, соединение живет в одном потоке, блокировок нет.
+// Только Linux. Обработчик вызывается из нескольких потоков сразу.
+class HttpServer {
+public:
+    static const size_t MAX_HEADER_BYTES = 16 * 1024;
+    static const size_t MAX_BODY_BYTES = 16 * 1024;         // API только GET: большее тело - 413
+    static const size_t MAX_PENDING_OUTPUT = 1024 * 1024;   // дальше не читаем, пока клиент не заберет
+    static const int IDLE_TIMEOUT_SEC = 60;
+
+private:
+    struct Connection;
+    struct Worker;
+
+    uint16_t port;
+    int threadCount;
+    HttpHandler handler;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> running{false};
+
+    void runWorker(Worker& worker);
+    bool readFrom(Worker& worker, Connection& connection);
+    void processRequests(Connection& connection);
+    bool flush(Worker& worker, Connection& connection);
+    void closeConnection(Worker& worker, int fd);
+
+public:
+    // threads <= 0 - по числу ядер
+    HttpServer(uint16_t listenPort, int threads, HttpHandler requestHandler);
+    ~HttpServer();
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    bool start();
+    void stop();
+    int getThreadCount() const { return threadCount; }
+
+    static const char* statusText(int status);
+};
+
+#endif // HTTP_SERVER_HPP
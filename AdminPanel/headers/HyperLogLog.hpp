@@ -0,0 +1,49 @@
+#ifndef HYPER_LOG_LOG_HPP
+#define HYPER_LOG_LOG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+// Оценка числа различных значений: 2^PRECISION регистров по 6 бит значимости
+// (хранятся байтами), стандартная ошибка ~1.04 / sqrt(2^PRECISION) = 1.6%.
+// Пока различных значений мало - разреженный отсортированный список
+// (индекс регистра, значение): тысячи маленьких множеств (игра за день)
+// занимают байты, а не по 4 КБ. Повторное добавление ничего не меняет,
+// объединение (merge) - поэлементный максимум.
+class HyperLogLog {
+public:
+    static constexpr uint32_t PRECISION = 12;
+    static constexpr uint32_t REGISTERS = 1u << PRECISION;
+    // Разреженный список длиннее - переход к плотным регистрам (4 байта на запись)
+    static constexpr size_t SPARSE_LIMIT = REGISTERS / 8;
+
+private:
+    std::vector<uint32_t> sparse;       // (index << 8) | rank по возрастанию index
+    std::vector<uint8_t> dense;         // пусто - разреженный режим
+
+    void setRegister(uint32_t index, uint8_t rank);
+    void densify();
+
+public:
+    // Перемешивание ID перед add: соседние ID дают независимые хеши
+    static uint64_t hashId(uint64_t id);
+
+    void add(uint64_t hash);
+    void addId(uint64_t id) { add(hashId(id)); }
+    void merge(const HyperLogLog& other);
+    uint64_t estimate() const;
+    void clear();
+
+    bool empty() const { return sparse.empty() && dense.empty(); }
+    bool isDense() const { return !dense.empty(); }
+    size_t memoryUsage() const { return sparse.capacity() * sizeof(uint32_t) + dense.capacity(); }
+
+    // Двоичная запись: режим, длина, данные. false - поток оборвался или данные неверны
+    void write(std::ostream& out) const;
+    bool read(std::istream& in);
+};
+
+#endif // HYPER_LOG_LOG_HPP
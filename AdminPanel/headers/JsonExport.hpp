@@ -0,0 +1,25 @@
+#ifndef JSON_EXPORT_HPP
+#define JSON_EXPORT_HPP
+
+#include <cstddef>
+#include <string>
+#include "User.hpp"
+#include "Game.hpp"
+#include "Platform.hpp"
+#include "Review.hpp"
+
+// Выгрузка таблиц в один JSON-файл (config.json: features.enable_export):
+//   {"users":[...],"categories":[...],"platforms":[...],"games":[...],"reviews":[...]}
+// Объекты пишет JsonWriter::entity по EntitySchema (FIELD_PRIVATE не выгружаются).
+// Строки читаются потоком из ResultSet, буфер сбрасывается в файл каждые FLUSH_BYTES:
+// память не зависит от размера таблиц.
+class JsonExport {
+public:
+    static const size_t FLUSH_BYTES = 64 * 1024;
+
+    // rows - сколько строк выгружено; false - ошибка чтения или записи
+    static bool write(const std::string& path, User& userMgr, Game& gameMgr,
+                      Platform& platformMgr, Review& reviewMgr, size_t* rows = nullptr);
+};
+
+#endif // JSON_EXPORT_HPP
@@ -0,0 +1,147 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include "Repository.hpp"
+
+// Потоковая запись JSON прямо в строку вызывающего: без дерева и без
+// выделений на поле. Буфер можно переиспользовать (clear() сохраняет емкость).
+//   std::string buffer;
+//   JsonWriter json(buffer);
+//   json.beginArray(); for (...) json.entity(game); json.endArray();
+class JsonWriter {
+public:
+    static const int MAX_DEPTH = 64;        // по биту hasItems на уровень
+
+private:
+    std::string& out;
+    uint64_t hasItems = 0;      // бит на уровень вложенности: нужна запятая перед следующим
+    int depth = 0;
+    bool afterKey = false;
+
+    void separate() {
+        if (afterKey) {
+            afterKey = false;
+        } else if (depth > 0) {
+            uint64_t bit = uint64_t(1) << (depth - 1);
+            if (hasItems & bit) {
+                out += ',';
+            }
+            hasItems |= bit;
+        }
+    }
+
+    template <typename Number>
+    void integer(Number value) {
+        separate();
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+
+    void open(char bracket) {
+        if (depth >= MAX_DEPTH) {
+            throw std::length_error("JsonWriter nesting is deeper than MAX_DEPTH");
+        }
+        separate();
+        out += bracket;
+        ++depth;
+        hasItems &= ~(uint64_t(1) << (depth - 1));
+    }
+
+    void close(char bracket) {
+        --depth;
+        out += bracket;
+    }
+
+    template <typename T>
+    void fieldValue(const T& value, unsigned flags) {
+        if constexpr (std::is_same<T, std::string>::value) {
+            if (value.empty() && (flags & FIELD_NULL_IF_EMPTY)) {
+                null();
+            } else {
+                this->value(std::string_view(value));
+            }
+        } else {
+            this->value(value);
+        }
+    }
+
+public:
+    explicit JsonWriter(std::string& buffer) : out(buffer) {}
+
+    // Строка в кавычках с экранированием по JSON.stringify (SSE2, если есть)
+    static void appendEscaped(std::string& out, std::string_view value);
+
+    void beginObject() { open('{'); }
+    void endObject() { close('}'); }
+    void beginArray() { open('['); }
+    void endArray() { close(']'); }
+
+    // Имя поля без экранирования: только константы из кода
+    void key(std::string_view name) {
+        separate();
+        out += '"';
+        out += name;
+        out += "\":";
+        afterKey = true;
+    }
+
+    void value(std::string_view text) {
+        separate();
+        appendEscaped(out, text);
+    }
+    void value(const char* text) { value(std::string_view(text)); }
+    void value(int number) { integer(number); }
+    void value(long long number) { integer(number); }
+    void value(unsigned long long number) { integer(number); }
+    void value(bool flag) {
+        separate();
+        out += flag ? "true" : "false";
+    }
+    // Кратчайшая запись, которая читается обратно в то же число; NaN и бесконечность - null
+    void value(double number);
+    void null() {
+        separate();
+        out += "null";
+    }
+    // Готовый фрагмент JSON (число из БД, заранее собранный объект)
+    void raw(std::string_view json) {
+        separate();
+        out += json;
+    }
+
+    // Объект по EntitySchema: имена колонок как ключи, FIELD_PRIVATE пропускаются
+    template <typename Entity>
+    void entity(const Entity& item) {
+        beginObject();
+        std::apply([&](const auto&... fields) {
+            auto write = [&](const auto& f) {
+                if (f.flags & FIELD_PRIVATE) {
+                    return;
+                }
+                key(f.column);
+                fieldValue(item.*(f.member), f.flags);
+            };
+            (write(fields), ...);
+        }, EntitySchema<Entity>::fields);
+        endObject();
+    }
+
+    template <typename Entity>
+    void entities(const std::vector<Entity>& items) {
+        beginArray();
+        for (const Entity& item : items) {
+            entity(item);
+        }
+        endArray();
+    }
+};
+
+#endif // JSON_WRITER_HPP
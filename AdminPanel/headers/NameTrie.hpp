@@ -0,0 +1,77 @@
+#ifndef NAME_TRIE_HPP
+#define NAME_TRIE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct NameMatch {
+    int id;
+    const std::string* name;
+    uint32_t score;
+};
+
+// Сжатое префиксное дерево (radix) по именам в нижнем регистре (ASCII и кириллица,
+// байты UTF-8). В каждом узле - наибольший score поддерева: дополнение берет
+// top-N по популярности, не обходя все поддерево префикса.
+class NameTrie {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+private:
+    struct Node {
+        uint32_t labelStart = 0;        // метка ребра в labels
+        uint32_t labelLength = 0;
+        uint32_t parent = NONE;
+        uint32_t firstChild = NONE;
+        uint32_t nextSibling = NONE;    // братья по возрастанию первого байта метки
+        uint32_t entries = NONE;        // первая запись с ключом, который кончается здесь
+        uint32_t best = 0;              // наибольший score в поддереве
+    };
+
+    struct Entry {
+        int id;
+        uint32_t score;
+        uint32_t node;
+        uint32_t next;                  // следующая запись с тем же ключом
+        std::string name;
+    };
+
+    std::vector<Node> nodes;            // nodes[0] - корень
+    std::string labels;
+    std::vector<Entry> entries;
+    std::vector<uint32_t> freeEntries;
+    std::unordered_map<int, uint32_t> byId;
+    size_t count = 0;
+
+    char labelByte(uint32_t node, size_t i) const { return labels[nodes[node].labelStart + i]; }
+    uint32_t findChild(uint32_t node, char first) const;
+    void linkChild(uint32_t parent, uint32_t child);
+    void unlinkChild(uint32_t parent, uint32_t child);
+    uint32_t splitNode(uint32_t node, uint32_t at);
+    // Узел, ключ которого равен key; NONE - нет. prefix: допускается конец key внутри метки
+    uint32_t descend(const std::string& key, bool prefix) const;
+    void refreshBest(uint32_t node);
+
+public:
+    NameTrie();
+
+    // Запись с тем же id заменяется
+    void insert(int id, const std::string& name, uint32_t score);
+    bool remove(int id);
+    bool setScore(int id, uint32_t score);
+    void clear();
+
+    // id записи с таким именем без учета регистра или -1
+    int find(const std::string& name) const;
+    bool contains(const std::string& name) const { return find(name) >= 0; }
+    // Имена, начинающиеся с prefix: по убыванию score, при равном - сначала короче
+    std::vector<NameMatch> complete(const std::string& prefix, size_t limit) const;
+
+    size_t size() const { return count; }
+    size_t memoryUsage() const;
+};
+
+#endif // NAME_TRIE_HPP
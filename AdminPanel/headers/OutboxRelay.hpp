@@ -0,0 +1,45 @@
+#ifndef OUTBOX_RELAY_HPP
+#define OUTBOX_RELAY_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "DatabaseConnection.hpp"
+#include "EventLog.hpp"
+
+// Переносит события из outbox_event в EventLog и удаляет перенесенные строки.
+// Работает в своем потоке со своим соединением: DatabaseConnection не
+// рассчитан на несколько потоков. Порядок в журнале - порядок idEvent в пачке.
+class OutboxRelay {
+private:
+    std::shared_ptr<DatabaseConnection> db;
+    EventLog log;
+    std::chrono::milliseconds interval;
+    size_t batchSize;
+    std::string undeleted;      // idEvent уже в журнале, но DELETE не прошел
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    bool stopping = false;
+    std::thread worker;
+
+    void run();
+    // Одна пачка; -1 - ошибка БД или записи журнала, иначе число перенесенных событий
+    int relayBatch();
+
+public:
+    OutboxRelay(std::shared_ptr<DatabaseConnection> connection, const std::string& logDir,
+                uint64_t segmentBytes = EventLog::DEFAULT_SEGMENT_BYTES,
+                std::chrono::milliseconds pollInterval = std::chrono::milliseconds(1000),
+                size_t maxBatch = 1000);
+    // Последний проход и остановка потока
+    ~OutboxRelay();
+
+    OutboxRelay(const OutboxRelay&) = delete;
+    OutboxRelay& operator=(const OutboxRelay&) = delete;
+};
+
+#endif // OUTBOX_RELAY_HPP
@@ -4,7 +4,7 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include "DatabaseConnection.hpp"
+#include "Repository.hpp"
 
 struct PlatformData {
     int idPlatform;
@@ -20,12 +20,38 @@ struct GamePlatformData {
     double price;
 };
 
+template <>
+struct EntitySchema<PlatformData> {
+    static constexpr const char* table = "platform";
+    static constexpr auto fields = std::make_tuple(
+        field("idPlatform", &PlatformData::idPlatform, FIELD_KEY | FIELD_GENERATED),
+        field("Platform_name", &PlatformData::platformName),
+        field("Type", &PlatformData::type),
+        field("Description", &PlatformData::description));
+};
+
+// Составной ключ (idGame, idPlatform)
+template <>
+struct EntitySchema<GamePlatformData> {
+    static constexpr const char* table = "game_s_platfo";
+    static constexpr auto fields = std::make_tuple(
+        field("idGame", &GamePlatformData::idGame, FIELD_KEY),
+        field("idPlatform", &GamePlatformData::idPlatform, FIELD_KEY),
+        field("ReleaseDate", &GamePlatformData::releaseDate),
+        field("Price", &GamePlatformData::price));
+};
+
 class Platform {
 private:
-    std::shared_ptr<DatabaseConnection> db;
+    Repository<PlatformData> platforms;
+    Repository<GamePlatformData> gamePlatforms;
 
 public:
     explicit Platform(std::shared_ptr<DatabaseConnection> database);
+    // Все записи менеджера публикуются в bus
+    void setEventBus(std::shared_ptr<EventBus> bus);
+    // Записи идут в транзакции вместе с событием в outbox_event
+    void setOutbox(bool enabled);
     
     // Platform CRUD operations
     bool addPlatform(const std::string& platformName, const std::string& type,
@@ -42,6 +68,12 @@ public:
     // Read operations
     std::vector<PlatformData> getAllPlatforms();
     PlatformData getPlatformById(int platformId);
+    std::vector<PlatformData> getPlatformsByIds(const std::vector<int>& ids);
+    // Без копирования строк: колонки в порядке EntitySchema<PlatformData>
+    ResultSet scanAllPlatforms();
+    ResultSet scanAllGamePlatforms();
+    ResultSet scanPlatformsChangedSince(const std::string& since);
+    ResultSet scanGamePlatformsChangedSince(const std::string& since);
     std::vector<GamePlatformData> getGamesPlatforms(int gameId);
     std::vector<GamePlatformData> getPlatformGames(int platformId);
     int getPlatformCount();
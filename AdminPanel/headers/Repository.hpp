@@ -0,0 +1,610 @@
+#ifndef REPOSITORY_HPP
+#define REPOSITORY_HPP
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+#include <type_traits>
+#include "DatabaseConnection.hpp"
+#include "ResultSet.hpp"
+#include "EventBus.hpp"
+
+// Флаги колонок в схеме сущности
+enum FieldFlags : unsigned {
+    FIELD_KEY = 1,            // входит в первичный ключ (WHERE для update/remove)
+    FIELD_GENERATED = 2,      // заполняет БД (AUTO_INCREMENT, DEFAULT) - не пишем
+    FIELD_NULL_IF_EMPTY = 4,  // пустая строка пишется как NULL
+    FIELD_PRIVATE = 8         // не покидает БД: нет в outbox и журнале изменений
+};
+
+// Колонка таблицы <-> поле структуры
+template <typename Entity, typename T>
+struct Field {
+    const char* column;
+    T Entity::* member;
+    unsigned flags;
+};
+
+template <typename Entity, typename T>
+constexpr Field<Entity, T> field(const char* column, T Entity::* member, unsigned flags = 0) {
+    return Field<Entity, T>{column, member, flags};
+}
+
+// Специализируется рядом с каждой структурой данных:
+//   static constexpr const char* table;
+//   static constexpr auto fields = std::make_tuple(field(...), ...);
+// Порядок fields = порядок колонок в SELECT и в строке результата.
+template <typename Entity>
+struct EntitySchema;
+
+// Разбор и запись значений колонок
+inline void decodeValue(const char* value, unsigned long, int& out) {
+    out = value ? std::atoi(value) : 0;
+}
+
+inline void decodeValue(const char* value, unsigned long, double& out) {
+    out = value ? std::strtod(value, nullptr) : 0.0;
+}
+
+inline void decodeValue(const char* value, unsigned long length, bool& out) {
+    out = value && length == 1 && value[0] == '1';
+}
+
+inline void decodeValue(const char* value, unsigned long length, std::string& out) {
+    if (value) {
+        out.assign(value, length);
+    } else {
+        out.clear();
+    }
+}
+
+inline void encodeValue(std::ostream& out, DatabaseConnection&, int value, unsigned) {
+    out << value;
+}
+
+inline void encodeValue(std::ostream& out, DatabaseConnection&, double value, unsigned) {
+    out << std::setprecision(15) << value;
+}
+
+inline void encodeValue(std::ostream& out, DatabaseConnection&, bool value, unsigned) {
+    out << (value ? 1 : 0);
+}
+
+inline void encodeValue(std::ostream& out, DatabaseConnection& db, const std::string& value,
+                        unsigned flags) {
+    if (value.empty() && (flags & FIELD_NULL_IF_EMPTY)) {
+        out << "NULL";
+    } else {
+        out << "'" << db.escapeString(value) << "'";
+    }
+}
+
+// Общий путь запрос -> разбор -> освобождение результата для всех менеджеров.
+// Ошибки пишутся в std::cerr, методы возвращают пустой результат / false.
+template <typename Entity>
+class Repository {
+private:
+    using Schema = EntitySchema<Entity>;
+
+    std::shared_ptr<DatabaseConnection> db;
+    std::shared_ptr<EventBus> events;
+    bool outbox = false;
+
+    static constexpr size_t fieldCount() {
+        return std::tuple_size<std::decay_t<decltype(Schema::fields)>>::value;
+    }
+
+    template <typename Fn>
+    static void forEachField(Fn&& fn) {
+        std::apply([&fn](const auto&... f) { (fn(f), ...); }, Schema::fields);
+    }
+
+    // Поле f совпадает с одним из перечисленных членов структуры
+    template <typename F, typename... T>
+    static bool isListed(const F& f, T Entity::*... members) {
+        bool listed = false;
+        auto check = [&](auto member) {
+            if constexpr (std::is_same<decltype(member), decltype(f.member)>::value) {
+                listed = listed || member == f.member;
+            }
+        };
+        (check(members), ...);
+        return listed;
+    }
+
+    std::string keyCondition(const Entity& entity) {
+        std::ostringstream condition;
+        bool first = true;
+        forEachField([&](const auto& f) {
+            if (f.flags & FIELD_KEY) {
+                condition << (first ? "" : " AND ") << f.column << " = ";
+                encodeValue(condition, *db, entity.*(f.member), f.flags);
+                first = false;
+            }
+        });
+        return condition.str();
+    }
+
+    std::string makeUpdate(const Entity& entity, const std::vector<bool>& setColumns) {
+        std::ostringstream query;
+        query << "UPDATE " << Schema::table << " SET ";
+        size_t index = 0;
+        bool first = true;
+        forEachField([&](const auto& f) {
+            if (setColumns[index++]) {
+                query << (first ? "" : ", ") << f.column << " = ";
+                encodeValue(query, *db, entity.*(f.member), f.flags);
+                first = false;
+            }
+        });
+        if (first) {
+            return "";
+        }
+        query << " WHERE " << keyCondition(entity) << ";";
+        return query.str();
+    }
+
+    bool executeUpdate(const Entity& entity, const std::vector<bool>& setColumns) {
+        try {
+            std::string sql = makeUpdate(entity, setColumns);
+            if (sql.empty()) {
+                std::cerr << "ERROR in Repository<" << Schema::table << ">::update: no columns to set\n";
+                return false;
+            }
+            std::optional<Entity> before = tracking() ? findByKey(entity) : std::nullopt;
+            if (!write(sql, ChangeType::UPDATED, keyCondition(entity))) {
+                return false;
+            }
+            if (tracking()) {
+                emit(ChangeType::UPDATED, entity, std::move(before), findByKey(entity));
+            }
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "ERROR in Repository<" << Schema::table << ">::update: " << e.what() << "\n";
+            return false;
+        }
+    }
+
+    // ============= Outbox =============
+
+    // Событие пишется в outbox_event из самой таблицы (INSERT ... SELECT),
+    // в той же транзакции, что и изменение
+    std::string makeOutboxInsert(ChangeType type, const std::string& condition) {
+        std::ostringstream query;
+        query << "INSERT INTO outbox_event (TableName, ChangeType, RowId, RowId2, Payload) SELECT '"
+              << Schema::table << "', '" << changeTypeName(type) << "'";
+        int keys = 0;
+        forEachField([&](const auto& f) {
+            if ((f.flags & FIELD_KEY) && keys < 2) {
+                query << ", " << f.column;
+                ++keys;
+            }
+        });
+        query << (keys < 2 ? ", 0" : "") << ", JSON_OBJECT(";
+        bool first = true;
+        forEachField([&](const auto& f) {
+            if (!(f.flags & FIELD_PRIVATE)) {
+                query << (first ? "" : ", ") << "'" << f.column << "', " << f.column;
+                first = false;
+            }
+        });
+        query << ") FROM " << Schema::table << " WHERE " << condition << ";";
+        return query.str();
+    }
+
+    // Запись с событием в outbox (если включен); insertId - AUTO_INCREMENT самой записи
+    bool write(const std::string& sql, ChangeType type, const std::string& condition,
+               unsigned long long* insertId = nullptr) {
+        if (!outbox) {
+            if (!db->executeQuery(sql)) {
+                return false;
+            }
+            if (insertId) {
+                *insertId = db->getLastInsertId();
+            }
+            return true;
+        }
+        // DELETE: строку читаем до удаления
+        std::vector<std::string> statements;
+        if (type == ChangeType::DELETED) {
+            statements = {makeOutboxInsert(type, condition), sql};
+        } else {
+            statements = {sql, makeOutboxInsert(type, condition)};
+        }
+        std::vector<unsigned long long> insertIds;
+        if (!db->executeTransaction(statements, &insertIds)) {
+            return false;
+        }
+        if (insertId) {
+            *insertId = insertIds.front();
+        }
+        return true;
+    }
+
+    // Условие на только что вставленную строку
+    std::string insertedCondition(const Entity& entity) {
+        const char* generated = nullptr;
+        forEachField([&](const auto& f) {
+            if ((f.flags & FIELD_KEY) && (f.flags & FIELD_GENERATED)) {
+                generated = f.column;
+            }
+        });
+        return generated ? std::string(generated) + " = LAST_INSERT_ID()" : keyCondition(entity);
+    }
+
+    // ============= События изменений =============
+
+    bool tracking() const {
+        return events && events->template hasSubscribers<Entity>();
+    }
+
+    std::optional<Entity> findByKey(const Entity& keyed) {
+        std::vector<Entity> found = findWhere(keyCondition(keyed));
+        if (found.empty()) {
+            return std::nullopt;
+        }
+        return std::move(found.front());
+    }
+
+    // AUTO_INCREMENT ключ после INSERT
+    static void setGeneratedKey(Entity& entity, unsigned long long id) {
+        forEachField([&](const auto& f) {
+            if constexpr (std::is_same<std::decay_t<decltype(entity.*(f.member))>, int>::value) {
+                if ((f.flags & FIELD_KEY) && (f.flags & FIELD_GENERATED)) {
+                    entity.*(f.member) = static_cast<int>(id);
+                }
+            }
+        });
+    }
+
+    void emit(ChangeType type, const Entity& keyed, std::optional<Entity> before, std::optional<Entity> after) {
+        ChangeEvent<Entity> event{type, 0, 0, std::move(before), std::move(after), 0};
+        int keyIndex = 0;
+        forEachField([&](const auto& f) {
+            if constexpr (std::is_same<std::decay_t<decltype(keyed.*(f.member))>, int>::value) {
+                if (f.flags & FIELD_KEY) {
+                    (keyIndex++ == 0 ? event.id : event.id2) = keyed.*(f.member);
+                }
+            }
+        });
+        events->publish(std::move(event));
+    }
+
+public:
+    explicit Repository(std::shared_ptr<DatabaseConnection> database) : db(database) {
+        if (!db) {
+            throw std::runtime_error("ERROR: Database connection is null!");
+        }
+    }
+
+    // После успешных insert/update/remove публикует ChangeEvent<Entity>
+    void setEventBus(std::shared_ptr<EventBus> bus) {
+        events = std::move(bus);
+    }
+
+    // Каждая запись дополнительно пишет событие в outbox_event в той же транзакции
+    // (server/migrations/add_outbox.sql); OutboxRelay переносит их в EventLog
+    void setOutbox(bool enabled) {
+        outbox = enabled;
+    }
+
+    std::string escape(const std::string& value) {
+        return db->escapeString(value);
+    }
+
+    static const char* table() {
+        return Schema::table;
+    }
+
+    // "idUser, Username, ..." - собирается один раз
+    static const std::string& selectList() {
+        static const std::string list = selectList("");
+        return list;
+    }
+
+    // С префиксом таблицы: selectList("r") -> "r.idReview, r.idUser, ..."
+    static std::string selectList(const std::string& alias) {
+        std::string list;
+        forEachField([&](const auto& f) {
+            if (!list.empty()) {
+                list += ", ";
+            }
+            if (!alias.empty()) {
+                list += alias + ".";
+            }
+            list += f.column;
+        });
+        return list;
+    }
+
+    static const char* keyColumn() {
+        const char* key = nullptr;
+        forEachField([&](const auto& f) {
+            if (!key && (f.flags & FIELD_KEY)) {
+                key = f.column;
+            }
+        });
+        return key;
+    }
+
+    static bool hasColumn(const std::string& column) {
+        bool found = false;
+        forEachField([&](const auto& f) {
+            found = found || column == f.column;
+        });
+        return found;
+    }
+
+    // Номер колонки поля в строке результата: row.text(columnOf(&ReviewData::reviewText))
+    template <typename T>
+    static unsigned int columnOf(T Entity::* member) {
+        unsigned int index = 0;
+        unsigned int found = 0;
+        forEachField([&](const auto& f) {
+            if constexpr (std::is_same<decltype(f.member), T Entity::*>::value) {
+                if (f.member == member) {
+                    found = index;
+                }
+            }
+            ++index;
+        });
+        return found;
+    }
+
+    // Копия строки в структуру - когда данные должны пережить ResultSet
+    static Entity materialize(const RowView& row) {
+        Entity entity{};
+        unsigned int index = 0;
+        forEachField([&](const auto& f) {
+            decodeValue(row.raw(index), row.length(index), entity.*(f.member));
+            ++index;
+        });
+        return entity;
+    }
+
+    // Произвольный SELECT, колонки которого идут в порядке схемы.
+    // Строки читаются через RowView без копирования текста.
+    ResultSet select(const std::string& sql) {
+        try {
+            ResultSet result(db->getReadResult(sql));
+            if (!result) {
+                std::cerr << "ERROR: Failed to read " << Schema::table << " from database!\n";
+                return result;
+            }
+
+            if (result.getFieldCount() < fieldCount()) {
+                std::cerr << "ERROR in Repository<" << Schema::table << ">::select: column count mismatch\n";
+                return ResultSet();
+            }
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "ERROR in Repository<" << Schema::table << ">::select: " << e.what() << "\n";
+            return ResultSet();
+        }
+    }
+
+    // SELECT с произвольным набором колонок (агрегаты, ID) - без сверки со схемой
+    ResultSet selectRaw(const std::string& sql) {
+        try {
+            ResultSet result(db->getReadResult(sql));
+            if (!result) {
+                std::cerr << "ERROR: Failed to read " << Schema::table << " from database!\n";
+            }
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "ERROR in Repository<" << Schema::table << ">::selectRaw: " << e.what() << "\n";
+            return ResultSet();
+        }
+    }
+
+    // Строки, вставленные или измененные начиная с since (время сервера). Нужна колонка
+    // UpdatedDate DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP.
+    // Минута перекрытия - запас на транзакции, закоммиченные позже своего UpdatedDate
+    ResultSet selectChangedSince(const std::string& since) {
+        return selectWhere("UpdatedDate >= DATE_SUB('" + escape(since) + "', INTERVAL 60 SECOND)");
+    }
+
+    ResultSet selectAll() {
+        return select("SELECT " + selectList() + " FROM " + Schema::table + ";");
+    }
+
+    ResultSet selectWhere(const std::string& condition) {
+        return select("SELECT " + selectList() + " FROM " + Schema::table + " WHERE " + condition + ";");
+    }
+
+    // ORDER BY только по колонкам схемы, ключ - второй ключ сортировки для стабильных страниц
+    ResultSet selectPage(int offset, int limit, const std::string& orderBy, bool ascending,
+                         const std::string& condition = "") {
+        if (offset < 0 || limit <= 0) {
+            return ResultSet();
+        }
+        std::string column = hasColumn(orderBy) ? orderBy : keyColumn();
+
+        std::ostringstream sql;
+        sql << "SELECT " << selectList() << " FROM " << Schema::table;
+        if (!condition.empty()) {
+            sql << " WHERE " << condition;
+        }
+        sql << " ORDER BY " << column << (ascending ? " ASC" : " DESC") << ", " << keyColumn()
+            << " LIMIT " << offset << ", " << limit << ";";
+        return select(sql.str());
+    }
+
+    // select(), но строки копируются в структуры
+    std::vector<Entity> query(const std::string& sql) {
+        return materializeAll(select(sql));
+    }
+
+    static std::vector<Entity> materializeAll(ResultSet result) {
+        std::vector<Entity> entities;
+        entities.reserve(static_cast<size_t>(result.getRowCount()));
+        for (const RowView& row : result) {
+            entities.push_back(materialize(row));
+        }
+        return entities;
+    }
+
+    std::vector<Entity> findAll() {
+        return materializeAll(selectAll());
+    }
+
+    std::vector<Entity> findWhere(const std::string& condition) {
+        return materializeAll(selectWhere(condition));
+    }
+
+    bool findById(int id, Entity& out) {
+        std::ostringstream condition;
+        condition << keyColumn() << " = " << id;
+        std::vector<Entity> found = findWhere(condition.str());
+        if (found.empty()) {
+            return false;
+        }
+        out = std::move(found.front());
+        return true;
+    }
+
+    // Пачками по BATCH_SIZE ID в одном IN (...)
+    std::vector<Entity> findByIds(const std::vector<int>& ids) {
+        static const size_t BATCH_SIZE = 500;
+        std::vector<Entity> entities;
+        for (size_t start = 0; start < ids.size(); start += BATCH_SIZE) {
+            std::ostringstream condition;
+            condition << keyColumn() << " IN (";
+            size_t end = std::min(ids.size(), start + BATCH_SIZE);
+            for (size_t i = start; i < end; ++i) {
+                condition << (i > start ? ", " : "") << ids[i];
+            }
+            condition << ")";
+
+            std::vector<Entity> batch = findWhere(condition.str());
+            entities.insert(entities.end(), std::make_move_iterator(batch.begin()),
+                            std::make_move_iterator(batch.end()));
+        }
+        return entities;
+    }
+
+    std::vector<Entity> findPage(int offset, int limit, const std::string& orderBy, bool ascending,
+                                 const std::string& condition = "") {
+        return materializeAll(selectPage(offset, limit, orderBy, ascending, condition));
+    }
+
+    // SELECT <expression> FROM table [WHERE condition] - COUNT, AVG, ...
+    double aggregate(const std::string& expression, const std::string& condition = "") {
+        try {
+            std::string sql = "SELECT " + expression + " FROM " + Schema::table +
+                              (condition.empty() ? "" : " WHERE " + condition) + ";";
+            MYSQL_RES* result = db->getReadResult(sql);
+            if (!result) {
+                return 0.0;
+            }
+
+            MYSQL_ROW row = mysql_fetch_row(result);
+            double value = (row && row[0]) ? std::strtod(row[0], nullptr) : 0.0;
+
+            db->freeResult(result);
+            return value;
+        } catch (const std::exception& e) {
+            std::cerr << "ERROR in Repository<" << Schema::table << ">::aggregate: " << e.what() << "\n";
+            return 0.0;
+        }
+    }
+
+    int count(const std::string& condition = "") {
+        return static_cast<int>(aggregate("COUNT(*)", condition));
+    }
+
+    bool insert(const Entity& entity) {
+        try {
+            std::ostringstream columns;
+            std::ostringstream values;
+            bool first = true;
+            forEachField([&](const auto& f) {
+                if (!(f.flags & FIELD_GENERATED)) {
+                    columns << (first ? "" : ", ") << f.column;
+                    values << (first ? "" : ", ");
+                    encodeValue(values, *db, entity.*(f.member), f.flags);
+                    first = false;
+                }
+            });
+
+            unsigned long long insertId = 0;
+            if (!write("INSERT INTO " + std::string(Schema::table) + " (" + columns.str() + ") VALUES (" +
+                       values.str() + ");", ChangeType::INSERTED, insertedCondition(entity), &insertId)) {
+                return false;
+            }
+            if (tracking()) {
+                Entity keyed = entity;
+                setGeneratedKey(keyed, insertId);
+                // Перечитываем: значения DEFAULT заполнила БД
+                std::optional<Entity> after = findByKey(keyed);
+                emit(ChangeType::INSERTED, keyed, std::nullopt, after ? std::move(after) : std::optional<Entity>(keyed));
+            }
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "ERROR in Repository<" << Schema::table << ">::insert: " << e.what() << "\n";
+            return false;
+        }
+    }
+
+    // Все записываемые колонки, кроме ключа
+    bool update(const Entity& entity) {
+        std::vector<bool> setColumns;
+        forEachField([&](const auto& f) {
+            setColumns.push_back(!(f.flags & (FIELD_KEY | FIELD_GENERATED)));
+        });
+        return executeUpdate(entity, setColumns);
+    }
+
+    // Только перечисленные поля: update(user, &UserData::privilege)
+    template <typename... T>
+    bool update(const Entity& entity, T Entity::*... members) {
+        std::vector<bool> setColumns;
+        forEachField([&](const auto& f) {
+            setColumns.push_back(!(f.flags & FIELD_KEY) && isListed(f, members...));
+        });
+        return executeUpdate(entity, setColumns);
+    }
+
+    // Удаление по значениям ключевых полей entity (подходит и для составного ключа)
+    bool remove(const Entity& entity) {
+        try {
+            std::optional<Entity> before = tracking() ? findByKey(entity) : std::nullopt;
+            std::string condition = keyCondition(entity);
+            if (!write("DELETE FROM " + std::string(Schema::table) + " WHERE " + condition + ";",
+                       ChangeType::DELETED, condition)) {
+                return false;
+            }
+            if (tracking()) {
+                emit(ChangeType::DELETED, entity, std::move(before), std::nullopt);
+            }
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "ERROR in Repository<" << Schema::table << ">::remove: " << e.what() << "\n";
+            return false;
+        }
+    }
+
+    bool removeById(int id) {
+        // Первое ключевое поле, как в findById
+        Entity keyed{};
+        bool assigned = false;
+        forEachField([&](const auto& f) {
+            if constexpr (std::is_same<std::decay_t<decltype(keyed.*(f.member))>, int>::value) {
+                if (!assigned && (f.flags & FIELD_KEY)) {
+                    keyed.*(f.member) = id;
+                    assigned = true;
+                }
+            }
+        });
+        return remove(keyed);
+    }
+};
+
+#endif // REPOSITORY_HPP
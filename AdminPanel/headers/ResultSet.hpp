@@ -0,0 +1,89 @@
+#ifndef RESULT_SET_HPP
+#define RESULT_SET_HPP
+
+#include <mysql.h>
+#include <string>
+#include <string_view>
+
+// Строка результата без копирования. Сам RowView действителен до следующего
+// next() (mysql_fetch_lengths переиспользует буфер), а string_view из text()
+// указывают в буфер MYSQL_RES и живут, пока жив ResultSet.
+class RowView {
+private:
+    MYSQL_ROW row;
+    const unsigned long* lengths;
+    unsigned int fieldCount;
+
+public:
+    RowView() : row(nullptr), lengths(nullptr), fieldCount(0) {}
+    RowView(MYSQL_ROW r, const unsigned long* l, unsigned int count)
+        : row(r), lengths(l), fieldCount(count) {}
+
+    unsigned int size() const { return fieldCount; }
+    bool isNull(unsigned int index) const;
+    const char* raw(unsigned int index) const;
+    unsigned long length(unsigned int index) const;
+
+    std::string_view text(unsigned int index) const;
+    int asInt(unsigned int index) const;
+    double asDouble(unsigned int index) const;
+    bool asBool(unsigned int index) const;
+
+    // Явная копия, когда значение должно пережить ResultSet
+    std::string toString(unsigned int index) const;
+};
+
+// Владеет MYSQL_RES (mysql_store_result): освобождает в деструкторе, только перемещение.
+//   for (const RowView& row : result) { ... }
+class ResultSet {
+private:
+    MYSQL_RES* result;
+    unsigned int fieldCount;
+
+    void release();
+
+public:
+    ResultSet() : result(nullptr), fieldCount(0) {}
+    explicit ResultSet(MYSQL_RES* res);
+    ~ResultSet();
+
+    ResultSet(const ResultSet&) = delete;
+    ResultSet& operator=(const ResultSet&) = delete;
+    ResultSet(ResultSet&& other) noexcept;
+    ResultSet& operator=(ResultSet&& other) noexcept;
+
+    bool isValid() const { return result != nullptr; }
+    explicit operator bool() const { return isValid(); }
+    unsigned int getFieldCount() const { return fieldCount; }
+    unsigned long long getRowCount() const;
+
+    // Следующая строка; false - строки кончились
+    bool next(RowView& row);
+
+    class Iterator {
+    private:
+        ResultSet* owner;
+        RowView current;
+
+    public:
+        explicit Iterator(ResultSet* set) : owner(set) { ++(*this); }
+        Iterator() : owner(nullptr) {}
+
+        const RowView& operator*() const { return current; }
+        const RowView* operator->() const { return &current; }
+        Iterator& operator++() {
+            if (owner && !owner->next(current)) {
+                owner = nullptr;
+            }
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return owner == other.owner; }
+        bool operator!=(const Iterator& other) const { return owner != other.owner; }
+    };
+
+    // Однопроходный: строки читаются по мере обхода
+    Iterator begin() { return result ? Iterator(this) : Iterator(); }
+    Iterator end() { return Iterator(); }
+};
+
+#endif // RESULT_SET_HPP
@@ -4,7 +4,7 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include "DatabaseConnection.hpp"
+#include "Repository.hpp"
 
 struct ReviewData {
     int idReview;
@@ -19,12 +19,30 @@ struct ReviewData {
     bool isActive;
 };
 
+// AvgMark, ReviewDate и Validation менеджер не читает
+template <>
+struct EntitySchema<ReviewData> {
+    static constexpr const char* table = "review";
+    static constexpr auto fields = std::make_tuple(
+        field("idReview", &ReviewData::idReview, FIELD_KEY | FIELD_GENERATED),
+        field("idUser", &ReviewData::idUser),
+        field("idGame", &ReviewData::idGame),
+        field("idPlatform", &ReviewData::idPlatform),
+        field("Review_text", &ReviewData::reviewText),
+        field("Mark", &ReviewData::mark),
+        field("IsActive", &ReviewData::isActive, FIELD_GENERATED));
+};
+
 class Review {
 private:
-    std::shared_ptr<DatabaseConnection> db;
+    Repository<ReviewData> repo;
 
 public:
     explicit Review(std::shared_ptr<DatabaseConnection> database);
+    // Все записи менеджера публикуются в bus
+    void setEventBus(std::shared_ptr<EventBus> bus);
+    // Записи идут в транзакции вместе с событием в outbox_event
+    void setOutbox(bool enabled);
     
     // Review CRUD operations
     bool addReview(int idUser, int idGame, int idPlatform, 
@@ -38,6 +56,31 @@ public:
     std::vector<ReviewData> getGameReviews(int gameId);
     std::vector<ReviewData> getUserReviews(int userId);
     std::vector<ReviewData> getPlatformReviews(int platformId);
+    // Страница отзывов игры; reviewText - превью (первые 200 символов)
+    std::vector<ReviewData> getGameReviewsPage(int gameId, int offset, int limit,
+                                               const std::string& orderBy, bool ascending);
+    ResultSet scanGameReviewsPage(int gameId, int offset, int limit,
+                                  const std::string& orderBy, bool ascending);
+    
+    // Все отзывы в порядке колонок схемы (экспорт)
+    ResultSet scanAllReviews();
+    // Агрегаты по играм: (idGame, COUNT(*), SUM(Mark))
+    ResultSet scanRatingsByGame();
+    // Активные отзывы для публичного API: по игре, новые первыми
+    ResultSet scanActiveReviews();
+    // Матрица оценок для рекомендаций: (idUser, idGame, Mark) активных отзывов
+    ResultSet scanUserMarks();
+    // Отзывы за последние days дней по возрастанию даты:
+    // (idReview, idGame, idPlatform, Mark, UNIX_TIMESTAMP(ReviewDate))
+    ResultSet scanRecentMarks(int days);
+    // Те же столбцы для отзывов с idReview > afterReviewId, по возрастанию idReview
+    ResultSet scanMarksSince(int afterReviewId);
+    // Активные отзывы с idReview > afterReviewId для скетчей различных авторов:
+    // (idReview, idUser, idGame, idCategory, idPlatform, UNIX_TIMESTAMP(ReviewDate))
+    ResultSet scanReviewAudienceSince(int afterReviewId);
+    ResultSet scanRatingsForGames(const std::vector<int>& gameIds);
+    // ID игр, отзывы которых добавлены или изменены начиная с since
+    ResultSet scanReviewedGamesSince(const std::string& since);
     
     // Statistics
     double getAverageRating(int gameId);
@@ -0,0 +1,112 @@
+#ifndef REVIEW_ANOMALY_DETECTOR_HPP
+#define REVIEW_ANOMALY_DETECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "ResultSet.hpp"
+
+struct ReviewAnomaly {
+    enum Kind : uint8_t { VOLUME, LOW_MARKS };
+    enum Scope : uint8_t { GAME, PLATFORM };
+
+    uint64_t sequence;
+    Kind kind;
+    Scope scope;
+    int id;
+    int64_t bucketStart;        // начало корзины, секунды UNIX
+    uint32_t reviews;           // отзывов в корзине
+    uint32_t lowMarks;          // из них с оценкой <= LOW_MARK
+    double expected;            // VOLUME - ожидаемое число отзывов, LOW_MARKS - ожидаемая доля низких оценок
+    double zScore;
+};
+
+// Всплески отзывов по играм и платформам. Время делится на корзины (bucketSeconds),
+// у каждой игры/платформы - кольцо из WINDOW_BUCKETS корзин с распределением оценок
+// и экспоненциальное среднее по закрытым корзинам: память на игру постоянна,
+// отзыв обрабатывается за O(1). Проверки после каждого отзыва в текущей корзине:
+//   VOLUME    - число отзывов против среднего и дисперсии прошлых корзин;
+//   LOW_MARKS - число оценок <= LOW_MARK против доли низких оценок у этой игры
+//               (при короткой истории - с поправкой на долю по всем отзывам).
+class ReviewAnomalyDetector {
+public:
+    static constexpr uint32_t WINDOW_BUCKETS = 24;
+    static constexpr uint32_t BASELINE_BUCKETS = 168;  // память среднего: неделя при часовых корзинах
+    static constexpr uint32_t MIN_HISTORY = 24;        // VOLUME только при такой истории
+    static constexpr int LOW_MARK = 3;
+    static constexpr int MAX_MARK = 10;
+    static constexpr double PRIOR_REVIEWS = 20;        // вес общей доли низких оценок в отзывах
+    static constexpr size_t MAX_ALERTS = 256;
+
+    struct Settings {
+        uint32_t bucketSeconds = 3600;
+        double zThreshold = 5.0;
+        uint32_t minReviews = 10;
+    };
+
+    // Скользящее окно из WINDOW_BUCKETS корзин, заканчивающееся корзиной now
+    struct WindowStats {
+        uint32_t reviews = 0;
+        uint32_t marks[MAX_MARK] = {};      // marks[m - 1] - отзывов с оценкой m
+        double baselineReviews = 0;         // ожидаемое число отзывов за корзину
+        double baselineLowShare = 0;
+    };
+
+private:
+    struct Series {
+        int64_t head = INT64_MIN;           // номер текущей корзины
+        uint16_t marks[WINDOW_BUCKETS][MAX_MARK] = {};
+        uint16_t totals[WINDOW_BUCKETS] = {};
+        uint16_t lows[WINDOW_BUCKETS] = {};
+        float meanReviews = 0;              // по закрытым корзинам
+        float varReviews = 0;
+        float meanLows = 0;
+        uint32_t history = 0;               // закрытых корзин, не больше BASELINE_BUCKETS
+        uint64_t alerts[2] = {};            // sequence тревоги VOLUME/LOW_MARKS в текущей корзине
+    };
+
+    Settings settings;
+    std::unordered_map<int, Series> games;
+    std::unordered_map<int, Series> platforms;
+    std::vector<ReviewAnomaly> alerts;      // кольцо из MAX_ALERTS
+    uint64_t nextSequence = 1;
+    uint64_t observed = 0;
+    uint64_t lowObserved = 0;               // общая доля низких оценок - априорная для коротких историй
+    int lastReviewId = 0;                   // самый новый отзыв из apply/backfill
+
+    int64_t bucketOf(int64_t time) const;
+    // Закрывает корзины до bucket; false - bucket старше окна
+    bool advance(Series& series, int64_t bucket) const;
+    void add(Series& series, int64_t bucket, int mark) const;
+    double lowShare(const Series& series) const;
+    void check(Series& series, ReviewAnomaly::Scope scope, int id);
+    void raise(Series& series, ReviewAnomaly::Kind kind, ReviewAnomaly::Scope scope, int id,
+               double expected, double zScore);
+
+public:
+    ReviewAnomalyDetector() = default;
+    explicit ReviewAnomalyDetector(const Settings& settings);
+
+    // Один отзыв; time - секунды UNIX. Отзывы старше окна пропускаются
+    void observe(int gameId, int platformId, int mark, int64_t time);
+    // Строки (idReview, idGame, idPlatform, Mark, UNIX_TIMESTAMP(ReviewDate)) по возрастанию даты.
+    // backfill сначала сбрасывает прежнее состояние, apply - добавляет. false - ошибка чтения
+    bool backfill(ResultSet reviewRows);
+    bool apply(ResultSet reviewRows);
+    void clear();
+
+    // Новые первыми
+    std::vector<ReviewAnomaly> recentAlerts(size_t limit) const;
+    WindowStats window(ReviewAnomaly::Scope scope, int id, int64_t now) const;
+
+    const Settings& getSettings() const { return settings; }
+    size_t getGameCount() const { return games.size(); }
+    size_t getPlatformCount() const { return platforms.size(); }
+    uint64_t getObservedCount() const { return observed; }
+    // Дальше догружаются только отзывы с idReview больше него
+    int getLastReviewId() const { return lastReviewId; }
+    size_t memoryUsage() const;
+};
+
+#endif // REVIEW_ANOMALY_DETECTOR_HPP
@@ -0,0 +1,73 @@
+#ifndef REVIEW_CARDINALITY_HPP
+#define REVIEW_CARDINALITY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <string>
+#include "HyperLogLog.hpp"
+#include "ResultSet.hpp"
+
+// Число различных авторов отзывов и различных игр без COUNT(DISTINCT):
+// HyperLogLog на каждые (измерение, ID, сутки UTC). Период - объединение
+// суточных скетчей, поэтому любой диапазон дней считается сразу.
+// Скетчи только растут: удаленные и скрытые отзывы продолжают учитываться.
+class ReviewCardinality {
+public:
+    enum Dimension : uint8_t { ALL, GAME, PLATFORM, CATEGORY };
+
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t precision;         // HyperLogLog::PRECISION
+        uint64_t cellCount;
+        int64_t lastReviewId;
+        uint64_t checksum;          // FNV-1a 64 по всему, что после заголовка
+    };
+
+    struct Estimate {
+        uint64_t reviewers = 0;
+        uint64_t games = 0;         // для GAME всегда 0
+    };
+
+private:
+    struct Cell {
+        HyperLogLog reviewers;
+        HyperLogLog games;
+    };
+
+    std::unordered_map<uint64_t, Cell> cells;     // ключ - (измерение, ID, день)
+    int lastReviewId = 0;
+    int64_t firstDay = 0;                           // границы дней с отзывами: диапазон запроса
+    int64_t lastDay = -1;                           // обходится только внутри них
+
+    static uint64_t cellKey(Dimension dimension, int id, int64_t day);
+    void addTo(Dimension dimension, int id, int64_t day, int userId, int gameId);
+
+public:
+    // Номер суток UTC
+    static int64_t dayOf(int64_t time);
+
+    // Повторное добавление того же отзыва ничего не меняет
+    void add(int userId, int gameId, int categoryId, int platformId, int64_t time);
+    // Строки (idReview, idUser, idGame, idCategory, idPlatform, UNIX_TIMESTAMP(ReviewDate)) по возрастанию
+    // idReview; только здесь сдвигается lastReviewId. false - ошибка чтения
+    bool apply(ResultSet reviewRows);
+    void clear();
+
+    // Дни fromDay..toDay включительно; id для ALL не важен
+    Estimate count(Dimension dimension, int id, int64_t fromDay, int64_t toDay) const;
+
+    // Запись во временный файл и атомарная подмена (rename)
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    // Самый новый учтенный отзыв: дальше догружаются только idReview больше него
+    int getLastReviewId() const { return lastReviewId; }
+    size_t getCellCount() const { return cells.size(); }
+    size_t memoryUsage() const;
+};
+
+#endif // REVIEW_CARDINALITY_HPP
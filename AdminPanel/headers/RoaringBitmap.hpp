@@ -0,0 +1,72 @@
+#ifndef ROARING_BITMAP_HPP
+#define ROARING_BITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Сжатое множество uint32 (Roaring): значения делятся на блоки по старшим 16 битам,
+// в блоке - отсортированный массив младших половин (до ARRAY_MAX штук)
+// или битовая карта на 65536 бит, если значений больше.
+class RoaringBitmap {
+public:
+    static const uint32_t ARRAY_MAX = 4096;
+    static const size_t BITMAP_WORDS = 1024;
+
+private:
+    struct Container {
+        uint16_t key = 0;
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> array;    // пусто, если блок - битовая карта
+        std::vector<uint64_t> bits;     // BITMAP_WORDS слов или пусто
+
+        bool isBitmap() const { return !bits.empty(); }
+        bool contains(uint16_t low) const;
+        void add(uint16_t low);
+        void toBitmap();
+        void toArrayIfSmall();
+    };
+
+    std::vector<Container> containers;  // по возрастанию key
+
+    static Container andContainers(const Container& a, const Container& b);
+    static Container orContainers(const Container& a, const Container& b);
+    static uint32_t andCardinality(const Container& a, const Container& b);
+
+public:
+    void add(uint32_t value);
+    bool contains(uint32_t value) const;
+    uint64_t cardinality() const;
+    bool empty() const { return containers.empty(); }
+    void clear() { containers.clear(); }
+
+    static RoaringBitmap intersect(const RoaringBitmap& a, const RoaringBitmap& b);
+    static RoaringBitmap unite(const RoaringBitmap& a, const RoaringBitmap& b);
+    // |a AND b| без построения результата - для счетчиков фасетов
+    static uint64_t intersectCount(const RoaringBitmap& a, const RoaringBitmap& b);
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Container& container : containers) {
+            uint32_t high = static_cast<uint32_t>(container.key) << 16;
+            if (container.isBitmap()) {
+                for (size_t word = 0; word < BITMAP_WORDS; ++word) {
+                    uint64_t bits = container.bits[word];
+                    while (bits) {
+                        fn(high | static_cast<uint32_t>(word * 64 + __builtin_ctzll(bits)));
+                        bits &= bits - 1;
+                    }
+                }
+            } else {
+                for (uint16_t low : container.array) {
+                    fn(high | low);
+                }
+            }
+        }
+    }
+
+    std::vector<uint32_t> toVector() const;
+    size_t memoryUsage() const;
+};
+
+#endif // ROARING_BITMAP_HPP
@@ -0,0 +1,36 @@
+#ifndef SCREEN_RENDERER_HPP
+#define SCREEN_RENDERER_HPP
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+// Кадр собирается в back buffer, сравнивается с тем, что уже на экране,
+// и изменившиеся строки выводятся одной записью ANSI-последовательностей.
+class ScreenRenderer {
+private:
+    std::vector<std::string> frontBuffer;   // что сейчас на экране
+    std::ostringstream backBuffer;          // кадр, который собираем
+    bool fullRedraw = true;
+    int frontRows = 0;                      // размер терминала при выводе frontBuffer
+    int frontCols = 0;
+
+    static std::vector<std::string> splitLines(const std::string& text);
+    static std::string fitToWidth(const std::string& line, int width);
+    static void writeOut(const std::string& data);
+
+public:
+    ScreenRenderer();
+
+    void beginFrame();
+    std::ostream& frame();
+    void present();
+
+    // Очистить экран перед выводом мимо renderer (формы ввода)
+    void clear();
+    void invalidate();
+
+    static void getTerminalSize(int& rows, int& cols);
+};
+
+#endif // SCREEN_RENDERER_HPP
@@ -0,0 +1,102 @@
+#ifndef SYNC_ENGINE_HPP
+#define SYNC_ENGINE_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Repository.hpp"
+#include "ResultSet.hpp"
+#include "Catalog.hpp"
+
+// Запись об удаленной строке (таблица deleted_row, заполняется триггерами)
+struct DeletedRowData {
+    int idDeleted;
+    std::string tableName;
+    int rowId;      // первичный ключ; для game_s_platfo - idGame
+    int rowId2;     // game_s_platfo - idPlatform, review - idGame
+};
+
+template <>
+struct EntitySchema<DeletedRowData> {
+    static constexpr const char* table = "deleted_row";
+    static constexpr auto fields = std::make_tuple(
+        field("idDeleted", &DeletedRowData::idDeleted, FIELD_KEY | FIELD_GENERATED),
+        field("TableName", &DeletedRowData::tableName),
+        field("RowId", &DeletedRowData::rowId),
+        field("RowId2", &DeletedRowData::rowId2));
+};
+
+// Таблицы, за которыми следит SyncEngine, в порядке применения
+enum SyncTable {
+    SYNC_USER,
+    SYNC_CATEGORY,
+    SYNC_PLATFORM,
+    SYNC_GAME,
+    SYNC_GAME_PLATFORM,
+    SYNC_REVIEW,
+    SYNC_TABLE_COUNT
+};
+
+// Изменения, прочитанные из БД одним pull(): строки держит MYSQL_RES до apply()
+struct SyncBatch {
+    std::string serverTime;
+    bool pulled[SYNC_TABLE_COUNT] = {};
+    ResultSet changed[SYNC_TABLE_COUNT];        // для SYNC_REVIEW не используется
+    std::vector<DeletedRowData> removed;
+    std::vector<int> ratedGames;                // игры, чей рейтинг пересчитан
+    bool ratingsFull = false;                   // рейтинги всех игр (слишком много изменений)
+    ResultSet ratings;                          // (idGame, COUNT(*), SUM(Mark))
+    bool stale = false;                         // отметки старше хранения tombstone
+    size_t changedRows[SYNC_TABLE_COUNT] = {};
+    size_t removedRows[SYNC_TABLE_COUNT] = {};
+
+    bool touches(SyncTable table) const { return changedRows[table] + removedRows[table] > 0; }
+    bool empty() const;
+};
+
+// Инкрементальная синхронизация каталога: для каждой таблицы хранится отметка
+// времени сервера, до которой изменения уже применены. pull() читает только
+// строки с UpdatedDate после отметки и tombstone-записи deleted_row
+// (server/migrations/add_change_tracking.sql), apply() применяет их к Catalog.
+// Отметка таблицы сдвигается, только если ее запросы выполнились.
+class SyncEngine {
+private:
+    std::shared_ptr<DatabaseConnection> db;
+    std::shared_ptr<User> userMgr;
+    std::shared_ptr<Game> gameMgr;
+    std::shared_ptr<Platform> platformMgr;
+    std::shared_ptr<Review> reviewMgr;
+    Repository<DeletedRowData> tombstones;
+
+    std::string watermarks[SYNC_TABLE_COUNT];
+
+    static const char* tableName(SyncTable table);
+    static SyncTable tableOf(const std::string& name);
+
+public:
+    // Дольше этого tombstone-записи не хранятся - отставший клиент загружается заново
+    static const int TOMBSTONE_RETENTION_DAYS = 30;
+    // Больше игр с новыми отзывами - рейтинги пересчитываются целиком
+    static const size_t MAX_RATED_GAMES = 500;
+
+    SyncEngine(std::shared_ptr<DatabaseConnection> db, std::shared_ptr<User> user,
+               std::shared_ptr<Game> game, std::shared_ptr<Platform> platform,
+               std::shared_ptr<Review> review);
+
+    // Все таблицы с одной отметки (Catalog::load или снимок с диска)
+    void start(const std::string& serverTime);
+    bool isStarted() const { return !watermarks[SYNC_USER].empty(); }
+    const std::string& getWatermark(SyncTable table) const { return watermarks[table]; }
+    // Самая старая отметка: с нее безопасно догонять каталог, сохраненный на диск
+    std::string getLowWatermark() const;
+
+    // false - БД недоступна или отметки старше TOMBSTONE_RETENTION_DAYS (нужна полная загрузка).
+    // Время и изменения читаются с primary: отставание реплики не сдвигает отметки мимо строк
+    bool pull(SyncBatch& batch);
+    // Сначала удаления, потом upsert; сдвигает отметки таблиц, прочитанных в pull()
+    void apply(SyncBatch& batch, Catalog& catalog);
+    // Только сдвинуть отметки - для пустого пакета, без копии каталога
+    void advance(const SyncBatch& batch);
+};
+
+#endif // SYNC_ENGINE_HPP
@@ -0,0 +1,73 @@
+#ifndef TABLE_VIEW_HPP
+#define TABLE_VIEW_HPP
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include "ScreenRenderer.hpp"
+#include "TerminalInput.hpp"
+
+struct TableColumn {
+    std::string title;
+    int width;
+    std::string sortKey;   // колонка БД для ORDER BY, пусто - не сортируется
+};
+
+struct TableRow {
+    int id;
+    std::vector<std::string> cells;
+};
+
+// Откуда таблица берет строки: общее число и страница [offset, offset + limit)
+struct TableDataSource {
+    std::function<int()> countRows;
+    std::function<std::vector<TableRow>(int offset, int limit,
+                                        const std::string& sortKey, bool ascending)> fetchRows;
+};
+
+// Рисует только видимое окно строк, страницы подгружает лениво
+// и держит в LRU-кэше уже отформатированными.
+class TableView {
+private:
+    struct CachedPage {
+        std::vector<int> ids;
+        std::vector<std::string> lines;
+        std::list<int>::iterator lruPosition;
+    };
+
+    std::string title;
+    std::vector<TableColumn> columns;
+    TableDataSource source;
+    int pageSize;
+    size_t maxCachedPages;
+
+    int rowCount = 0;
+    int topRow = 0;
+    int cursor = 0;
+    int sortColumn = 0;
+    bool ascending = true;
+
+    std::unordered_map<int, CachedPage> pages;
+    std::list<int> lru;
+
+    const CachedPage& getPage(int pageIndex);
+    std::string formatRow(const TableRow& row) const;
+    std::string formatHeader() const;
+    void render(ScreenRenderer& screen, int visibleRows, bool selectable);
+    void changeSort(int direction);
+    void clearCache();
+
+public:
+    TableView(const std::string& title, std::vector<TableColumn> columns,
+              TableDataSource source, int pageSize = 100, size_t maxCachedPages = 8);
+
+    // ESC - выход (-1), Enter в режиме выбора - id строки под курсором
+    int show(ScreenRenderer& screen, TerminalInput& input, bool selectable = false);
+    void refresh();
+
+    static std::string padCell(const std::string& text, int width);
+};
+
+#endif // TABLE_VIEW_HPP
@@ -0,0 +1,83 @@
+#ifndef TERMINAL_INPUT_HPP
+#define TERMINAL_INPUT_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+#ifdef _WIN32
+    #include <conio.h>
+    #include <windows.h>
+#else
+    #include <unistd.h>
+    #include <termios.h>
+#endif
+
+enum class KeyCode {
+    NONE,        // таймаут, нет нажатия
+    CHAR,        // печатный символ (UTF-8 в KeyEvent::text)
+    ENTER,
+    ESCAPE,
+    BACKSPACE,
+    TAB,
+    UP,
+    DOWN,
+    LEFT,
+    RIGHT,
+    PAGE_UP,
+    PAGE_DOWN,
+    HOME,
+    END,
+    DELETE_KEY
+};
+
+struct KeyEvent {
+    KeyCode code = KeyCode::NONE;
+    std::string text;
+};
+
+// Raw mode включается один раз и держится, пока идет навигация по меню.
+// stdin и таймеры обслуживаются одним poll(), без busy-wait.
+class TerminalInput {
+private:
+    struct Timer {
+        int id;
+        std::chrono::milliseconds interval;
+        std::chrono::steady_clock::time_point due;
+        std::function<void()> callback;
+    };
+
+    bool rawMode = false;
+    bool endOfInput = false;
+    std::string pending;          // прочитанные, но еще не разобранные байты
+    std::vector<Timer> timers;
+    int nextTimerId = 1;
+
+    bool waitReadable(int timeoutMs);
+    bool fillPending(int timeoutMs);
+    bool parseKey(KeyEvent& key);
+    void fireDueTimers();
+    int msUntilNextTimer() const;
+
+public:
+    TerminalInput();
+    ~TerminalInput();
+
+    TerminalInput(const TerminalInput&) = delete;
+    TerminalInput& operator=(const TerminalInput&) = delete;
+
+    void enterRawMode();
+    void restoreMode();       // обычный режим для std::getline в формах
+    // Возвращает исходные настройки терминала, если raw mode включался. Безопасна
+    // в обработчике сигнала: вызывается перед завершением по Ctrl+C и из atexit
+    static void restoreTerminal();
+
+    int addTimer(int intervalMs, std::function<void()> callback);
+    void removeTimer(int timerId);
+
+    KeyEvent readKey();                 // ждет нажатия, обслуживая таймеры
+    KeyEvent readKey(int timeoutMs);    // KeyCode::NONE по таймауту
+};
+
+#endif // TERMINAL_INPUT_HPP
@@ -0,0 +1,111 @@
+#ifndef TRENDING_GAMES_HPP
+#define TRENDING_GAMES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+struct TrendingGame {
+    int gameId;
+    double score;           // отзывы с затуханием на момент now
+    double error;           // насколько score может быть завышен
+    double avgMark;         // средняя оценка с тем же затуханием; 0 - оценок нет
+};
+
+// Популярность игр по недавним отзывам в ограниченной памяти. Отзыв весит
+// 2^(-возраст / halfLife); веса считаются прямым затуханием (forward decay):
+// вес растет от опорного момента, поэтому счетчики только увеличиваются и
+// подходят для скетчей, а приведение к now - одно умножение при чтении.
+// Кандидаты в top-N - Space-Saving (общий, по категориям, по платформам),
+// их счет уточняется count-min sketch по играм и парам игра/платформа.
+class TrendingGames {
+public:
+    enum Scope { ALL, CATEGORY, PLATFORM };
+
+    static constexpr double DEFAULT_HALF_LIFE = 3 * 24 * 3600.0;
+    static constexpr size_t DEFAULT_CANDIDATES = 256;
+    static constexpr size_t SCOPED_CANDIDATES = 64;     // на категорию и на платформу
+    static constexpr uint32_t SKETCH_DEPTH = 4;
+    static constexpr uint32_t SKETCH_WIDTH_BITS = 12;   // 4096 счетчиков в строке
+
+private:
+    // Оценка сверху суммы весов по ключу: минимум по SKETCH_DEPTH строкам
+    class CountMinSketch {
+    private:
+        std::vector<double> cells;
+        size_t cell(uint32_t row, uint64_t key) const;
+
+    public:
+        CountMinSketch();
+        void add(uint64_t key, double weight);
+        double estimate(uint64_t key) const;
+        void scale(double factor);
+        void clear();
+        size_t memoryUsage() const { return cells.capacity() * sizeof(double); }
+    };
+
+    // Не больше capacity счетчиков; новый ключ вытесняет наименьший и наследует
+    // его счет как погрешность. Куча по count: корень - наименьший
+    class SpaceSaving {
+    public:
+        struct Counter {
+            int gameId;
+            double count;
+            double error;
+            double markSum;     // только за время наблюдения за ключом
+            double markWeight;
+        };
+
+    private:
+        size_t capacity;
+        std::vector<Counter> heap;
+        std::unordered_map<int, uint32_t> position;
+
+        void siftDown(uint32_t index);
+        void siftUp(uint32_t index);
+        void swapCounters(uint32_t a, uint32_t b);
+
+    public:
+        explicit SpaceSaving(size_t capacity) : capacity(capacity) {}
+        void add(int gameId, double weight, int mark);
+        void scale(double factor);
+        const std::vector<Counter>& counters() const { return heap; }
+        size_t memoryUsage() const;
+    };
+
+    double lambda;                  // ln 2 / halfLife
+    size_t candidates;
+    bool started = false;
+    int64_t landmark = 0;           // опорный момент весов, секунды UNIX
+    CountMinSketch sketch;
+    SpaceSaving all;
+    std::map<int, SpaceSaving> byCategory;
+    std::map<int, SpaceSaving> byPlatform;
+
+    // Перенос опорного момента, пока веса не переполнили double
+    void rebase(int64_t time);
+    double decayTo(int64_t now) const;
+    std::vector<TrendingGame> rank(const SpaceSaving& summary, bool perPlatform, int platformId,
+                                   size_t limit, int64_t now) const;
+
+public:
+    explicit TrendingGames(double halfLifeSeconds = DEFAULT_HALF_LIFE, size_t candidates = DEFAULT_CANDIDATES);
+
+    // time - секунды UNIX, порядок не важен; mark = 0 - отзыв без оценки
+    void add(int gameId, int categoryId, int platformId, int mark, int64_t time);
+    void clear();
+
+    // По убыванию score; scopeId - категория или платформа
+    std::vector<TrendingGame> top(Scope scope, int scopeId, size_t limit, int64_t now) const;
+    // Оценка score любой игры по скетчу (сверху)
+    double estimate(int gameId, int64_t now) const;
+    // Категории или платформы, по которым есть отзывы
+    std::vector<int> scopeIds(Scope scope) const;
+
+    size_t getCandidates() const { return candidates; }
+    size_t memoryUsage() const;
+};
+
+#endif // TRENDING_GAMES_HPP
@@ -4,7 +4,7 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include "DatabaseConnection.hpp"
+#include "Repository.hpp"
 
 struct UserData {
     int idUser;
@@ -14,12 +14,27 @@ struct UserData {
     bool isActive;
 };
 
+template <>
+struct EntitySchema<UserData> {
+    static constexpr const char* table = "user";
+    static constexpr auto fields = std::make_tuple(
+        field("idUser", &UserData::idUser, FIELD_KEY | FIELD_GENERATED),
+        field("Username", &UserData::username),
+        field("PasswordHash", &UserData::passwordHash, FIELD_PRIVATE),
+        field("Privilege", &UserData::privilege),
+        field("IsActive", &UserData::isActive, FIELD_GENERATED));
+};
+
 class User {
 private:
-    std::shared_ptr<DatabaseConnection> db;
+    Repository<UserData> repo;
 
 public:
     explicit User(std::shared_ptr<DatabaseConnection> database);
+    // Все записи менеджера публикуются в bus
+    void setEventBus(std::shared_ptr<EventBus> bus);
+    // Записи идут в транзакции вместе с событием в outbox_event
+    void setOutbox(bool enabled);
     
     // User CRUD operations
     bool addUser(const std::string& username, const std::string& passwordHash, 
@@ -32,6 +47,15 @@ public:
     std::vector<UserData> getAllUsers();
     UserData getUserById(int userId);
     UserData getUserByUsername(const std::string& username);
+    std::vector<UserData> getUsersByIds(const std::vector<int>& ids);
+    std::vector<UserData> getUsersPage(int offset, int limit, const std::string& orderBy,
+                                       bool ascending);
+    // Без копирования строк: колонки в порядке EntitySchema<UserData>
+    ResultSet scanAllUsers();
+    ResultSet scanUsersChangedSince(const std::string& since);
+    ResultSet scanUsersPage(int offset, int limit, const std::string& orderBy, bool ascending);
+    // Только idUser, Username - без хешей паролей
+    ResultSet scanUsernames();
     int getUserCount();
     
     // Utility operations
@@ -1,8 +1,17 @@
 ﻿#include "../headers/AdminPanel.hpp"
+#include "../headers/JsonExport.hpp"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <initializer_list>
+#include <unordered_map>
+#include <string_view>
+
+// Период фонового обновления статистики на главном экране
+static const int STATS_REFRESH_MS = 5000;
 
 AdminPanel::AdminPanel(std::shared_ptr<DatabaseConnection> connection,
                       std::shared_ptr<User> user,
@@ -13,77 +22,28 @@ AdminPanel::AdminPanel(std::shared_ptr<DatabaseConnection> connection,
     if (!db || !userMgr || !gameMgr || !reviewMgr || !platformMgr) {
         throw std::runtime_error("ERROR: Null pointers passed to AdminPanel constructor!");
     }
+    syncEngine = std::make_unique<SyncEngine>(db, userMgr, gameMgr, platformMgr, reviewMgr);
 }
 
-// ============= DISPLAY FUNCTIONS =============
-
-void AdminPanel::displayAvailableUsers() {
-    try {
-        std::vector<UserData> users = userMgr->getAllUsers();
-        if (users.empty()) {
-            std::cout << "[ℹ] No users in database!\n";
-            return;
-        }
-
-        std::cout << "\n════════════════════════════════════════════════════════\n";
-        std::cout << "          AVAILABLE USERS                               \n";
-        std::cout << "════════════════════════════════════════════════════════\n";
-        std::cout << std::left << std::setw(5) << "ID" << std::setw(20) << "Username" 
-                  << std::setw(15) << "Privilege" << "Status\n";
-        std::cout << "──────────────────────────────────────────────────────\n";
-
-        for (const auto& user : users) {
-            std::cout << std::left << std::setw(5) << user.idUser 
-                      << std::setw(20) << user.username 
-                      << std::setw(15) << user.privilege 
-                      << (user.isActive ? "Active ✓" : "Inactive ✗") << "\n";
-        }
-        std::cout << "\n";
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR displaying users: " << e.what() << "\n";
-    }
+AdminPanel::~AdminPanel() {
+    setEventBus(nullptr);
 }
 
-void AdminPanel::displayAvailableGames() {
-    try {
-        std::vector<GameData> games = gameMgr->getAllGames();
-        if (games.empty()) {
-            std::cout << "[ℹ] No games in database!\n";
-            return;
-        }
-
-        std::cout << "\n══════════════════════════════════════════════════════════════════════════════\n";
-        std::cout << "                        AVAILABLE GAMES                                      \n";
-        std::cout << "══════════════════════════════════════════════════════════════════════════════\n";
-        std::cout << std::left << std::setw(5) << "ID" << std::setw(25) << "Name" 
-                  << std::setw(10) << "Year" << std::setw(12) << "Category" 
-                  << std::setw(8) << "Image" << "Status\n";
-        std::cout << "────────────────────────────────────────────────────────────────────────────────\n";
-
-        for (const auto& game : games) {
-            std::string categoryName = "Unknown";
-            try {
-                CategoryData cat = gameMgr->getCategoryById(game.idCategory);
-                if (cat.idCategory > 0) {
-                    categoryName = cat.categoryName;
-                }
-            } catch (...) {}
-
-            std::string imageStatus = game.imageURL.empty() ? "No" : "Yes";
-
-            std::cout << std::left << std::setw(5) << game.idGame 
-                      << std::setw(25) << (game.name.length() > 24 ? game.name.substr(0, 21) + "..." : game.name)
-                      << std::setw(10) << game.releaseYear 
-                      << std::setw(12) << categoryName 
-                      << std::setw(8) << imageStatus
-                      << (game.isActive ? "Active ✓" : "Inactive ✗") << "\n";
+void AdminPanel::setEventBus(std::shared_ptr<EventBus> bus) {
+    if (events) {
+        for (int subscription : eventSubscriptions) {
+            events->unsubscribe(subscription);
         }
-        std::cout << "\n";
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR displaying games: " << e.what() << "\n";
+        eventSubscriptions.clear();
+    }
+    events = std::move(bus);
+    if (events) {
+        subscribeCatalogEvents();
     }
 }
 
+// ============= DISPLAY FUNCTIONS =============
+
 void AdminPanel::displayAvailablePlatforms() {
     try {
         std::vector<PlatformData> platforms = platformMgr->getAllPlatforms();
@@ -136,48 +96,125 @@ void AdminPanel::displayAvailableCategories() {
     }
 }
 
-// ============= VALIDATION FUNCTIONS =============
+// ============= TABLES =============
+
+TableView AdminPanel::makeUsersTable() {
+    TableDataSource source;
+    source.countRows = [this]() { return userMgr->getUserCount(); };
+    source.fetchRows = [this](int offset, int limit, const std::string& sortKey, bool ascending) {
+        using Users = Repository<UserData>;
+        static const unsigned int ID = Users::columnOf(&UserData::idUser);
+        static const unsigned int NAME = Users::columnOf(&UserData::username);
+        static const unsigned int PRIVILEGE = Users::columnOf(&UserData::privilege);
+        static const unsigned int ACTIVE = Users::columnOf(&UserData::isActive);
+
+        // Ячейки строятся прямо из буфера результата, без промежуточных UserData
+        std::vector<TableRow> rows;
+        for (const RowView& row : userMgr->scanUsersPage(offset, limit, sortKey, ascending)) {
+            rows.push_back({row.asInt(ID), {row.toString(ID), row.toString(NAME), row.toString(PRIVILEGE),
+                                            row.asBool(ACTIVE) ? "Active ✓" : "Inactive ✗"}});
+        }
+        return rows;
+    };
 
-bool AdminPanel::validateUserId(int userId) {
-    if (userId <= 0) return false;
-    try {
-        UserData user = userMgr->getUserById(userId);
-        return user.idUser > 0;
-    } catch (...) {
-        return false;
-    }
+    return TableView("ALL USERS",
+                     {{"ID", 7, "idUser"}, {"Username", 24, "Username"},
+                      {"Privilege", 12, "Privilege"}, {"Status", 12, "IsActive"}},
+                     source);
 }
 
-bool AdminPanel::validateGameId(int gameId) {
-    if (gameId <= 0) return false;
-    try {
-        GameData game = gameMgr->getGameById(gameId);
-        return game.idGame > 0;
-    } catch (...) {
-        return false;
+TableView AdminPanel::makeGamesTable() {
+    // Категорий мало - названия из каталога вместо getCategoryById на каждую строку
+    std::unordered_map<int, std::string> categoryNames;
+    CatalogStore::ReadGuard data = readCatalog();
+    for (uint32_t row = 0; row < data->getCategoryCount(); ++row) {
+        categoryNames[data->getCategories().id[row]] = std::string(data->categoryName(row));
     }
-}
 
-bool AdminPanel::validatePlatformId(int platformId) {
-    if (platformId <= 0) return false;
-    try {
-        PlatformData platform = platformMgr->getPlatformById(platformId);
-        return platform.idPlatform > 0;
-    } catch (...) {
-        return false;
-    }
+    TableDataSource source;
+    source.countRows = [this]() { return gameMgr->getGameCount(); };
+    source.fetchRows = [this, categoryNames](int offset, int limit, const std::string& sortKey,
+                                             bool ascending) {
+        using Games = Repository<GameData>;
+        static const unsigned int ID = Games::columnOf(&GameData::idGame);
+        static const unsigned int NAME = Games::columnOf(&GameData::name);
+        static const unsigned int YEAR = Games::columnOf(&GameData::releaseYear);
+        static const unsigned int CATEGORY = Games::columnOf(&GameData::idCategory);
+        static const unsigned int IMAGE = Games::columnOf(&GameData::imageURL);
+        static const unsigned int ACTIVE = Games::columnOf(&GameData::isActive);
+
+        // Description не копируется вообще - в таблице ее нет
+        std::vector<TableRow> rows;
+        for (const RowView& row : gameMgr->scanGamesPage(offset, limit, sortKey, ascending)) {
+            auto category = categoryNames.find(row.asInt(CATEGORY));
+            rows.push_back({row.asInt(ID), {row.toString(ID), row.toString(NAME), row.toString(YEAR),
+                                            category != categoryNames.end() ? category->second : "Unknown",
+                                            row.length(IMAGE) == 0 ? "No" : "Yes",
+                                            row.asBool(ACTIVE) ? "Active ✓" : "Inactive ✗"}});
+        }
+        return rows;
+    };
+
+    return TableView("ALL GAMES",
+                     {{"ID", 7, "idGame"}, {"Name", 26, "Name"}, {"Year", 7, "Release_year"},
+                      {"Category", 14, "idCategory"}, {"Image", 7, ""}, {"Status", 12, ""}},
+                     source);
 }
 
-bool AdminPanel::validateCategoryId(int categoryId) {
-    if (categoryId <= 0) return false;
-    try {
-        CategoryData category = gameMgr->getCategoryById(categoryId);
-        return category.idCategory > 0;
-    } catch (...) {
-        return false;
-    }
+TableView AdminPanel::makeReviewsTable(int gameId, const std::string& title) {
+    TableDataSource source;
+    source.countRows = [this, gameId]() { return reviewMgr->getGameReviewCount(gameId); };
+    source.fetchRows = [this, gameId](int offset, int limit, const std::string& sortKey,
+                                      bool ascending) {
+        using Reviews = Repository<ReviewData>;
+        static const unsigned int ID = Reviews::columnOf(&ReviewData::idReview);
+        static const unsigned int USER = Reviews::columnOf(&ReviewData::idUser);
+        static const unsigned int PLATFORM = Reviews::columnOf(&ReviewData::idPlatform);
+        static const unsigned int TEXT = Reviews::columnOf(&ReviewData::reviewText);
+        static const unsigned int MARK = Reviews::columnOf(&ReviewData::mark);
+
+        // Текст остается в буфере результата, пока грузятся имена
+        struct PageRow {
+            int idReview;
+            int idUser;
+            int idPlatform;
+            int mark;
+            std::string_view text;
+        };
+
+        ResultSet result = reviewMgr->scanGameReviewsPage(gameId, offset, limit, sortKey, ascending);
+        std::vector<PageRow> page;
+        page.reserve(static_cast<size_t>(result.getRowCount()));
+
+        // Имена пользователей и платформ - одним IN (...) на страницу, а не запрос на строку
+        EntityLoader loader(userMgr, gameMgr, platformMgr);
+        for (const RowView& row : result) {
+            page.push_back({row.asInt(ID), row.asInt(USER), row.asInt(PLATFORM), row.asInt(MARK),
+                            row.text(TEXT)});
+            loader.requestUser(page.back().idUser);
+            loader.requestPlatform(page.back().idPlatform);
+        }
+        loader.load();
+
+        std::vector<TableRow> rows;
+        rows.reserve(page.size());
+        for (const auto& review : page) {
+            rows.push_back({review.idReview, {std::to_string(review.idReview),
+                                              loader.userName(review.idUser),
+                                              loader.platformName(review.idPlatform),
+                                              std::to_string(review.mark), std::string(review.text)}});
+        }
+        return rows;
+    };
+
+    return TableView(title,
+                     {{"ID", 8, "idReview"}, {"User", 18, "idUser"}, {"Platform", 16, "idPlatform"},
+                      {"Mark", 6, "Mark"}, {"Review Text", 40, ""}},
+                     source);
 }
 
+// ============= VALIDATION FUNCTIONS =============
+
 bool AdminPanel::validateMarkRange(int mark) {
     return mark >= 1 && mark <= 10;
 }
@@ -189,70 +226,313 @@ bool AdminPanel::validateStringInput(const std::string& input, int minLen, int m
 
 // ============= USER INPUT FUNCTIONS =============
 
-int AdminPanel::getValidatedUserId() {
-    displayAvailableUsers();
-    int userId;
-    while (true) {
-        std::cout << "Enter user ID (from list above): ";
-        if (!(std::cin >> userId)) {
-            std::cin.clear();
-            std::cin.ignore(10000, '\n');
-            std::cerr << "✗ Invalid input! Please enter a number.\n";
-            continue;
+int AdminPanel::pickEntity(const FuzzyIndex& index, const std::string& title) {
+    // Выбор по имени из индекса в памяти: без вывода всей таблицы и проверки ID в БД
+    EntityPicker picker(index, title);
+    int id = picker.pick(screen, input);
+
+    clearScreen();
+    if (id > 0) {
+        std::cout << "[✓] " << title << ": ID " << id << "\n";
+    } else {
+        std::cout << "[ℹ] Cancelled.\n";
+    }
+    return id;
+}
+
+CatalogStore::ReadGuard AdminPanel::readCatalog() {
+    if (!catalogStore.hasSnapshot()) {
+        loadCatalog();
+    }
+    return catalogStore.read();
+}
+
+void AdminPanel::loadCatalog() {
+    // Теплый старт: отображаем снимок с диска и догоняем только изменения после него
+    if (catalogSyncEnabled && !catalogSnapshotPath.empty()) {
+        std::unique_ptr<Catalog> catalog = std::make_unique<Catalog>();
+        if (CatalogSnapshot::read(catalogSnapshotPath, *catalog)) {
+            syncEngine->start(catalog->getWatermark());
+            SyncBatch batch;
+            if (syncEngine->pull(batch)) {
+                syncEngine->apply(batch, *catalog);
+                catalogStore.publish(std::move(catalog));
+                return;
+            }
         }
-        
-        if (validateUserId(userId)) {
-            std::cout << "[✓] User ID valid!\n";
-            return userId;
-        } else {
-            std::cerr << "✗ ERROR: User ID " << userId << " does not exist!\n";
-            std::cout << "[↻] Please try again.\n\n";
+    }
+    if (reloadCatalog()) {
+        saveCatalogSnapshot();
+    }
+}
+
+bool AdminPanel::reloadCatalog() {
+    {
+        // Отметка NOW() и таблицы - с primary, иначе SyncEngine начнет с отметки новее данных реплики
+        DatabaseConnection::PrimaryReads primary(*db);
+        if (!catalogStore.reload(*userMgr, *gameMgr, *platformMgr, *reviewMgr)) {
+            return false;
         }
     }
+    syncEngine->start(catalogStore.read()->getWatermark());
+    resetSearchIndexes();
+    return true;
 }
 
-int AdminPanel::getValidatedGameId() {
-    displayAvailableGames();
-    int gameId;
-    while (true) {
-        std::cout << "Enter game ID (from list above): ";
-        if (!(std::cin >> gameId)) {
-            std::cin.clear();
-            std::cin.ignore(10000, '\n');
-            std::cerr << "✗ Invalid input! Please enter a number.\n";
-            continue;
+void AdminPanel::syncCatalog() {
+    // Снимка еще нет - его построит первое чтение
+    if (!catalogSyncEnabled || !catalogStore.hasSnapshot()) {
+        return;
+    }
+    SyncBatch batch;
+    if (!syncEngine->pull(batch)) {
+        if (batch.stale) {
+            reloadCatalog();
         }
-        
-        if (validateGameId(gameId)) {
-            std::cout << "[✓] Game ID valid!\n";
-            return gameId;
-        } else {
-            std::cerr << "✗ ERROR: Game ID " << gameId << " does not exist!\n";
-            std::cout << "[↻] Please try again.\n\n";
+        return;
+    }
+    if (batch.empty()) {
+        syncEngine->advance(batch);
+        return;
+    }
+    catalogStore.update([this, &batch](Catalog& catalog) {
+        syncEngine->apply(batch, catalog);
+        return true;
+    });
+
+    // Индексы поиска пересобираются только для изменившихся таблиц
+    if (batch.touches(SYNC_USER)) {
+        userIndex.reset();
+        usernameTrie.reset();
+    }
+    if (batch.touches(SYNC_GAME)) gameIndex.reset();
+    if (batch.touches(SYNC_GAME) || batch.touches(SYNC_REVIEW)) gameTitleTrie.reset();
+    if (batch.touches(SYNC_PLATFORM)) platformIndex.reset();
+    if (batch.touches(SYNC_CATEGORY)) categoryIndex.reset();
+
+    // Новые отзывы любого клиента (сайт, другие админки) - в детектор всплесков
+    if (batch.touches(SYNC_REVIEW)) {
+        pollReviewAnomalies();
+    }
+}
+
+void AdminPanel::resetSearchIndexes() {
+    userIndex.reset();
+    gameIndex.reset();
+    platformIndex.reset();
+    categoryIndex.reset();
+    usernameTrie.reset();
+    gameTitleTrie.reset();
+}
+
+void AdminPanel::saveCatalogSnapshot() {
+    if (catalogSnapshotPath.empty() || !catalogStore.hasSnapshot()) {
+        return;
+    }
+    CatalogStore::ReadGuard data = catalogStore.read();
+    std::string watermark = syncEngine->isStarted() ? syncEngine->getLowWatermark() : data->getWatermark();
+    if (!CatalogSnapshot::write(*data, catalogSnapshotPath, watermark)) {
+        std::cerr << "ERROR: Failed to save catalog snapshot to " << catalogSnapshotPath << "\n";
+    }
+}
+
+void AdminPanel::applyCatalogChange(const std::function<bool(Catalog&)>& change) {
+    // Снимка еще нет - первое чтение загрузит его уже с изменением
+    if (catalogStore.hasSnapshot() && !catalogStore.update(change)) {
+        reloadCatalog();
+    }
+}
+
+void AdminPanel::subscribeCatalogEvents() {
+    // Обработчики выполняются в потоке, который писал в БД (поток меню).
+    // Строки, которых еще нет в снимке, при удалении просто пропускаются.
+    eventSubscriptions.push_back(events->subscribe<UserData>([this](const ChangeEvent<UserData>& event) {
+        applyCatalogChange([&event](Catalog& catalog) {
+            if (event.after) {
+                const UserData& user = *event.after;
+                catalog.upsertUser(user.idUser, user.username, user.privilege, user.isActive);
+                catalog.buildIndexes();
+            } else {
+                catalog.removeUser(event.id);
+            }
+            return true;
+        });
+        userIndex.reset();
+        if (usernameTrie) {
+            if (event.after) {
+                usernameTrie->insert(event.after->idUser, event.after->username, 0);
+            } else {
+                usernameTrie->remove(event.id);
+            }
+        }
+    }));
+
+    eventSubscriptions.push_back(events->subscribe<CategoryData>([this](const ChangeEvent<CategoryData>& event) {
+        applyCatalogChange([&event](Catalog& catalog) {
+            if (event.after) {
+                const CategoryData& category = *event.after;
+                catalog.upsertCategory(category.idCategory, category.categoryName, category.description);
+                catalog.buildIndexes();
+            } else {
+                catalog.removeCategory(event.id);
+            }
+            return true;
+        });
+        categoryIndex.reset();
+        if (event.type == ChangeType::DELETED) {
+            gameIndex.reset();
+        }
+    }));
+
+    eventSubscriptions.push_back(events->subscribe<GameData>([this](const ChangeEvent<GameData>& event) {
+        applyCatalogChange([&event](Catalog& catalog) {
+            if (event.after) {
+                const GameData& game = *event.after;
+                catalog.upsertGame(game.idGame, game.name, game.description, game.releaseYear,
+                                   game.productionCost, game.idCategory, game.imageURL, game.isActive);
+                catalog.buildIndexes();
+            } else {
+                catalog.removeGame(event.id);
+            }
+            return true;
+        });
+        gameIndex.reset();
+        if (gameTitleTrie) {
+            if (event.after) {
+                gameTitleTrie->insert(event.after->idGame, event.after->name,
+                                      catalogReviewCount(event.after->idGame));
+            } else {
+                gameTitleTrie->remove(event.id);
+            }
+        }
+    }));
+
+    eventSubscriptions.push_back(events->subscribe<PlatformData>([this](const ChangeEvent<PlatformData>& event) {
+        applyCatalogChange([&event](Catalog& catalog) {
+            if (event.after) {
+                const PlatformData& platform = *event.after;
+                catalog.upsertPlatform(platform.idPlatform, platform.platformName, platform.type,
+                                       platform.description);
+                catalog.buildIndexes();
+            } else {
+                catalog.removePlatform(event.id);
+            }
+            return true;
+        });
+        platformIndex.reset();
+    }));
+
+    eventSubscriptions.push_back(events->subscribe<GamePlatformData>(
+        [this](const ChangeEvent<GamePlatformData>& event) {
+            applyCatalogChange([&event](Catalog& catalog) {
+                if (event.after) {
+                    const GamePlatformData& link = *event.after;
+                    catalog.upsertGamePlatform(link.idGame, link.idPlatform, link.releaseDate, link.price);
+                    catalog.buildIndexes();
+                } else {
+                    catalog.removeGamePlatform(event.id, event.id2);
+                }
+                return true;
+            });
+        }));
+
+    // Рейтинг игры - сумма и число оценок; отзыв меняет их на разницу
+    eventSubscriptions.push_back(events->subscribe<ReviewData>([this](const ChangeEvent<ReviewData>& event) {
+        applyCatalogChange([&event](Catalog& catalog) {
+            if (event.before) {
+                catalog.adjustGameRating(event.before->idGame, -1, -event.before->mark);
+            }
+            if (event.after) {
+                catalog.adjustGameRating(event.after->idGame, 1, event.after->mark);
+            }
+            return true;
+        });
+        if (gameTitleTrie) {
+            for (const ReviewData* review : {event.before ? &*event.before : nullptr,
+                                              event.after ? &*event.after : nullptr}) {
+                if (review) {
+                    gameTitleTrie->setScore(review->idGame, catalogReviewCount(review->idGame));
+                }
+            }
+        }
+    }));
+}
+
+int AdminPanel::getValidatedUserId() {
+    if (!userIndex) {
+        CatalogStore::ReadGuard data = readCatalog();
+        userIndex = std::make_unique<FuzzyIndex>();
+        for (uint32_t row = 0; row < data->getUserCount(); ++row) {
+            userIndex->add(data->getUsers().id[row], std::string(data->userName(row)));
+        }
+        userIndex->build();
+    }
+    return pickEntity(*userIndex, "Select user");
+}
+
+int AdminPanel::getValidatedGameId() {
+    if (!gameIndex) {
+        CatalogStore::ReadGuard data = readCatalog();
+        gameIndex = std::make_unique<FuzzyIndex>();
+        for (uint32_t row = 0; row < data->getGameCount(); ++row) {
+            gameIndex->add(data->getGames().id[row], std::string(data->gameName(row)));
         }
+        gameIndex->build();
     }
+    return pickEntity(*gameIndex, "Select game");
 }
 
 int AdminPanel::getValidatedPlatformId() {
-    displayAvailablePlatforms();
-    int platformId;
-    while (true) {
-        std::cout << "Enter platform ID (from list above): ";
-        if (!(std::cin >> platformId)) {
-            std::cin.clear();
-            std::cin.ignore(10000, '\n');
-            std::cerr << "✗ Invalid input! Please enter a number.\n";
-            continue;
+    if (!platformIndex) {
+        CatalogStore::ReadGuard data = readCatalog();
+        platformIndex = std::make_unique<FuzzyIndex>();
+        for (uint32_t row = 0; row < data->getPlatformCount(); ++row) {
+            platformIndex->add(data->getPlatforms().id[row], std::string(data->platformName(row)));
         }
-        
-        if (validatePlatformId(platformId)) {
-            std::cout << "[✓] Platform ID valid!\n";
-            return platformId;
-        } else {
-            std::cerr << "✗ ERROR: Platform ID " << platformId << " does not exist!\n";
-            std::cout << "[↻] Please try again.\n\n";
+        platformIndex->build();
+    }
+    return pickEntity(*platformIndex, "Select platform");
+}
+
+int AdminPanel::getValidatedCategoryId() {
+    if (!categoryIndex) {
+        CatalogStore::ReadGuard data = readCatalog();
+        categoryIndex = std::make_unique<FuzzyIndex>();
+        for (uint32_t row = 0; row < data->getCategoryCount(); ++row) {
+            categoryIndex->add(data->getCategories().id[row], std::string(data->categoryName(row)));
+        }
+        categoryIndex->build();
+    }
+    return pickEntity(*categoryIndex, "Select category");
+}
+
+NameTrie& AdminPanel::getUsernameTrie() {
+    if (!usernameTrie) {
+        CatalogStore::ReadGuard data = readCatalog();
+        usernameTrie = std::make_unique<NameTrie>();
+        for (uint32_t row = 0; row < data->getUserCount(); ++row) {
+            usernameTrie->insert(data->getUsers().id[row], std::string(data->userName(row)), 0);
+        }
+    }
+    return *usernameTrie;
+}
+
+NameTrie& AdminPanel::getGameTitleTrie() {
+    if (!gameTitleTrie) {
+        CatalogStore::ReadGuard data = readCatalog();
+        gameTitleTrie = std::make_unique<NameTrie>();
+        for (uint32_t row = 0; row < data->getGameCount(); ++row) {
+            gameTitleTrie->insert(data->getGames().id[row], std::string(data->gameName(row)),
+                                  data->getGames().reviewCount[row]);
         }
     }
+    return *gameTitleTrie;
+}
+
+uint32_t AdminPanel::catalogReviewCount(int gameId) {
+    CatalogStore::ReadGuard data = readCatalog();
+    uint32_t row = data->findGame(gameId);
+    return row == Catalog::NO_ROW ? 0 : data->getGames().reviewCount[row];
 }
 
 int AdminPanel::getValidatedMark() {
@@ -296,25 +576,27 @@ std::string AdminPanel::getValidatedText(const std::string& prompt, int minLen,
 
 std::string AdminPanel::getValidatedUsername() {
     std::string username;
+    CompletionPrompt prompt(getUsernameTrie(), "Add New User", "Enter username (3-50 characters)",
+                            "Username already exists!");
 
     while (true) {
-        std::cout << "Enter username (3-50 characters): ";
-        std::getline(std::cin, username);
+        prompt.read(screen, input, username);
 
         // Проверка длины
         if (!validateStringInput(username, 3, 50)) {
-            std::cerr << "✗ ERROR: Username must be 3-50 characters!\n";
-            std::cout << "[↻] Please try again.\n";
+            prompt.setMessage("✗ ERROR: Username must be 3-50 characters!");
             continue;
         }
 
-        // Проверка уникальности в БД
-        if (userMgr->userExists(username)) {
-            std::cerr << "✗ ERROR: Username '" << username << "' already exists!\n";
-            std::cout << "[↻] Please try again.\n";
+        // Проверка уникальности по каталогу; гонку с другим клиентом поймает UNIQUE при вставке
+        if (getUsernameTrie().contains(username)) {
+            prompt.setMessage("✗ ERROR: Username '" + username + "' already exists!");
             continue;
         }
 
+        clearScreen();
+        printHeader("Add New User");
+        std::cout << "Username: " << username << "\n";
         std::cout << "[✓] Username valid and available!\n";
         return username;
     }
@@ -341,45 +623,38 @@ std::string AdminPanel::getValidatedPassword() {
 // ============= SCREEN FUNCTIONS =============
 
 void AdminPanel::clearScreen() {
-    try {
-#ifdef _WIN32
-        system("cls");
-#else
-        system("clear");
-#endif
-    } catch (...) {}
-}
-
-void AdminPanel::printHeader(const std::string& title) {
-    std::cout << "\n════════════════════════════════════════════════\n";
-    std::cout << " " << std::left << std::setw(56) << title << "\n";
-    std::cout << "════════════════════════════════════════════════\n\n";
-}
-
-int AdminPanel::getKeyPress() {
-    #ifdef _WIN32
-        return _getch();
-    #else
-        struct termios oldSettings, newSettings;
-        tcgetattr(STDIN_FILENO, &oldSettings);
-        newSettings = oldSettings;
-        newSettings.c_lflag &= ~(ICANON | ECHO);
-        tcsetattr(STDIN_FILENO, TCSANOW, &newSettings);
-        
-        int ch = std::getchar();
-        
-        tcsetattr(STDIN_FILENO, TCSANOW, &oldSettings);
-        return ch;
-    #endif
+    // Формы читают строки через std::getline - нужен обычный режим терминала
+    input.restoreMode();
+    // ANSI вместо system("clear"): без запуска shell на каждое нажатие
+    screen.clear();
+}
+
+void AdminPanel::printHeader(const std::string& title, std::ostream& out) {
+    out << "\n════════════════════════════════════════════════\n";
+    out << " " << std::left << std::setw(56) << title << "\n";
+    out << "════════════════════════════════════════════════\n\n";
+}
+
+void AdminPanel::pause() {
+    std::cout << "\nPress Enter to continue...";
+    std::cout.flush();
+    std::string line;
+    std::getline(std::cin, line);
+}
+
+KeyEvent AdminPanel::getKeyPress() {
+    // Raw mode включается один раз и остается до следующей формы ввода
+    return input.readKey();
 }
 
 
-void AdminPanel::displayMenu(const std::vector<std::string>& options, int selected) {
+void AdminPanel::displayMenu(const std::vector<std::string>& options, int selected,
+                             std::ostream& out) {
     for (int i = 0; i < static_cast<int>(options.size()); ++i) {
         if (i == selected) {
-            std::cout << "▶ " << (i + 1) << ". " << options[i] << " ◀\n";
+            out << "▶ " << (i + 1) << ". " << options[i] << " ◀\n";
         } else {
-            std::cout << "  " << (i + 1) << ". " << options[i] << "\n";
+            out << "  " << (i + 1) << ". " << options[i] << "\n";
         }
     }
 }
@@ -387,63 +662,87 @@ void AdminPanel::displayMenu(const std::vector<std::string>& options, int select
 
 // ============= MAIN MENU =============
 
-void AdminPanel::run() {
-    int selectedOption = 0;
-
-    while (true) {
-        clearScreen();
-        printHeader("GAME RATING ADMIN PANEL");
-        
-        // Display statistics
-        try {
-            int gameCount = gameMgr->getGameCount();
-            int categoryCount = gameMgr->getCategoryCount();
-            int userCount = userMgr->getUserCount();
-            int platformCount = platformMgr->getPlatformCount();
-            
-            std::cout << "════════════════════════════════════════════════════════════\n";
-            std::cout << "                    STATISTICS                             \n";
-            std::cout << "════════════════════════════════════════════════════════════\n";
-            std::cout << "  Games: " << std::setw(47) << std::left << gameCount << "\n";
-            std::cout << "  Categories: " << std::setw(43) << std::left << categoryCount << "\n";
-            std::cout << "  Users: " << std::setw(48) << std::left << userCount << "\n";
-            std::cout << "  Platforms: " << std::setw(44) << std::left << platformCount << "\n";
-            std::cout << "════════════════════════════════════════════════════════════\n\n";
-        } catch (...) {
-            // Ignore errors in statistics
-        }
-
-        std::vector<std::string> mainMenuOptions = {
-            "User Management",
-            "Game Management",
-            "Platform Management",
-            "Review Management",
-            "Exit"
-        };
-
-        displayMenu(mainMenuOptions, selectedOption);
-        std::cout << "\n[↑/↓ Navigate] [Enter Select] [ESC Exit]\n";
-
+void AdminPanel::refreshStatistics() {
+    try {
+        stats.games = gameMgr->getGameCount();
+        stats.categories = gameMgr->getCategoryCount();
+        stats.users = userMgr->getUserCount();
+        stats.platforms = platformMgr->getPlatformCount();
+    } catch (...) {
+        // Ignore errors in statistics
+    }
+}
 
-        int key = getKeyPress();
+void AdminPanel::renderMainMenu(const std::vector<std::string>& options, int selected) {
+    screen.beginFrame();
+    std::ostream& out = screen.frame();
+    printHeader("GAME RATING ADMIN PANEL", out);
+
+    out << "════════════════════════════════════════════════════════════\n";
+    out << "                    STATISTICS                             \n";
+    out << "════════════════════════════════════════════════════════════\n";
+    out << "  Games: " << std::setw(47) << std::left << stats.games << "\n";
+    out << "  Categories: " << std::setw(43) << std::left << stats.categories << "\n";
+    out << "  Users: " << std::setw(48) << std::left << stats.users << "\n";
+    out << "  Platforms: " << std::setw(44) << std::left << stats.platforms << "\n";
+    out << "════════════════════════════════════════════════════════════\n\n";
+
+    displayMenu(options, selected, out);
+    out << "\n[↑/↓ Navigate] [Enter Select] [ESC Exit]\n";
+    screen.present();
+}
 
-        if (key == 27) {  // ESC
+void AdminPanel::run() {
+    int selectedOption = 0;
+    bool running = true;
+
+    std::vector<std::string> mainMenuOptions = {
+        "User Management",
+        "Game Management",
+        "Platform Management",
+        "Review Management",
+        "Export to JSON",
+        "Exit"
+    };
+
+    // Статистика обновляется по таймеру, пока меню ждет нажатия
+    refreshStatistics();
+    int refreshTimer = input.addTimer(STATS_REFRESH_MS, [&]() {
+        if (currentMenu != MAIN_MENU) return;
+        refreshStatistics();
+        syncCatalog();
+        renderMainMenu(mainMenuOptions, selectedOption);
+    });
+
+    while (running) {
+        renderMainMenu(mainMenuOptions, selectedOption);
+
+        KeyEvent key = getKeyPress();
+
+        if (key.code == KeyCode::ESCAPE) {
             break;
         }
 
-        if (key == 224) {  // Arrow keys (Windows)
-            key = getKeyPress();
-            if (key == 72) selectedOption--;     // Up
-            else if (key == 80) selectedOption++; // Down
-        } else if (key == 13) {  // Enter
+        if (key.code == KeyCode::UP) {
+            selectedOption--;
+        } else if (key.code == KeyCode::DOWN) {
+            selectedOption++;
+        } else if (key.code == KeyCode::HOME || key.code == KeyCode::PAGE_UP) {
+            selectedOption = 0;
+        } else if (key.code == KeyCode::END || key.code == KeyCode::PAGE_DOWN) {
+            selectedOption = mainMenuOptions.size() - 1;
+        } else if (key.code == KeyCode::ENTER) {
             switch (selectedOption) {
-                case 0: handleUserMenu(); break;
-                case 1: handleGameMenu(); break;
-                case 2: handlePlatformMenu(); break;
-                case 3: handleReviewMenu(); break;
-                case 4: return;
+                case 0: currentMenu = USER_MENU; handleUserMenu(); break;
+                case 1: currentMenu = GAME_MENU; handleGameMenu(); break;
+                case 2: currentMenu = PLATFORM_MENU; handlePlatformMenu(); break;
+                case 3: currentMenu = REVIEW_MENU; handleReviewMenu(); break;
+                case 4: exportJson(); break;
+                case 5: running = false; break;
                 default: break;
             }
+            currentMenu = MAIN_MENU;
+            refreshStatistics();
             selectedOption = 0;
         }
 
@@ -452,6 +751,14 @@ void AdminPanel::run() {
         if (selectedOption >= static_cast<int>(mainMenuOptions.size())) selectedOption = 0;
     }
 
+    input.removeTimer(refreshTimer);
+    input.restoreMode();
+    // Следующий запуск стартует с актуального снимка
+    saveCatalogSnapshot();
+    if (reviewCardinalityReady && !reviewCardinalityPath.empty() &&
+        !reviewCardinality.save(reviewCardinalityPath)) {
+        std::cerr << "ERROR: Failed to save review cardinality to " << reviewCardinalityPath << "\n";
+    }
     std::cout << "\n[✓] Goodbye!\n";
 }
 
@@ -461,8 +768,9 @@ void AdminPanel::handleUserMenu() {
     int selectedOption = 0;
 
     while (true) {
-        clearScreen();
-        printHeader("User Management");
+        screen.beginFrame();
+        std::ostream& out = screen.frame();
+        printHeader("User Management", out);
 
         std::vector<std::string> options = {
             "Show All Users",
@@ -472,20 +780,23 @@ void AdminPanel::handleUserMenu() {
             "Back to Main Menu"
         };
 
-        displayMenu(options, selectedOption);
-        std::cout << "\n[↑/↓ Navigate] [Enter Select] [ESC Back]\n";
+        displayMenu(options, selectedOption, out);
+        out << "\n[↑/↓ Navigate] [Enter Select] [ESC Back]\n";
+        screen.present();
 
-        int key = getKeyPress();
+        KeyEvent key = getKeyPress();
 
-        if (key == 27) {  // ESC
-            return;
-        }
+        if (key.code == KeyCode::ESCAPE) return;
 
-        if (key == 224) {  // Arrow keys
-            key = getKeyPress();
-            if (key == 72) selectedOption--;
-            else if (key == 80) selectedOption++;
-        } else if (key == 13) {  // Enter
+        if (key.code == KeyCode::UP) {
+            selectedOption--;
+        } else if (key.code == KeyCode::DOWN) {
+            selectedOption++;
+        } else if (key.code == KeyCode::HOME || key.code == KeyCode::PAGE_UP) {
+            selectedOption = 0;
+        } else if (key.code == KeyCode::END || key.code == KeyCode::PAGE_DOWN) {
+            selectedOption = options.size() - 1;
+        } else if (key.code == KeyCode::ENTER) {
             switch (selectedOption) {
                 case 0: showAllUsers(); break;
                 case 1: addNewUser(); break;
@@ -502,11 +813,8 @@ void AdminPanel::handleUserMenu() {
 }
 
 void AdminPanel::showAllUsers() {
-    clearScreen();
-    printHeader("All Users");
-    displayAvailableUsers();
-    std::cout << "Press any key to continue...";
-    std::getchar();
+    TableView table = makeUsersTable();
+    table.show(screen, input);
 }
 
 void AdminPanel::addNewUser() {
@@ -548,6 +856,7 @@ void AdminPanel::deleteUser() {
     printHeader("Delete User");
 
     int userId = getValidatedUserId();
+    if (userId < 0) return;
     
     if (userMgr->deleteUser(userId)) {
         std::cout << "\n[✓] User deleted successfully!\n";
@@ -564,6 +873,7 @@ void AdminPanel::updateUserPrivilege() {
     printHeader("Update User Privilege");
 
     int userId = getValidatedUserId();
+    if (userId < 0) return;
 
     std::string privilege;
     while (true) {
@@ -577,7 +887,7 @@ void AdminPanel::updateUserPrivilege() {
         }
     }
 
-    if (userMgr->updateUser(userId, "", privilege)) {
+    if (userMgr->updateUserPrivilege(userId, privilege)) {
         std::cout << "\n[✓] Privilege updated successfully!\n";
     } else {
         std::cerr << "\n✗ Failed to update privilege!\n";
@@ -593,8 +903,9 @@ void AdminPanel::handleGameMenu() {
     int selectedOption = 0;
 
     while (true) {
-        clearScreen();
-        printHeader("Game Management");
+        screen.beginFrame();
+        std::ostream& out = screen.frame();
+        printHeader("Game Management", out);
 
         std::vector<std::string> options = {
             "Show All Games",
@@ -602,28 +913,35 @@ void AdminPanel::handleGameMenu() {
             "Update Game",
             "Delete Game",
             "Manage Categories",
+            "Rebuild Game Summary",
             "Back to Main Menu"
         };
 
-        displayMenu(options, selectedOption);
-        std::cout << "\n[↑/↓ Navigate] [Enter Select] [ESC Back]\n";
+        displayMenu(options, selectedOption, out);
+        out << "\n[↑/↓ Navigate] [Enter Select] [ESC Back]\n";
+        screen.present();
 
-        int key = getKeyPress();
+        KeyEvent key = getKeyPress();
 
-        if (key == 27) return;
+        if (key.code == KeyCode::ESCAPE) return;
 
-        if (key == 224) {
-            key = getKeyPress();
-            if (key == 72) selectedOption--;
-            else if (key == 80) selectedOption++;
-        } else if (key == 13) {
+        if (key.code == KeyCode::UP) {
+            selectedOption--;
+        } else if (key.code == KeyCode::DOWN) {
+            selectedOption++;
+        } else if (key.code == KeyCode::HOME || key.code == KeyCode::PAGE_UP) {
+            selectedOption = 0;
+        } else if (key.code == KeyCode::END || key.code == KeyCode::PAGE_DOWN) {
+            selectedOption = options.size() - 1;
+        } else if (key.code == KeyCode::ENTER) {
             switch (selectedOption) {
                 case 0: showAllGames(); break;
                 case 1: addNewGame(); break;
                 case 2: updateGame(); break;
                 case 3: deleteGame(); break;
                 case 4: manageCategories(); break;
-                case 5: return;
+                case 5: rebuildGameSummary(); break;
+                case 6: return;
                 default: break;
             }
         }
@@ -634,20 +952,28 @@ void AdminPanel::handleGameMenu() {
 }
 
 void AdminPanel::showAllGames() {
-    clearScreen();
-    printHeader("All Games");
-    displayAvailableGames();
-    std::cout << "Press any key to continue...";
-    std::getchar();
+    TableView table = makeGamesTable();
+    table.show(screen, input);
 }
 
 void AdminPanel::addNewGame() {
     clearScreen();
     printHeader("Add New Game");
 
-    displayAvailableCategories();
-
-    std::string name = getValidatedText("Enter game name (3-255 chars): ", 3, 255);
+    // Подсказка существующих названий - чтобы не завести дубликат
+    std::string name;
+    CompletionPrompt prompt(getGameTitleTrie(), "Add New Game", "Enter game name (3-255 chars)",
+                            "A game with this name already exists");
+    while (true) {
+        prompt.read(screen, input, name);
+        if (validateStringInput(name, 3, 255)) {
+            break;
+        }
+        prompt.setMessage("✗ ERROR: Text must be 3-255 characters!");
+    }
+    clearScreen();
+    printHeader("Add New Game");
+    std::cout << "Game name: " << name << "\n";
 
     int releaseYear;
     while (true) {
@@ -694,6 +1020,7 @@ void AdminPanel::addNewGame() {
     }
 
     int categoryId = getValidatedCategoryId();
+    if (categoryId < 0) return;
 
     if (gameMgr->addGame(name, releaseYear, description, productionCost, categoryId, imageURL)) {
         std::cout << "\n[✓] Game added successfully!\n";
@@ -708,31 +1035,12 @@ void AdminPanel::addNewGame() {
     std::getchar();
 }
 
-int AdminPanel::getValidatedCategoryId() {
-    displayAvailableCategories();
-    int categoryId;
-    while (true) {
-        std::cout << "Enter category ID (from list above): ";
-        if (!(std::cin >> categoryId)) {
-            std::cin.clear();
-            std::cin.ignore(10000, '\n');
-            std::cerr << "✗ Invalid input!\n";
-            continue;
-        }
-        if (validateCategoryId(categoryId)) {
-            std::cout << "[✓] Category ID valid!\n";
-            return categoryId;
-        } else {
-            std::cerr << "✗ ERROR: Category ID does not exist!\n";
-        }
-    }
-}
-
 void AdminPanel::updateGame() {
     clearScreen();
     printHeader("Update Game");
 
     int gameId = getValidatedGameId();
+    if (gameId < 0) return;
     
     GameData currentGame = gameMgr->getGameById(gameId);
     if (currentGame.idGame <= 0) {
@@ -833,6 +1141,7 @@ void AdminPanel::deleteGame() {
     printHeader("Delete Game");
 
     int gameId = getValidatedGameId();
+    if (gameId < 0) return;
 
     if (gameMgr->deleteGame(gameId)) {
         std::cout << "\n[✓] Game deleted successfully!\n";
@@ -844,12 +1153,68 @@ void AdminPanel::deleteGame() {
     std::getchar();
 }
 
+void AdminPanel::rebuildGameSummary() {
+    clearScreen();
+    printHeader("Rebuild Game Summary");
+
+    if (!gameSummary) {
+        std::cout << "[ℹ] game_summary is disabled in config.json\n";
+        std::cout << "Press any key to continue...";
+        std::getchar();
+        return;
+    }
+
+    std::cout << "\n⚠ Recalculate game_summary for all games? (yes/no): ";
+    std::string confirmation;
+    std::getline(std::cin >> std::ws, confirmation);
+    if (confirmation == "yes" || confirmation == "YES") {
+        bool ok = gameSummary->rebuild(GameSummary::DEFAULT_CHUNK, [](int done, int total) {
+            std::cout << "\r[*] Chunk " << done << "/" << total << std::flush;
+        });
+        std::cout << "\n";
+        if (ok) {
+            std::cout << "\n[✓] Game summary rebuilt!\n";
+        } else {
+            std::cerr << "\n✗ Failed to rebuild game summary!\n";
+        }
+    } else {
+        std::cout << "[ℹ] Rebuild cancelled.\n";
+    }
+
+    std::cout << "Press any key to continue...";
+    std::getchar();
+}
+
+void AdminPanel::exportJson() {
+    clearScreen();
+    printHeader("Export to JSON");
+
+    if (exportPath.empty()) {
+        std::cout << "[ℹ] Export is disabled in config.json (features.enable_export)\n";
+        std::cout << "Press any key to continue...";
+        std::getchar();
+        return;
+    }
+
+    std::cout << "[*] Exporting users, categories, platforms, games and reviews to " << exportPath << "...\n";
+    size_t rows = 0;
+    if (JsonExport::write(exportPath, *userMgr, *gameMgr, *platformMgr, *reviewMgr, &rows)) {
+        std::cout << "\n[✓] Exported " << rows << " rows to " << exportPath << "\n";
+    } else {
+        std::cerr << "\n✗ Failed to export to " << exportPath << "!\n";
+    }
+
+    std::cout << "Press any key to continue...";
+    std::getchar();
+}
+
 void AdminPanel::manageCategories() {
     int selectedOption = 0;
 
     while (true) {
-        clearScreen();
-        printHeader("Manage Categories");
+        screen.beginFrame();
+        std::ostream& out = screen.frame();
+        printHeader("Manage Categories", out);
 
         std::vector<std::string> options = {
             "Show All Categories",
@@ -858,17 +1223,22 @@ void AdminPanel::manageCategories() {
             "Back"
         };
 
-        displayMenu(options, selectedOption);
+        displayMenu(options, selectedOption, out);
+        screen.present();
 
-        int key = getKeyPress();
+        KeyEvent key = getKeyPress();
 
-        if (key == 27) return;
+        if (key.code == KeyCode::ESCAPE) return;
 
-        if (key == 224) {
-            key = getKeyPress();
-            if (key == 72) selectedOption--;
-            else if (key == 80) selectedOption++;
-        } else if (key == 13) {
+        if (key.code == KeyCode::UP) {
+            selectedOption--;
+        } else if (key.code == KeyCode::DOWN) {
+            selectedOption++;
+        } else if (key.code == KeyCode::HOME || key.code == KeyCode::PAGE_UP) {
+            selectedOption = 0;
+        } else if (key.code == KeyCode::END || key.code == KeyCode::PAGE_DOWN) {
+            selectedOption = options.size() - 1;
+        } else if (key.code == KeyCode::ENTER) {
             switch (selectedOption) {
                 case 0: {
                     clearScreen();
@@ -897,6 +1267,7 @@ void AdminPanel::manageCategories() {
                     clearScreen();
                     printHeader("Delete Category");
                     int categoryId = getValidatedCategoryId();
+                    if (categoryId < 0) break;
                     if (gameMgr->deleteCategory(categoryId)) {
                         std::cout << "\n[✓] Category deleted!\n";
                     } else {
@@ -922,33 +1293,49 @@ void AdminPanel::handleReviewMenu() {
     int selectedOption = 0;
 
     while (true) {
-        clearScreen();
-        printHeader("Review Management");
+        screen.beginFrame();
+        std::ostream& out = screen.frame();
+        printHeader("Review Management", out);
 
         std::vector<std::string> options = {
             "Add Review",
             "View Game Reviews",
-            "Delete Game Reviews"
+            "Delete Game Reviews",
+            "Similar Games",
+            "Recommend Games for User",
+            "Rebuild Recommendations",
+            "Review Alerts",
+            "Distinct Reviewers",
             "Back to Main Menu"
         };
 
-        displayMenu(options, selectedOption);
-        std::cout << "\n[↑/↓ Navigate] [Enter Select] [ESC Back]\n";
+        displayMenu(options, selectedOption, out);
+        out << "\n[↑/↓ Navigate] [Enter Select] [ESC Back]\n";
+        screen.present();
 
-        int key = getKeyPress();
+        KeyEvent key = getKeyPress();
 
-        if (key == 27) return;
+        if (key.code == KeyCode::ESCAPE) return;
 
-        if (key == 224) {
-            key = getKeyPress();
-            if (key == 72) selectedOption--;
-            else if (key == 80) selectedOption++;
-        } else if (key == 13) {
+        if (key.code == KeyCode::UP) {
+            selectedOption--;
+        } else if (key.code == KeyCode::DOWN) {
+            selectedOption++;
+        } else if (key.code == KeyCode::HOME || key.code == KeyCode::PAGE_UP) {
+            selectedOption = 0;
+        } else if (key.code == KeyCode::END || key.code == KeyCode::PAGE_DOWN) {
+            selectedOption = options.size() - 1;
+        } else if (key.code == KeyCode::ENTER) {
             switch (selectedOption) {
                 case 0: addReview(); break;
                 case 1: viewGameReviews(); break;
                 case 2: deleteGameReviews(); break;
-                case 3: return;
+                case 3: showSimilarGames(); break;
+                case 4: showUserRecommendations(); break;
+                case 5: rebuildRecommendations(); break;
+                case 6: showReviewAnomalies(); break;
+                case 7: showDistinctReviewers(); break;
+                case 8: return;
                 default: break;
             }
         }
@@ -965,8 +1352,11 @@ void AdminPanel::addReview() {
     std::cout << "[ℹ] Select from lists below:\n\n";
 
     int userId = getValidatedUserId();
+    if (userId < 0) return;
     int gameId = getValidatedGameId();
+    if (gameId < 0) return;
     int platformId = getValidatedPlatformId();
+    if (platformId < 0) return;
     int mark = getValidatedMark();
     std::string reviewText = getValidatedText("Enter review text (1-500 chars): ", 1, 500);
 
@@ -986,73 +1376,22 @@ void AdminPanel::deleteGameReviews() {
 
     // Получаем ID игры
     int gameId = getValidatedGameId();
+    if (gameId < 0) return;
 
-    // Получаем все обзоры для этой игры
-    std::vector<ReviewData> reviews = reviewMgr->getGameReviews(gameId);
-
-    if (reviews.empty()) {
-        std::cout << "[ℹ] No reviews for this game.\n";
-    } else {
-        std::cout << "\n════════════════════════════════════════════════════════════════════\n";
-        std::cout << "              GAME REVIEWS                                          \n";
-        std::cout << "════════════════════════════════════════════════════════════════════\n";
-        std::cout << std::left << std::setw(5) << "ID" << std::setw(15) << "User ID" 
-                  << std::setw(8) << "Mark" << "Review Text\n";
-        std::cout << "────────────────────────────────────────────────────────────────────\n";
-
-        // Выводим все обзоры
-        for (const auto& review : reviews) {
-            std::string truncated = review.reviewText.length() > 40 
-                ? review.reviewText.substr(0, 37) + "..." 
-                : review.reviewText;
-            
-            std::cout << std::left << std::setw(5) << review.idReview 
-                      << std::setw(15) << review.idUser 
-                      << std::setw(8) << review.mark 
-                      << truncated << "\n";
-        }
-
-        // Получаем ID обзора для удаления
-        std::cout << "\n────────────────────────────────────────────────────────────────────\n";
-        int reviewId;
-        bool validReviewId = false;
-
-        while (!validReviewId) {
-            std::cout << "Enter review ID to delete (0 to cancel): ";
-            if (!(std::cin >> reviewId)) {
-                std::cin.clear();
-                std::cin.ignore(10000, '\n');
-                std::cerr << "✗ Invalid input! Please enter a number.\n";
-                continue;
-            }
-
-            // Проверка: 0 для отмены
-            if (reviewId == 0) {
-                std::cout << "[ℹ] Delete cancelled.\n";
-                system("pause");
-                return;
-            }
-
-            // Проверяем, существует ли обзор с таким ID и принадлежит ли он этой игре
-            bool reviewFound = false;
-            for (const auto& review : reviews) {
-                if (review.idReview == reviewId) {
-                    reviewFound = true;
-                    break;
-                }
-            }
+    // Обзор выбирается курсором в таблице, ID вводить не нужно
+    TableView table = makeReviewsTable(gameId, "DELETE GAME REVIEWS - select a review");
+    screen.invalidate();
 
-            if (reviewFound) {
-                validReviewId = true;
-                std::cout << "[✓] Review ID valid!\n";
-            } else {
-                std::cerr << "✗ ERROR: Review ID " << reviewId << " not found in this game!\n";
-                std::cout << "[↻] Please try again.\n\n";
-            }
+    while (true) {
+        int reviewId = table.show(screen, input, true);
+        if (reviewId < 0) {
+            return;
         }
 
         // Запрашиваем подтверждение перед удалением
-        std::cout << "\n⚠ WARNING: Are you sure you want to delete this review? (yes/no): ";
+        clearScreen();
+        std::cout << "\n⚠ WARNING: Are you sure you want to delete review #" << reviewId
+                  << "? (yes/no): ";
         std::string confirmation;
         std::getline(std::cin >> std::ws, confirmation);
 
@@ -1060,15 +1399,15 @@ void AdminPanel::deleteGameReviews() {
             // Удаляем обзор
             if (reviewMgr->deleteReview(reviewId)) {
                 std::cout << "\n[✓] Review deleted successfully!\n";
+                table.refresh();
             } else {
                 std::cerr << "\n✗ Failed to delete review!\n";
             }
         } else {
             std::cout << "[ℹ] Delete cancelled.\n";
         }
+        pause();
     }
-
-    system("pause");
 }
 
 
@@ -1077,32 +1416,263 @@ void AdminPanel::viewGameReviews() {
     printHeader("View Game Reviews");
 
     int gameId = getValidatedGameId();
+    if (gameId < 0) return;
+
+    TableView table = makeReviewsTable(gameId, "GAME REVIEWS");
+    screen.invalidate();
+    table.show(screen, input);
+}
+
+bool AdminPanel::ensureRecommendations() {
+    if (recommender.empty() && !recommendationsPath.empty()) {
+        recommender.load(recommendationsPath);
+    }
+    if (recommender.empty()) {
+        std::cout << "[ℹ] No recommendations yet. Run Review Management → Rebuild Recommendations.\n";
+        return false;
+    }
+    return true;
+}
+
+void AdminPanel::showSimilarGames() {
+    clearScreen();
+    printHeader("Similar Games");
+
+    int gameId = getValidatedGameId();
+    if (gameId >= 0 && ensureRecommendations()) {
+        std::vector<Recommendation> similar = recommender.similarGames(gameId, 20);
+        CatalogStore::ReadGuard data = readCatalog();
+        std::cout << "\n" << std::left << std::setw(8) << "ID" << std::setw(32) << "Game" << "Similarity\n";
+        std::cout << "──────────────────────────────────────────────────────\n";
+        for (const Recommendation& game : similar) {
+            std::cout << std::left << std::setw(8) << game.gameId
+                      << std::setw(32) << data->gameName(data->findGame(game.gameId)).substr(0, 31)
+                      << std::fixed << std::setprecision(3) << game.score << "\n";
+        }
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+        if (similar.empty()) {
+            std::cout << "[ℹ] Not enough common reviewers for this game.\n";
+        }
+    }
+
+    std::cout << "Press any key to continue...";
+    std::getchar();
+}
+
+void AdminPanel::showUserRecommendations() {
+    clearScreen();
+    printHeader("Recommend Games for User");
+
+    int userId = getValidatedUserId();
+    if (userId >= 0 && ensureRecommendations()) {
+        std::vector<std::pair<int, int>> marks;
+        for (const ReviewData& review : reviewMgr->getUserReviews(userId)) {
+            if (review.isActive) {
+                marks.emplace_back(review.idGame, review.mark);
+            }
+        }
+        std::vector<Recommendation> recommended = recommender.recommendForUser(marks, 20);
+        CatalogStore::ReadGuard data = readCatalog();
+        std::cout << "\n" << std::left << std::setw(8) << "ID" << std::setw(32) << "Game" << "Predicted mark\n";
+        std::cout << "──────────────────────────────────────────────────────\n";
+        for (const Recommendation& game : recommended) {
+            std::cout << std::left << std::setw(8) << game.gameId
+                      << std::setw(32) << data->gameName(data->findGame(game.gameId)).substr(0, 31)
+                      << std::fixed << std::setprecision(1) << game.score << "\n";
+        }
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+        if (recommended.empty()) {
+            std::cout << "[ℹ] The user has no reviews of games with known neighbors.\n";
+        }
+    }
+
+    std::cout << "Press any key to continue...";
+    std::getchar();
+}
+
+void AdminPanel::rebuildRecommendations() {
+    clearScreen();
+    printHeader("Rebuild Recommendations");
+
+    std::cout << "[*] Computing game similarities from reviews...\n";
+    auto started = std::chrono::steady_clock::now();
+    if (!recommender.build(reviewMgr->scanUserMarks(), recommendationNeighbors)) {
+        std::cerr << "\n✗ Failed to build recommendations!\n";
+    } else {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::cout << "[✓] " << recommender.getGameCount() << " games, " << recommender.getNeighborCount()
+                  << " neighbors in " << std::fixed << std::setprecision(2) << seconds << " s\n";
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+        if (!recommendationsPath.empty()) {
+            if (recommender.save(recommendationsPath)) {
+                std::cout << "[✓] Saved to " << recommendationsPath << "\n";
+            } else {
+                std::cerr << "✗ Failed to save " << recommendationsPath << "\n";
+            }
+        }
+    }
 
-    std::vector<ReviewData> reviews = reviewMgr->getGameReviews(gameId);
+    std::cout << "Press any key to continue...";
+    std::getchar();
+}
 
-    if (reviews.empty()) {
-        std::cout << "[ℹ] No reviews for this game.\n";
+void AdminPanel::showReviewAnomalies() {
+    clearScreen();
+    printHeader("Review Alerts");
+
+    if (!anomaliesBackfilled) {
+        std::cout << "[*] Scanning reviews of the last " << anomalyBackfillDays << " days...\n";
+        if (!anomalyDetector.backfill(reviewMgr->scanRecentMarks(anomalyBackfillDays))) {
+            std::cerr << "\n✗ Failed to scan reviews!\n";
+            std::cout << "Press any key to continue...";
+            std::getchar();
+            return;
+        }
+        anomaliesBackfilled = true;
     } else {
-        std::cout << "\n════════════════════════════════════════════════════════════════════\n";
-        std::cout << "              GAME REVIEWS                                          \n";
-        std::cout << "════════════════════════════════════════════════════════════════════\n";
-        std::cout << std::left << std::setw(5) << "ID" << std::setw(15) << "User ID" 
-                  << std::setw(8) << "Mark" << "Review Text\n";
-        std::cout << "────────────────────────────────────────────────────────────────────\n";
-
-        for (const auto& review : reviews) {
-            std::string truncated = review.reviewText.length() > 40 
-                ? review.reviewText.substr(0, 37) + "..." 
-                : review.reviewText;
-            
-            std::cout << std::left << std::setw(5) << review.idReview 
-                      << std::setw(15) << review.idUser 
-                      << std::setw(8) << review.mark 
-                      << truncated << "\n";
+        pollReviewAnomalies();
+    }
+
+    std::cout << "[ℹ] " << anomalyDetector.getObservedCount() << " reviews, "
+              << anomalyDetector.getGameCount() << " games, " << anomalyDetector.getPlatformCount()
+              << " platforms tracked (" << anomalyDetector.memoryUsage() / 1024 << " KB), buckets of "
+              << anomalyDetector.getSettings().bucketSeconds / 60 << " min\n\n";
+
+    std::vector<ReviewAnomaly> alerts = anomalyDetector.recentAlerts(20);
+    if (alerts.empty()) {
+        std::cout << "[✓] No anomalous review bursts.\n";
+        std::cout << "Press any key to continue...";
+        std::getchar();
+        return;
+    }
+
+    CatalogStore::ReadGuard data = readCatalog();
+    auto nameOf = [&data](const ReviewAnomaly& alert) {
+        std::string_view name = alert.scope == ReviewAnomaly::GAME ? data->gameName(data->findGame(alert.id))
+                                                                   : data->platformName(data->findPlatform(alert.id));
+        return name.empty() ? "#" + std::to_string(alert.id) : std::string(name.substr(0, 27));
+    };
+
+    std::cout << std::left << std::setw(13) << "Bucket" << std::setw(10) << "Scope" << std::setw(28) << "Name"
+              << std::setw(11) << "Signal" << std::setw(9) << "Reviews" << std::setw(10) << "Expected" << "Score\n";
+    std::cout << "────────────────────────────────────────────────────────────────────────────────────\n";
+    for (const ReviewAnomaly& alert : alerts) {
+        std::time_t started = static_cast<std::time_t>(alert.bucketStart);
+        std::ostringstream expected;
+        if (alert.kind == ReviewAnomaly::VOLUME) {
+            expected << std::fixed << std::setprecision(1) << alert.expected;
+        } else {
+            expected << static_cast<int>(alert.expected * 100 + 0.5) << "% low";
+        }
+        std::cout << std::left << std::put_time(std::localtime(&started), "%m-%d %H:%M  ")
+                  << std::setw(10) << (alert.scope == ReviewAnomaly::GAME ? "Game" : "Platform")
+                  << std::setw(28) << nameOf(alert)
+                  << std::setw(11) << (alert.kind == ReviewAnomaly::VOLUME ? "volume" : "low marks")
+                  << std::setw(9) << (alert.kind == ReviewAnomaly::VOLUME
+                                          ? std::to_string(alert.reviews)
+                                          : std::to_string(alert.lowMarks) + "/" + std::to_string(alert.reviews))
+                  << std::setw(10) << expected.str()
+                  << std::fixed << std::setprecision(1) << alert.zScore << "\n";
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+
+    // Распределение оценок в окне у последней тревоги
+    const ReviewAnomaly& latest = alerts.front();
+    ReviewAnomalyDetector::WindowStats window =
+        anomalyDetector.window(latest.scope, latest.id, static_cast<int64_t>(std::time(nullptr)));
+    std::cout << "\nMarks of " << nameOf(latest) << " over the last " << ReviewAnomalyDetector::WINDOW_BUCKETS
+              << " buckets (" << window.reviews << " reviews):\n";
+    for (int mark = 1; mark <= ReviewAnomalyDetector::MAX_MARK; ++mark) {
+        uint32_t count = window.marks[mark - 1];
+        size_t bar = window.reviews ? static_cast<size_t>(40.0 * count / window.reviews + 0.5) : 0;
+        std::cout << std::right << std::setw(3) << mark << " │" << std::string(bar, '#') << " " << count << "\n";
+    }
+    std::cout << std::left;
+
+    std::cout << "Press any key to continue...";
+    std::getchar();
+}
+
+void AdminPanel::pollReviewAnomalies() {
+    // До первого открытия Review Alerts детектор пуст: новые отзывы войдут в backfill
+    if (!anomaliesBackfilled) {
+        return;
+    }
+    anomalyDetector.apply(reviewMgr->scanMarksSince(anomalyDetector.getLastReviewId()));
+}
+
+bool AdminPanel::ensureReviewCardinality() {
+    // Файл читается один раз, новые отзывы (в том числе с сайта) догружаются при каждом открытии
+    if (!reviewCardinalityReady) {
+        if (!reviewCardinalityPath.empty()) {
+            reviewCardinality.load(reviewCardinalityPath);
+        }
+        std::cout << "[*] Reading reviews after #" << reviewCardinality.getLastReviewId() << "...\n";
+    }
+    if (!reviewCardinality.apply(reviewMgr->scanReviewAudienceSince(reviewCardinality.getLastReviewId()))) {
+        std::cerr << "\n✗ Failed to read reviews!\n";
+        return false;
+    }
+    reviewCardinalityReady = true;
+    return true;
+}
+
+void AdminPanel::showDistinctReviewers() {
+    clearScreen();
+    printHeader("Distinct Reviewers");
+
+    std::cout << "Scope: [1] All reviews  [2] Game  [3] Platform  [4] Category  [ESC] Back\n";
+    ReviewCardinality::Dimension dimension = ReviewCardinality::ALL;
+    while (true) {
+        KeyEvent key = getKeyPress();
+        if (key.code == KeyCode::ESCAPE) return;
+        if (key.text == "1") { dimension = ReviewCardinality::ALL; break; }
+        if (key.text == "2") { dimension = ReviewCardinality::GAME; break; }
+        if (key.text == "3") { dimension = ReviewCardinality::PLATFORM; break; }
+        if (key.text == "4") { dimension = ReviewCardinality::CATEGORY; break; }
+    }
+
+    int id = 0;
+    std::string scopeName = "All reviews";
+    if (dimension != ReviewCardinality::ALL) {
+        id = dimension == ReviewCardinality::GAME ? getValidatedGameId()
+             : dimension == ReviewCardinality::PLATFORM ? getValidatedPlatformId()
+                                                        : getValidatedCategoryId();
+        if (id < 0) return;
+        CatalogStore::ReadGuard data = readCatalog();
+        scopeName = std::string(dimension == ReviewCardinality::GAME ? data->gameName(data->findGame(id))
+                                : dimension == ReviewCardinality::PLATFORM ? data->platformName(data->findPlatform(id))
+                                                                           : data->categoryName(data->findCategory(id)));
+    }
+
+    if (ensureReviewCardinality()) {
+        // Сутки UTC, как в скетчах
+        std::time_t now = std::time(nullptr);
+        int64_t today = ReviewCardinality::dayOf(static_cast<int64_t>(now));
+        int64_t monthStart = today - (std::gmtime(&now)->tm_mday - 1);
+        const std::vector<std::pair<std::string, int64_t>> periods = {
+            {"Today", today}, {"Last 7 days", today - 6}, {"Last 30 days", today - 29},
+            {"This month", monthStart}, {"All time", 0}};
+
+        std::cout << "\n" << scopeName << " (estimates, ±2%)\n\n";
+        std::cout << std::left << std::setw(16) << "Period" << std::setw(14) << "Reviewers" << "Games\n";
+        std::cout << "──────────────────────────────────────────\n";
+        for (const auto& period : periods) {
+            ReviewCardinality::Estimate estimate = reviewCardinality.count(dimension, id, period.second, today);
+            std::cout << std::left << std::setw(16) << period.first << std::setw(14) << estimate.reviewers
+                      << (dimension == ReviewCardinality::GAME ? std::string("-") : std::to_string(estimate.games))
+                      << "\n";
         }
+        std::cout << "\n[ℹ] " << reviewCardinality.getCellCount() << " daily sketches, "
+                  << reviewCardinality.memoryUsage() / 1024 << " KB\n";
     }
 
-    system("pause");
+    std::cout << "Press any key to continue...";
+    std::getchar();
 }
 
 // ============= PLATFORM MENU =============
@@ -1111,33 +1681,41 @@ void AdminPanel::handlePlatformMenu() {
     int selectedOption = 0;
 
     while (true) {
-        clearScreen();
-        printHeader("Platform Management");
+        screen.beginFrame();
+        std::ostream& out = screen.frame();
+        printHeader("Platform Management", out);
 
         std::vector<std::string> options = {
             "Show All Platforms",
             "Add New Platform",
             "Delete Platform",
+            "Cross-platform Prices",
             "Back to Main Menu"
         };
 
-        displayMenu(options, selectedOption);
-        std::cout << "\n[↑/↓ Navigate] [Enter Select] [ESC Back]\n";
+        displayMenu(options, selectedOption, out);
+        out << "\n[↑/↓ Navigate] [Enter Select] [ESC Back]\n";
+        screen.present();
 
-        int key = getKeyPress();
+        KeyEvent key = getKeyPress();
 
-        if (key == 27) return;
+        if (key.code == KeyCode::ESCAPE) return;
 
-        if (key == 224) {
-            key = getKeyPress();
-            if (key == 72) selectedOption--;
-            else if (key == 80) selectedOption++;
-        } else if (key == 13) {
+        if (key.code == KeyCode::UP) {
+            selectedOption--;
+        } else if (key.code == KeyCode::DOWN) {
+            selectedOption++;
+        } else if (key.code == KeyCode::HOME || key.code == KeyCode::PAGE_UP) {
+            selectedOption = 0;
+        } else if (key.code == KeyCode::END || key.code == KeyCode::PAGE_DOWN) {
+            selectedOption = options.size() - 1;
+        } else if (key.code == KeyCode::ENTER) {
             switch (selectedOption) {
                 case 0: showAllPlatforms(); break;
                 case 1: addNewPlatform(); break;
                 case 2: deletePlatform(); break;
-                case 3: return;
+                case 3: showCrossPlatformPrices(); break;
+                case 4: return;
                 default: break;
             }
         }
@@ -1178,6 +1756,7 @@ void AdminPanel::deletePlatform() {
     printHeader("Delete Platform");
 
     int platformId = getValidatedPlatformId();
+    if (platformId < 0) return;
 
     if (platformMgr->deletePlatform(platformId)) {
         std::cout << "\n[✓] Platform deleted successfully!\n";
@@ -1185,6 +1764,67 @@ void AdminPanel::deletePlatform() {
         std::cerr << "\n✗ Failed to delete platform!\n";
     }
 
+    std::cout << "Press any key to continue...";
+    std::getchar();
+}
+
+void AdminPanel::showCrossPlatformPrices() {
+    clearScreen();
+    printHeader("Cross-platform Prices");
+
+    // Платформы по одной, пока не отменят выбор
+    std::vector<int> platformIds;
+    while (true) {
+        int platformId = getValidatedPlatformId();
+        if (platformId < 0) break;
+        if (std::find(platformIds.begin(), platformIds.end(), platformId) == platformIds.end()) {
+            platformIds.push_back(platformId);
+        }
+        std::cout << "[ℹ] Selected " << platformIds.size() << " platform(s). Add another? (y/n): ";
+        std::string answer;
+        std::getline(std::cin, answer);
+        if (answer != "y" && answer != "Y") break;
+    }
+    if (platformIds.empty()) return;
+
+    double maxPrice = -1;
+    std::string priceInput;
+    std::cout << "Max price on each platform (Enter - no limit): ";
+    std::getline(std::cin, priceInput);
+    if (!priceInput.empty()) {
+        try {
+            maxPrice = std::stod(priceInput);
+        } catch (...) {
+            std::cerr << "✗ Invalid price! Showing all prices.\n";
+        }
+    }
+
+    CatalogStore::ReadGuard data = readCatalog();
+    std::vector<int> gameIds = data->gamesOnAllPlatforms(platformIds, maxPrice);
+
+    clearScreen();
+    printHeader("Cross-platform Prices");
+    std::cout << std::left << std::setw(28) << "Game";
+    for (int platformId : platformIds) {
+        std::string name(data->platformName(data->findPlatform(platformId)));
+        std::cout << std::setw(14) << name.substr(0, 13);
+    }
+    std::cout << "\n──────────────────────────────────────────────────────\n";
+
+    const GamePlatformColumns& links = data->getGamePlatforms();
+    std::cout << std::fixed << std::setprecision(2);
+    for (int gameId : gameIds) {
+        std::string name(data->gameName(data->findGame(gameId)));
+        std::cout << std::left << std::setw(28) << name.substr(0, 27);
+        for (int platformId : platformIds) {
+            std::cout << std::setw(14) << links.price[data->findGamePlatform(gameId, platformId)];
+        }
+        std::cout << "\n";
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+    std::cout << "\n[ℹ] Games on all selected platforms: " << gameIds.size() << "\n";
+
     std::cout << "Press any key to continue...";
     std::getchar();
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "../headers/AuditLog.hpp"
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "../headers/User.hpp"
+#include "../headers/Game.hpp"
+#include "../headers/Platform.hpp"
+#include "../headers/Review.hpp"
+
+namespace {
+
+template <typename T>
+std::string formatValue(const T& value) {
+    std::ostringstream text;
+    text << value;
+    return text.str();
+}
+
+std::string formatValue(const std::string& value) {
+    return "'" + value + "'";
+}
+
+}
+
+AuditLog::AuditLog(std::shared_ptr<EventBus> eventBus, const std::string& path)
+    : bus(std::move(eventBus)), out(path, std::ios::app) {
+    if (!bus) {
+        throw std::runtime_error("ERROR: Null pointers passed to AuditLog constructor!");
+    }
+    if (!out.is_open()) {
+        std::cerr << "ERROR in AuditLog: cannot open " << path << "\n";
+        return;
+    }
+    worker = std::thread(&AuditLog::run, this);
+    track<UserData>();
+    track<CategoryData>();
+    track<GameData>();
+    track<PlatformData>();
+    track<GamePlatformData>();
+    track<ReviewData>();
+}
+
+AuditLog::~AuditLog() {
+    for (int subscription : subscriptions) {
+        bus->unsubscribe(subscription);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+template <typename Entity>
+void AuditLog::track() {
+    subscriptions.push_back(bus->subscribe<Entity>([this](const ChangeEvent<Entity>& event) {
+        std::time_t now = std::time(nullptr);
+        std::ostringstream line;
+        line << std::put_time(std::localtime(&now), "%Y-%m-%d %H:%M:%S") << " #" << event.sequence << " "
+             << EntitySchema<Entity>::table << " " << changeTypeName(event.type) << " " << event.id;
+        if (event.id2 != 0) {
+            line << "/" << event.id2;
+        }
+
+        // INSERTED - все поля, DELETED - последние значения, UPDATED - только разница
+        std::apply([&](const auto&... fields) {
+            auto describe = [&](const auto& f) {
+                const auto* before = event.before ? &((*event.before).*(f.member)) : nullptr;
+                const auto* after = event.after ? &((*event.after).*(f.member)) : nullptr;
+                if ((!before && !after) || (before && after && *before == *after)) {
+                    return;
+                }
+                line << " " << f.column << "=";
+                if (f.flags & FIELD_PRIVATE) {
+                    line << "***";
+                } else if (before && after) {
+                    line << formatValue(*before) << "->" << formatValue(*after);
+                } else {
+                    line << formatValue(before ? *before : *after);
+                }
+            };
+            (describe(fields), ...);
+        }, EntitySchema<Entity>::fields);
+
+        enqueue(line.str());
+    }));
+}
+
+void AuditLog::enqueue(std::string line) {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(std::move(line));
+    if (pending.size() == 1) {
+        wakeup.notify_one();
+    }
+}
+
+void AuditLog::run() {
+    std::vector<std::string> batch;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeup.wait(lock, [this]() { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            break;
+        }
+        batch.swap(pending);
+
+        lock.unlock();
+        for (const std::string& line : batch) {
+            out << line << "\n";
+        }
+        out.flush();
+        batch.clear();
+        lock.lock();
+    }
+}
@@ -0,0 +1,642 @@
+#include "../headers/Catalog.hpp"
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+
+bool Catalog::load(User& userMgr, Game& gameMgr, Platform& platformMgr, Review& reviewMgr) {
+    try {
+        clear();
+
+        // Время сервера до чтения таблиц: все, что изменится во время загрузки, догонит SyncEngine
+        watermark = gameMgr.getServerTime();
+
+        applyUsers(userMgr.scanAllUsers());
+        applyCategories(gameMgr.scanAllCategories());
+        applyGames(gameMgr.scanAllGames());
+        applyPlatforms(platformMgr.scanAllPlatforms());
+        applyGamePlatforms(platformMgr.scanAllGamePlatforms());
+        buildIndexes();
+        applyRatings(reviewMgr.scanRatingsByGame());
+
+        return getUserCount() + getGameCount() + getPlatformCount() + getCategoryCount() > 0;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in Catalog::load: " << e.what() << "\n";
+        clear();
+        return false;
+    }
+}
+
+// ============= Пакетные upsert =============
+// Новые ID добавляются, известные обновляются на месте.
+// Старые строки остаются в арене до следующей полной загрузки.
+
+void Catalog::applyUsers(ResultSet userRows) {
+    using Users = Repository<UserData>;
+    const unsigned int USER_ID = Users::columnOf(&UserData::idUser);
+    const unsigned int USER_NAME = Users::columnOf(&UserData::username);
+    const unsigned int USER_PRIVILEGE = Users::columnOf(&UserData::privilege);
+    const unsigned int USER_ACTIVE = Users::columnOf(&UserData::isActive);
+
+    users.id.reserve(users.id.size() + static_cast<size_t>(userRows.getRowCount()));
+    buildIdOrder(users.id, usersById);
+    for (const RowView& row : userRows) {
+        upsertUser(row.asInt(USER_ID), row.text(USER_NAME), row.text(USER_PRIVILEGE), row.asBool(USER_ACTIVE));
+    }
+    buildIdOrder(users.id, usersById);
+}
+
+void Catalog::applyCategories(ResultSet categoryRows) {
+    using Categories = Repository<CategoryData>;
+    const unsigned int CATEGORY_ID = Categories::columnOf(&CategoryData::idCategory);
+    const unsigned int CATEGORY_NAME = Categories::columnOf(&CategoryData::categoryName);
+    const unsigned int CATEGORY_DESC = Categories::columnOf(&CategoryData::description);
+
+    buildIdOrder(categories.id, categoriesById);
+    for (const RowView& row : categoryRows) {
+        upsertCategory(row.asInt(CATEGORY_ID), row.text(CATEGORY_NAME), row.text(CATEGORY_DESC));
+    }
+    buildIdOrder(categories.id, categoriesById);
+}
+
+void Catalog::applyGames(ResultSet gameRows) {
+    using Games = Repository<GameData>;
+    const unsigned int GAME_ID = Games::columnOf(&GameData::idGame);
+    const unsigned int GAME_NAME = Games::columnOf(&GameData::name);
+    const unsigned int GAME_DESC = Games::columnOf(&GameData::description);
+    const unsigned int GAME_YEAR = Games::columnOf(&GameData::releaseYear);
+    const unsigned int GAME_COST = Games::columnOf(&GameData::productionCost);
+    const unsigned int GAME_CATEGORY = Games::columnOf(&GameData::idCategory);
+    const unsigned int GAME_IMAGE = Games::columnOf(&GameData::imageURL);
+    const unsigned int GAME_ACTIVE = Games::columnOf(&GameData::isActive);
+
+    games.id.reserve(games.id.size() + static_cast<size_t>(gameRows.getRowCount()));
+    buildIdOrder(games.id, gamesById);
+    for (const RowView& row : gameRows) {
+        upsertGame(row.asInt(GAME_ID), row.text(GAME_NAME), row.text(GAME_DESC), row.asInt(GAME_YEAR),
+                   row.asDouble(GAME_COST), row.asInt(GAME_CATEGORY), row.text(GAME_IMAGE),
+                   row.asBool(GAME_ACTIVE));
+    }
+    buildIdOrder(games.id, gamesById);
+}
+
+void Catalog::applyPlatforms(ResultSet platformRows) {
+    using Platforms = Repository<PlatformData>;
+    const unsigned int PLATFORM_ID = Platforms::columnOf(&PlatformData::idPlatform);
+    const unsigned int PLATFORM_NAME = Platforms::columnOf(&PlatformData::platformName);
+    const unsigned int PLATFORM_TYPE = Platforms::columnOf(&PlatformData::type);
+    const unsigned int PLATFORM_DESC = Platforms::columnOf(&PlatformData::description);
+
+    buildIdOrder(platforms.id, platformsById);
+    for (const RowView& row : platformRows) {
+        upsertPlatform(row.asInt(PLATFORM_ID), row.text(PLATFORM_NAME), row.text(PLATFORM_TYPE),
+                       row.text(PLATFORM_DESC));
+    }
+    buildIdOrder(platforms.id, platformsById);
+}
+
+void Catalog::applyGamePlatforms(ResultSet linkRows) {
+    using Links = Repository<GamePlatformData>;
+    const unsigned int LINK_GAME = Links::columnOf(&GamePlatformData::idGame);
+    const unsigned int LINK_PLATFORM = Links::columnOf(&GamePlatformData::idPlatform);
+    const unsigned int LINK_DATE = Links::columnOf(&GamePlatformData::releaseDate);
+    const unsigned int LINK_PRICE = Links::columnOf(&GamePlatformData::price);
+
+    if (!gamePlatforms.game.empty()) {
+        buildIndexes();
+    }
+    for (const RowView& row : linkRows) {
+        upsertGamePlatform(row.asInt(LINK_GAME), row.asInt(LINK_PLATFORM), row.text(LINK_DATE),
+                           row.asDouble(LINK_PRICE));
+    }
+}
+
+// Строки (idGame, COUNT(*), SUM(Mark)); индексы уже построены
+void Catalog::applyRatings(ResultSet ratingRows) {
+    for (const RowView& row : ratingRows) {
+        setGameRating(row.asInt(0), static_cast<uint32_t>(row.asInt(1)), static_cast<uint32_t>(row.asInt(2)));
+    }
+}
+
+void Catalog::clear() {
+    strings.clear();
+    privileges.clear();
+    categoryNames.clear();
+    platformTypes.clear();
+    watermark.clear();
+    backing.reset();
+    users = UserColumns();
+    categories = CategoryColumns();
+    games = GameColumns();
+    platforms = PlatformColumns();
+    gamePlatforms = GamePlatformColumns();
+    usersById.clear();
+    categoriesById.clear();
+    gamesById.clear();
+    platformsById.clear();
+    linkGames.clear();
+    linkGameOffsets.clear();
+    linksByGame.clear();
+    linkPlatforms.clear();
+    linkPlatformOffsets.clear();
+    linksByPlatform.clear();
+    platformGames.clear();
+}
+
+void Catalog::addUser(int id, std::string_view name, std::string_view privilege, bool active) {
+    users.id.push_back(id);
+    users.name.push_back(strings.add(name));
+    users.privilege.push_back(privileges.intern(privilege));
+    users.active.push_back(active ? 1 : 0);
+}
+
+void Catalog::addCategory(int id, std::string_view name, std::string_view description) {
+    categories.id.push_back(id);
+    categories.name.push_back(categoryNames.intern(name));
+    categories.description.push_back(strings.add(description));
+}
+
+void Catalog::addGame(int id, std::string_view name, std::string_view description, int releaseYear,
+                      double productionCost, int idCategory, std::string_view imageURL, bool active) {
+    if (categoriesById.size() != categories.id.size()) {
+        buildIdOrder(categories.id, categoriesById);
+    }
+    uint32_t categoryRow = findCategory(idCategory);
+
+    games.id.push_back(id);
+    games.name.push_back(strings.add(name));
+    games.description.push_back(strings.add(description));
+    games.releaseYear.push_back(static_cast<int16_t>(releaseYear));
+    games.productionCost.push_back(productionCost);
+    games.category.push_back(categoryRow == NO_ROW ? NO_ROW16 : static_cast<uint16_t>(categoryRow));
+    games.imageURL.push_back(strings.add(imageURL));
+    games.active.push_back(active ? 1 : 0);
+    games.reviewCount.push_back(0);
+    games.markSum.push_back(0);
+}
+
+void Catalog::addPlatform(int id, std::string_view name, std::string_view type,
+                          std::string_view description) {
+    platforms.id.push_back(id);
+    platforms.name.push_back(strings.add(name));
+    platforms.type.push_back(platformTypes.intern(type));
+    platforms.description.push_back(strings.add(description));
+}
+
+void Catalog::addGamePlatform(int gameId, int platformId, std::string_view releaseDate, double price) {
+    gamePlatforms.game.push_back(gameId);
+    gamePlatforms.platform.push_back(platformId);
+    gamePlatforms.releaseDate.push_back(strings.add(releaseDate));
+    gamePlatforms.price.push_back(price);
+}
+
+// ============= Upsert одной строки =============
+// Поиск идет по индексам на момент вызова: строка, добавленная после
+// последнего buildIndexes, еще не находится.
+
+void Catalog::upsertUser(int id, std::string_view name, std::string_view privilege, bool active) {
+    uint32_t row = users.id.empty() ? NO_ROW : findUser(id);
+    if (row == NO_ROW) {
+        addUser(id, name, privilege, active);
+        return;
+    }
+    users.name.set(row, strings.add(name));
+    users.privilege.set(row, privileges.intern(privilege));
+    users.active.set(row, active ? 1 : 0);
+}
+
+void Catalog::upsertCategory(int id, std::string_view name, std::string_view description) {
+    uint32_t row = categories.id.empty() ? NO_ROW : findCategory(id);
+    if (row == NO_ROW) {
+        addCategory(id, name, description);
+        return;
+    }
+    categories.name.set(row, categoryNames.intern(name));
+    categories.description.set(row, strings.add(description));
+}
+
+void Catalog::upsertGame(int id, std::string_view name, std::string_view description, int releaseYear,
+                         double productionCost, int idCategory, std::string_view imageURL, bool active) {
+    uint32_t row = games.id.empty() ? NO_ROW : findGame(id);
+    if (row == NO_ROW) {
+        addGame(id, name, description, releaseYear, productionCost, idCategory, imageURL, active);
+        return;
+    }
+    uint32_t categoryRow = findCategory(idCategory);
+    games.name.set(row, strings.add(name));
+    games.description.set(row, strings.add(description));
+    games.releaseYear.set(row, static_cast<int16_t>(releaseYear));
+    games.productionCost.set(row, productionCost);
+    games.category.set(row, categoryRow == NO_ROW ? NO_ROW16 : static_cast<uint16_t>(categoryRow));
+    games.imageURL.set(row, strings.add(imageURL));
+    games.active.set(row, active ? 1 : 0);
+}
+
+void Catalog::upsertPlatform(int id, std::string_view name, std::string_view type,
+                             std::string_view description) {
+    uint32_t row = platforms.id.empty() ? NO_ROW : findPlatform(id);
+    if (row == NO_ROW) {
+        addPlatform(id, name, type, description);
+        return;
+    }
+    platforms.name.set(row, strings.add(name));
+    platforms.type.set(row, platformTypes.intern(type));
+    platforms.description.set(row, strings.add(description));
+}
+
+void Catalog::upsertGamePlatform(int gameId, int platformId, std::string_view releaseDate, double price) {
+    uint32_t row = gamePlatforms.game.empty() ? NO_ROW : findGamePlatform(gameId, platformId);
+    if (row == NO_ROW) {
+        addGamePlatform(gameId, platformId, releaseDate, price);
+        return;
+    }
+    gamePlatforms.releaseDate.set(row, strings.add(releaseDate));
+    gamePlatforms.price.set(row, price);
+}
+
+void Catalog::buildIndexes() {
+    buildIdOrder(users.id, usersById);
+    buildIdOrder(categories.id, categoriesById);
+    buildIdOrder(games.id, gamesById);
+    buildIdOrder(platforms.id, platformsById);
+
+    buildAdjacency(gamePlatforms.game, gamePlatforms.platform, linkGames, linkGameOffsets, linksByGame);
+    buildAdjacency(gamePlatforms.platform, gamePlatforms.game, linkPlatforms, linkPlatformOffsets,
+                   linksByPlatform);
+    platformGames.clear();
+    platformGames.reserve(linksByPlatform.size());
+    for (size_t i = 0; i < linksByPlatform.size(); ++i) {
+        platformGames.push_back(gamePlatforms.game[linksByPlatform[i]]);
+    }
+}
+
+// ============= Точечные изменения =============
+
+bool Catalog::removeUser(int userId) {
+    uint32_t row = findUser(userId);
+    if (row == NO_ROW) {
+        return false;
+    }
+    users.id.erase(row);
+    users.name.erase(row);
+    users.privilege.erase(row);
+    users.active.erase(row);
+    buildIndexes();
+    return true;
+}
+
+bool Catalog::setUserPrivilege(int userId, std::string_view privilege) {
+    uint32_t row = findUser(userId);
+    if (row == NO_ROW) {
+        return false;
+    }
+    users.privilege.set(row, privileges.intern(privilege));
+    return true;
+}
+
+bool Catalog::removeCategory(int categoryId) {
+    uint32_t row = findCategory(categoryId);
+    if (row == NO_ROW) {
+        return false;
+    }
+    categories.id.erase(row);
+    categories.name.erase(row);
+    categories.description.erase(row);
+
+    // Игры ссылаются на категории по номеру строки - сдвигаем
+    for (size_t i = 0; i < games.category.size(); ++i) {
+        uint16_t category = games.category[i];
+        if (category == row) {
+            games.category.set(i, NO_ROW16);
+        } else if (category != NO_ROW16 && category > row) {
+            games.category.set(i, static_cast<uint16_t>(category - 1));
+        }
+    }
+    buildIndexes();
+    return true;
+}
+
+void Catalog::compactGames(const std::vector<uint8_t>& keep) {
+    games.id.compact(keep);
+    games.name.compact(keep);
+    games.description.compact(keep);
+    games.releaseYear.compact(keep);
+    games.productionCost.compact(keep);
+    games.category.compact(keep);
+    games.imageURL.compact(keep);
+    games.active.compact(keep);
+    games.reviewCount.compact(keep);
+    games.markSum.compact(keep);
+}
+
+void Catalog::compactGamePlatforms(const std::vector<uint8_t>& keep) {
+    gamePlatforms.game.compact(keep);
+    gamePlatforms.platform.compact(keep);
+    gamePlatforms.releaseDate.compact(keep);
+    gamePlatforms.price.compact(keep);
+}
+
+bool Catalog::removeGame(int gameId) {
+    return removeGames(std::vector<int>{gameId}) > 0;
+}
+
+size_t Catalog::removeGames(const std::vector<int>& gameIds) {
+    std::vector<uint8_t> keepGames(games.id.size(), 1);
+    std::vector<int> removedIds;
+    for (int gameId : gameIds) {
+        uint32_t row = findGame(gameId);
+        if (row != NO_ROW && keepGames[row]) {
+            keepGames[row] = 0;
+            removedIds.push_back(gameId);
+        }
+    }
+    if (removedIds.empty()) {
+        return 0;
+    }
+    std::sort(removedIds.begin(), removedIds.end());
+
+    std::vector<uint8_t> keepLinks(gamePlatforms.game.size());
+    for (size_t i = 0; i < keepLinks.size(); ++i) {
+        keepLinks[i] = !std::binary_search(removedIds.begin(), removedIds.end(), gamePlatforms.game[i]);
+    }
+    compactGames(keepGames);
+    compactGamePlatforms(keepLinks);
+    buildIndexes();
+    return removedIds.size();
+}
+
+bool Catalog::removePlatform(int platformId) {
+    uint32_t row = findPlatform(platformId);
+    if (row == NO_ROW) {
+        return false;
+    }
+    platforms.id.erase(row);
+    platforms.name.erase(row);
+    platforms.type.erase(row);
+    platforms.description.erase(row);
+
+    std::vector<uint8_t> keepLinks(gamePlatforms.platform.size());
+    for (size_t i = 0; i < keepLinks.size(); ++i) {
+        keepLinks[i] = gamePlatforms.platform[i] != platformId;
+    }
+    compactGamePlatforms(keepLinks);
+    buildIndexes();
+    return true;
+}
+
+bool Catalog::removeGamePlatform(int gameId, int platformId) {
+    return removeGamePlatforms(std::vector<std::pair<int, int>>{{gameId, platformId}}) > 0;
+}
+
+size_t Catalog::removeGamePlatforms(const std::vector<std::pair<int, int>>& links) {
+    std::vector<uint8_t> keep(gamePlatforms.game.size(), 1);
+    size_t removed = 0;
+    for (const auto& link : links) {
+        uint32_t row = findGamePlatform(link.first, link.second);
+        if (row != NO_ROW && keep[row]) {
+            keep[row] = 0;
+            ++removed;
+        }
+    }
+    if (removed > 0) {
+        compactGamePlatforms(keep);
+        buildIndexes();
+    }
+    return removed;
+}
+
+bool Catalog::setGameRating(int gameId, uint32_t reviewCount, uint32_t markSum) {
+    uint32_t row = findGame(gameId);
+    if (row == NO_ROW) {
+        return false;
+    }
+    games.reviewCount.set(row, reviewCount);
+    games.markSum.set(row, markSum);
+    return true;
+}
+
+bool Catalog::adjustGameRating(int gameId, int reviewDelta, int markDelta) {
+    uint32_t row = findGame(gameId);
+    if (row == NO_ROW) {
+        return false;
+    }
+    // Не уходим ниже нуля, если событие пришло к уже пересчитанному агрегату
+    int64_t reviewCount = static_cast<int64_t>(games.reviewCount[row]) + reviewDelta;
+    int64_t markSum = static_cast<int64_t>(games.markSum[row]) + markDelta;
+    games.reviewCount.set(row, static_cast<uint32_t>(std::max<int64_t>(reviewCount, 0)));
+    games.markSum.set(row, static_cast<uint32_t>(std::max<int64_t>(markSum, 0)));
+    return true;
+}
+
+bool Catalog::setGamePlatformPrice(int gameId, int platformId, double price) {
+    uint32_t row = findGamePlatform(gameId, platformId);
+    if (row == NO_ROW) {
+        return false;
+    }
+    gamePlatforms.price.set(row, price);
+    return true;
+}
+
+void Catalog::buildIdOrder(const Column<int32_t>& ids, Column<uint32_t>& order) {
+    std::vector<uint32_t> rows(ids.size());
+    std::iota(rows.begin(), rows.end(), 0u);
+    std::sort(rows.begin(), rows.end(), [&ids](uint32_t a, uint32_t b) { return ids[a] < ids[b]; });
+
+    order.clear();
+    order.append(rows.data(), rows.size());
+}
+
+uint32_t Catalog::findRow(const Column<int32_t>& ids, const Column<uint32_t>& order, int id) {
+    const uint32_t* begin = order.data();
+    const uint32_t* end = begin + order.size();
+    const uint32_t* it = std::lower_bound(begin, end, id,
+                                          [&ids](uint32_t row, int value) { return ids[row] < value; });
+    return (it != end && ids[*it] == id) ? *it : NO_ROW;
+}
+
+void Catalog::buildAdjacency(const Column<int32_t>& from, const Column<int32_t>& to, Column<int32_t>& keys,
+                             Column<uint32_t>& offsets, Column<uint32_t>& rows) {
+    std::vector<int32_t> distinct(from.data(), from.data() + from.size());
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+    // Номер ключа каждой строки, затем префиксные суммы и раскладка строк по местам
+    std::vector<uint32_t> keyOf(from.size());
+    std::vector<uint32_t> starts(distinct.size() + 1, 0);
+    for (size_t row = 0; row < from.size(); ++row) {
+        keyOf[row] = static_cast<uint32_t>(std::lower_bound(distinct.begin(), distinct.end(), from[row]) -
+                                           distinct.begin());
+        starts[keyOf[row] + 1]++;
+    }
+    for (size_t k = 0; k < distinct.size(); ++k) {
+        starts[k + 1] += starts[k];
+    }
+    std::vector<uint32_t> sorted(from.size());
+    std::vector<uint32_t> next(starts.begin(), starts.end() - 1);
+    for (size_t row = 0; row < from.size(); ++row) {
+        sorted[next[keyOf[row]]++] = static_cast<uint32_t>(row);
+    }
+    // Соседей у ключа немного - досортировка отрезков дешевая
+    for (size_t k = 0; k < distinct.size(); ++k) {
+        std::sort(sorted.begin() + starts[k], sorted.begin() + starts[k + 1],
+                  [&to](uint32_t a, uint32_t b) { return to[a] < to[b]; });
+    }
+
+    keys.clear();
+    keys.append(distinct.data(), distinct.size());
+    offsets.clear();
+    offsets.append(starts.data(), starts.size());
+    rows.clear();
+    rows.append(sorted.data(), sorted.size());
+}
+
+std::pair<size_t, size_t> Catalog::adjacencyRange(const Column<int32_t>& keys, const Column<uint32_t>& offsets,
+                                                  int key) {
+    const int32_t* begin = keys.data();
+    const int32_t* end = begin + keys.size();
+    const int32_t* it = std::lower_bound(begin, end, key);
+    if (it == end || *it != key) {
+        return {0, 0};
+    }
+    size_t k = static_cast<size_t>(it - begin);
+    return {offsets[k], offsets[k + 1]};
+}
+
+uint32_t Catalog::findUser(int userId) const {
+    return findRow(users.id, usersById, userId);
+}
+
+uint32_t Catalog::findCategory(int categoryId) const {
+    return findRow(categories.id, categoriesById, categoryId);
+}
+
+uint32_t Catalog::findGame(int gameId) const {
+    return findRow(games.id, gamesById, gameId);
+}
+
+uint32_t Catalog::findPlatform(int platformId) const {
+    return findRow(platforms.id, platformsById, platformId);
+}
+
+std::pair<size_t, size_t> Catalog::gamePlatformRange(int gameId) const {
+    return adjacencyRange(linkGames, linkGameOffsets, gameId);
+}
+
+std::pair<size_t, size_t> Catalog::platformGameRange(int platformId) const {
+    return adjacencyRange(linkPlatforms, linkPlatformOffsets, platformId);
+}
+
+uint32_t Catalog::findGamePlatform(int gameId, int platformId) const {
+    std::pair<size_t, size_t> range = gamePlatformRange(gameId);
+    for (size_t i = range.first; i < range.second; ++i) {
+        if (gamePlatforms.platform[linksByGame[i]] == platformId) {
+            return linksByGame[i];
+        }
+    }
+    return NO_ROW;
+}
+
+std::vector<int> Catalog::gamesOnAllPlatforms(const std::vector<int>& platformIds, double maxPrice) const {
+    std::vector<int> result;
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (int platformId : platformIds) {
+        ranges.push_back(platformGameRange(platformId));
+        if (ranges.back().first == ranges.back().second) {
+            return result;
+        }
+    }
+    if (ranges.empty()) {
+        return result;
+    }
+    // Кандидаты - из самого короткого списка, остальные списки проходим курсорами вперед
+    using Range = std::pair<size_t, size_t>;
+    std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) {
+        return a.second - a.first < b.second - b.first;
+    });
+    const int32_t* games = platformGames.data();
+    auto affordable = [this, maxPrice](size_t position) {
+        return maxPrice < 0 || gamePlatforms.price[linksByPlatform[position]] <= maxPrice;
+    };
+
+    std::vector<size_t> cursors(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        cursors[i] = ranges[i].first;
+    }
+    for (size_t position = ranges[0].first; position < ranges[0].second; ++position) {
+        if (!affordable(position)) {
+            continue;
+        }
+        int gameId = games[position];
+        bool everywhere = true;
+        for (size_t i = 1; i < ranges.size() && everywhere; ++i) {
+            cursors[i] = static_cast<size_t>(std::lower_bound(games + cursors[i], games + ranges[i].second, gameId) -
+                                             games);
+            everywhere = cursors[i] < ranges[i].second && games[cursors[i]] == gameId && affordable(cursors[i]);
+        }
+        if (everywhere) {
+            result.push_back(gameId);
+        }
+    }
+    return result;
+}
+
+std::string_view Catalog::userName(uint32_t row) const {
+    return row < users.name.size() ? strings.get(users.name[row]) : std::string_view();
+}
+
+std::string_view Catalog::userPrivilege(uint32_t row) const {
+    return row < users.privilege.size() ? privileges.value(users.privilege[row]) : std::string_view();
+}
+
+std::string_view Catalog::categoryName(uint32_t row) const {
+    return row < categories.name.size() ? categoryNames.value(categories.name[row]) : std::string_view();
+}
+
+std::string_view Catalog::gameName(uint32_t row) const {
+    return row < games.name.size() ? strings.get(games.name[row]) : std::string_view();
+}
+
+std::string_view Catalog::gameCategoryName(uint32_t row) const {
+    if (row >= games.category.size() || games.category[row] == NO_ROW16) {
+        return std::string_view();
+    }
+    return categoryName(games.category[row]);
+}
+
+double Catalog::gameAverageMark(uint32_t row) const {
+    if (row >= games.reviewCount.size() || games.reviewCount[row] == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(games.markSum[row]) / games.reviewCount[row];
+}
+
+std::string_view Catalog::platformName(uint32_t row) const {
+    return row < platforms.name.size() ? strings.get(platforms.name[row]) : std::string_view();
+}
+
+std::string_view Catalog::platformType(uint32_t row) const {
+    return row < platforms.type.size() ? platformTypes.value(platforms.type[row]) : std::string_view();
+}
+
+size_t Catalog::memoryUsage() const {
+    size_t bytes = strings.memoryUsage() + privileges.memoryUsage() + categoryNames.memoryUsage() +
+                   platformTypes.memoryUsage();
+
+    bytes += users.id.memoryUsage() + users.name.memoryUsage() + users.privilege.memoryUsage() +
+             users.active.memoryUsage();
+    bytes += categories.id.memoryUsage() + categories.name.memoryUsage() +
+             categories.description.memoryUsage();
+    bytes += games.id.memoryUsage() + games.name.memoryUsage() + games.description.memoryUsage() +
+             games.releaseYear.memoryUsage() + games.productionCost.memoryUsage() +
+             games.category.memoryUsage() + games.imageURL.memoryUsage() + games.active.memoryUsage() +
+             games.reviewCount.memoryUsage() + games.markSum.memoryUsage();
+    bytes += platforms.id.memoryUsage() + platforms.name.memoryUsage() + platforms.type.memoryUsage() +
+             platforms.description.memoryUsage();
+    bytes += gamePlatforms.game.memoryUsage() + gamePlatforms.platform.memoryUsage() +
+             gamePlatforms.releaseDate.memoryUsage() + gamePlatforms.price.memoryUsage();
+    bytes += linkGames.memoryUsage() + linkGameOffsets.memoryUsage() + linksByGame.memoryUsage() +
+             linkPlatforms.memoryUsage() + linkPlatformOffsets.memoryUsage() + linksByPlatform.memoryUsage() +
+             platformGames.memoryUsage();
+    bytes += usersById.memoryUsage() + categoriesById.memoryUsage() + gamesById.memoryUsage() +
+             platformsById.memoryUsage();
+    return bytes;
+}
@@ -0,0 +1,407 @@
+#include "../headers/CatalogSnapshot.hpp"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char SNAPSHOT_MAGIC[8] = {'G', 'R', 'C', 'A', 'T', 'L', 'G', '\0'};
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+// Секции, которые не являются Column<T>
+static const uint32_t SECTION_STRINGS = 70;
+static const uint32_t SECTION_PRIVILEGES = 71;
+static const uint32_t SECTION_CATEGORY_NAMES = 72;
+static const uint32_t SECTION_PLATFORM_TYPES = 73;
+
+static uint64_t fnv1a(uint64_t hash, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t alignUp(uint64_t value) {
+    return (value + 7) & ~static_cast<uint64_t>(7);
+}
+
+// ============= MappedFile =============
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    bytes = static_cast<const char*>(view);
+    length = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) {
+        UnmapViewOfFile(bytes);
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle) {
+        CloseHandle(fileHandle);
+    }
+    bytes = nullptr;
+    length = 0;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    // MAP_SHARED: страницы из page cache, без копии на процесс
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    bytes = static_cast<const char*>(view);
+    length = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+    bytes = nullptr;
+    length = 0;
+}
+
+#endif
+
+// ============= CatalogSnapshot =============
+
+// Порядок и номера секций - часть формата файла
+template <typename CatalogType, typename Visitor>
+void CatalogSnapshot::forEachColumn(CatalogType& catalog, Visitor&& visit) {
+    visit(1, catalog.users.id);
+    visit(2, catalog.users.name);
+    visit(3, catalog.users.privilege);
+    visit(4, catalog.users.active);
+
+    visit(10, catalog.categories.id);
+    visit(11, catalog.categories.name);
+    visit(12, catalog.categories.description);
+
+    visit(20, catalog.games.id);
+    visit(21, catalog.games.name);
+    visit(22, catalog.games.description);
+    visit(23, catalog.games.releaseYear);
+    visit(24, catalog.games.productionCost);
+    visit(25, catalog.games.category);
+    visit(26, catalog.games.imageURL);
+    visit(27, catalog.games.active);
+    visit(28, catalog.games.reviewCount);
+    visit(29, catalog.games.markSum);
+
+    visit(40, catalog.platforms.id);
+    visit(41, catalog.platforms.name);
+    visit(42, catalog.platforms.type);
+    visit(43, catalog.platforms.description);
+
+    visit(50, catalog.gamePlatforms.game);
+    visit(51, catalog.gamePlatforms.platform);
+    visit(52, catalog.gamePlatforms.releaseDate);
+    visit(53, catalog.gamePlatforms.price);
+
+    visit(60, catalog.usersById);
+    visit(61, catalog.categoriesById);
+    visit(62, catalog.gamesById);
+    visit(63, catalog.platformsById);
+    visit(64, catalog.linksByGame);
+    visit(80, catalog.linkGames);
+    visit(81, catalog.linkGameOffsets);
+    visit(82, catalog.linkPlatforms);
+    visit(83, catalog.linkPlatformOffsets);
+    visit(84, catalog.linksByPlatform);
+    visit(85, catalog.platformGames);
+}
+
+bool CatalogSnapshot::write(const Catalog& catalog, const std::string& path, const std::string& watermark) {
+    struct Piece {
+        uint32_t id;
+        uint32_t elementSize;
+        uint64_t count;
+        std::vector<std::pair<const char*, size_t>> chunks;
+    };
+
+    try {
+        std::vector<Piece> pieces;
+        forEachColumn(catalog, [&](uint32_t id, const auto& column) {
+            using T = typename std::decay<decltype(column[0])>::type;
+            pieces.push_back({id, static_cast<uint32_t>(sizeof(T)), column.size(),
+                              {{reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T)}}});
+        });
+
+        // Арена: заимствованная часть и хвост подряд - смещения StringRef сохраняются
+        const Column<char>& buffer = catalog.strings.getBuffer();
+        const std::vector<char>& tail = catalog.strings.getTail();
+        pieces.push_back({SECTION_STRINGS, 1, catalog.strings.size(),
+                          {{buffer.data(), buffer.size()}, {tail.data(), tail.size()}}});
+
+        // Словари: значения через '\0' в порядке кодов
+        std::deque<std::string> blobs;
+        auto addDictionary = [&](uint32_t id, const StringDictionary& dictionary) {
+            std::string blob;
+            for (size_t code = 0; code < dictionary.size(); ++code) {
+                blob.append(dictionary.value(static_cast<uint16_t>(code)));
+                blob.push_back('\0');
+            }
+            blobs.push_back(std::move(blob));
+            pieces.push_back({id, 1, blobs.back().size(), {{blobs.back().data(), blobs.back().size()}}});
+        };
+        addDictionary(SECTION_PRIVILEGES, catalog.privileges);
+        addDictionary(SECTION_CATEGORY_NAMES, catalog.categoryNames);
+        addDictionary(SECTION_PLATFORM_TYPES, catalog.platformTypes);
+
+        // Раскладка
+        std::vector<SnapshotSection> sections;
+        uint64_t offset = alignUp(sizeof(SnapshotHeader) + pieces.size() * sizeof(SnapshotSection));
+        for (const Piece& piece : pieces) {
+            sections.push_back({piece.id, piece.elementSize, offset, piece.count});
+            offset = alignUp(offset + piece.count * piece.elementSize);
+        }
+
+        SnapshotHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.formatVersion = FORMAT_VERSION;
+        header.sectionCount = static_cast<uint32_t>(sections.size());
+        header.fileSize = offset;
+        std::strncpy(header.watermark, watermark.c_str(), sizeof(header.watermark) - 1);
+
+        std::string tmpPath = path + ".tmp";
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "ERROR in CatalogSnapshot::write: cannot open " << tmpPath << "\n";
+            return false;
+        }
+
+        uint64_t checksum = FNV_OFFSET;
+        uint64_t written = sizeof(SnapshotHeader);
+        auto emit = [&](const char* data, size_t size) {
+            out.write(data, static_cast<std::streamsize>(size));
+            checksum = fnv1a(checksum, data, size);
+            written += size;
+        };
+        static const char padding[8] = {0};
+        auto pad = [&](uint64_t to) {
+            emit(padding, static_cast<size_t>(to - written));
+        };
+
+        // Заголовок перезаписывается в конце, когда известна сумма
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        emit(reinterpret_cast<const char*>(sections.data()), sections.size() * sizeof(SnapshotSection));
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            pad(sections[i].offset);
+            for (const auto& chunk : pieces[i].chunks) {
+                if (chunk.second > 0) {
+                    emit(chunk.first, chunk.second);
+                }
+            }
+        }
+        pad(header.fileSize);
+
+        header.checksum = checksum;
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        if (!out) {
+            std::cerr << "ERROR in CatalogSnapshot::write: failed to write " << tmpPath << "\n";
+            return false;
+        }
+
+        // Читатели старого файла держат свое отображение, новые откроют новый
+        std::filesystem::rename(tmpPath, path);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in CatalogSnapshot::write: " << e.what() << "\n";
+        return false;
+    }
+}
+
+bool CatalogSnapshot::read(const std::string& path, Catalog& catalog) {
+    try {
+        std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+        if (!file->open(path)) {
+            return false;
+        }
+
+        const char* base = file->data();
+        if (file->size() < sizeof(SnapshotHeader)) {
+            std::cerr << "ERROR: Catalog snapshot " << path << " is truncated\n";
+            return false;
+        }
+        SnapshotHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+            header.formatVersion != FORMAT_VERSION) {
+            std::cerr << "ERROR: Catalog snapshot " << path << " has an unknown format\n";
+            return false;
+        }
+        uint64_t sectionsEnd = sizeof(SnapshotHeader) + static_cast<uint64_t>(header.sectionCount) * sizeof(SnapshotSection);
+        if (header.fileSize != file->size() || sectionsEnd > header.fileSize) {
+            std::cerr << "ERROR: Catalog snapshot " << path << " is truncated\n";
+            return false;
+        }
+        if (fnv1a(FNV_OFFSET, base + sizeof(SnapshotHeader), file->size() - sizeof(SnapshotHeader)) != header.checksum) {
+            std::cerr << "ERROR: Catalog snapshot " << path << " checksum mismatch\n";
+            return false;
+        }
+
+        const SnapshotSection* sections = reinterpret_cast<const SnapshotSection*>(base + sizeof(SnapshotHeader));
+        auto findSection = [&](uint32_t id, uint32_t elementSize) -> const SnapshotSection* {
+            for (uint32_t i = 0; i < header.sectionCount; ++i) {
+                const SnapshotSection& section = sections[i];
+                if (section.id == id) {
+                    bool fits = section.elementSize == elementSize && section.offset % 8 == 0 &&
+                                section.offset <= header.fileSize &&
+                                section.count <= (header.fileSize - section.offset) / elementSize;
+                    return fits ? &section : nullptr;
+                }
+            }
+            return nullptr;
+        };
+
+        Catalog loaded;
+        bool complete = true;
+        forEachColumn(loaded, [&](uint32_t id, auto& column) {
+            using T = typename std::decay<decltype(column[0])>::type;
+            const SnapshotSection* section = findSection(id, sizeof(T));
+            if (!section) {
+                complete = false;
+                return;
+            }
+            column.borrow(reinterpret_cast<const T*>(base + section->offset), static_cast<size_t>(section->count));
+        });
+
+        const SnapshotSection* strings = findSection(SECTION_STRINGS, 1);
+        if (!complete || !strings) {
+            std::cerr << "ERROR: Catalog snapshot " << path << " is missing sections\n";
+            return false;
+        }
+        loaded.strings.borrow(base + strings->offset, static_cast<size_t>(strings->count));
+
+        auto readDictionary = [&](uint32_t id, StringDictionary& dictionary) {
+            const SnapshotSection* section = findSection(id, 1);
+            if (!section) {
+                return false;
+            }
+            const char* cursor = base + section->offset;
+            const char* end = cursor + section->count;
+            while (cursor < end) {
+                const char* terminator = static_cast<const char*>(std::memchr(cursor, '\0', end - cursor));
+                if (!terminator) {
+                    return false;
+                }
+                dictionary.intern(std::string_view(cursor, terminator - cursor));
+                cursor = terminator + 1;
+            }
+            return true;
+        };
+        if (!readDictionary(SECTION_PRIVILEGES, loaded.privileges) ||
+            !readDictionary(SECTION_CATEGORY_NAMES, loaded.categoryNames) ||
+            !readDictionary(SECTION_PLATFORM_TYPES, loaded.platformTypes)) {
+            std::cerr << "ERROR: Catalog snapshot " << path << " has broken dictionaries\n";
+            return false;
+        }
+
+        // Колонки одной таблицы должны быть одной длины
+        const GameColumns& games = loaded.games;
+        size_t gameCount = games.id.size();
+        bool consistent =
+            loaded.users.name.size() == loaded.users.id.size() &&
+            loaded.users.privilege.size() == loaded.users.id.size() &&
+            loaded.users.active.size() == loaded.users.id.size() &&
+            loaded.usersById.size() == loaded.users.id.size() &&
+            loaded.categories.name.size() == loaded.categories.id.size() &&
+            loaded.categories.description.size() == loaded.categories.id.size() &&
+            loaded.categoriesById.size() == loaded.categories.id.size() &&
+            games.name.size() == gameCount && games.description.size() == gameCount &&
+            games.releaseYear.size() == gameCount && games.productionCost.size() == gameCount &&
+            games.category.size() == gameCount && games.imageURL.size() == gameCount &&
+            games.active.size() == gameCount && games.reviewCount.size() == gameCount &&
+            games.markSum.size() == gameCount && loaded.gamesById.size() == gameCount &&
+            loaded.platforms.name.size() == loaded.platforms.id.size() &&
+            loaded.platforms.type.size() == loaded.platforms.id.size() &&
+            loaded.platforms.description.size() == loaded.platforms.id.size() &&
+            loaded.platformsById.size() == loaded.platforms.id.size() &&
+            loaded.gamePlatforms.platform.size() == loaded.gamePlatforms.game.size() &&
+            loaded.gamePlatforms.releaseDate.size() == loaded.gamePlatforms.game.size() &&
+            loaded.gamePlatforms.price.size() == loaded.gamePlatforms.game.size() &&
+            loaded.linksByGame.size() == loaded.gamePlatforms.game.size() &&
+            loaded.linksByPlatform.size() == loaded.gamePlatforms.game.size() &&
+            loaded.platformGames.size() == loaded.gamePlatforms.game.size() &&
+            loaded.linkGameOffsets.size() == loaded.linkGames.size() + 1 &&
+            loaded.linkPlatformOffsets.size() == loaded.linkPlatforms.size() + 1;
+        if (!consistent) {
+            std::cerr << "ERROR: Catalog snapshot " << path << " has inconsistent columns\n";
+            return false;
+        }
+
+        loaded.watermark.assign(header.watermark, strnlen(header.watermark, sizeof(header.watermark)));
+        loaded.backing = file;
+        catalog = std::move(loaded);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in CatalogSnapshot::read: " << e.what() << "\n";
+        return false;
+    }
+}
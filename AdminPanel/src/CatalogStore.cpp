@@ -0,0 +1,143 @@
+#include "../headers/CatalogStore.hpp"
+#include <iostream>
+#include <thread>
+#include <functional>
+
+CatalogStore::~CatalogStore() {
+    // Читателей к этому моменту быть не должно
+    std::lock_guard<std::mutex> lock(writerMutex);
+    for (const auto& entry : retired) {
+        delete entry.snapshot;
+    }
+    retired.clear();
+    delete current.exchange(nullptr);
+}
+
+// ============= Читатели =============
+
+CatalogStore::ReaderSlot* CatalogStore::acquireSlot() {
+    // Начинаем с "своего" слота, чтобы потоки не толкались на одном
+    size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_READERS;
+    while (true) {
+        for (size_t i = 0; i < MAX_READERS; ++i) {
+            ReaderSlot& slot = slots[(start + i) % MAX_READERS];
+            uint64_t expected = 0;
+            if (slot.epoch.load(std::memory_order_relaxed) == 0 &&
+                slot.epoch.compare_exchange_strong(expected, globalEpoch.load())) {
+                return &slot;
+            }
+        }
+        // Все слоты заняты другими читателями (не писателем)
+        std::this_thread::yield();
+    }
+}
+
+CatalogStore::ReadGuard CatalogStore::read() {
+    ReaderSlot* slot = acquireSlot();
+    return ReadGuard(slot, current.load());
+}
+
+CatalogStore::ReadGuard::~ReadGuard() {
+    if (slot) {
+        slot->epoch.store(0, std::memory_order_release);
+    }
+}
+
+bool CatalogStore::hasSnapshot() const {
+    return current.load() != nullptr;
+}
+
+uint64_t CatalogStore::getVersion() const {
+    return publishedVersion.load();
+}
+
+// ============= Писатель =============
+
+void CatalogStore::publishLocked(std::unique_ptr<Snapshot> next) {
+    next->version = nextVersion++;
+    uint64_t version = next->version;
+    const Snapshot* previous = current.exchange(next.release());
+    publishedVersion.store(version);
+
+    // Кто объявил эпоху до этого инкремента, мог увидеть previous
+    uint64_t retireEpoch = globalEpoch.fetch_add(1) + 1;
+    if (previous) {
+        retired.push_back({previous, retireEpoch});
+    }
+    reclaimLocked();
+}
+
+size_t CatalogStore::reclaimLocked() {
+    uint64_t oldestReader = UINT64_MAX;
+    for (size_t i = 0; i < MAX_READERS; ++i) {
+        uint64_t epoch = slots[i].epoch.load();
+        if (epoch != 0 && epoch < oldestReader) {
+            oldestReader = epoch;
+        }
+    }
+
+    size_t freed = 0;
+    for (size_t i = 0; i < retired.size();) {
+        if (retired[i].retireEpoch <= oldestReader) {
+            delete retired[i].snapshot;
+            retired[i] = retired.back();
+            retired.pop_back();
+            ++freed;
+        } else {
+            ++i;
+        }
+    }
+    return freed;
+}
+
+void CatalogStore::publish(std::unique_ptr<Catalog> catalog) {
+    if (!catalog) {
+        return;
+    }
+    std::unique_ptr<Snapshot> next(new Snapshot{std::move(*catalog), 0});
+    std::lock_guard<std::mutex> lock(writerMutex);
+    publishLocked(std::move(next));
+}
+
+bool CatalogStore::reload(User& userMgr, Game& gameMgr, Platform& platformMgr, Review& reviewMgr) {
+    try {
+        // Загрузка из БД - вне мьютекса: другие писатели ждут только подмену указателя
+        std::unique_ptr<Catalog> catalog = std::make_unique<Catalog>();
+        if (!catalog->load(userMgr, gameMgr, platformMgr, reviewMgr)) {
+            std::cerr << "ERROR: Failed to load catalog snapshot!\n";
+            return false;
+        }
+        publish(std::move(catalog));
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in CatalogStore::reload: " << e.what() << "\n";
+        return false;
+    }
+}
+
+bool CatalogStore::update(const std::function<bool(Catalog&)>& change) {
+    try {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        const Snapshot* base = current.load();
+        if (!base) {
+            return false;
+        }
+
+        // base не освободится: освобождает только писатель, а он - мы
+        std::unique_ptr<Snapshot> next(new Snapshot{base->catalog, 0});
+        if (!change(next->catalog)) {
+            return false;
+        }
+        publishLocked(std::move(next));
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in CatalogStore::update: " << e.what() << "\n";
+        return false;
+    }
+}
+
+size_t CatalogStore::getRetiredCount() {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    reclaimLocked();
+    return retired.size();
+}
@@ -0,0 +1,50 @@
+#include "../headers/CircuitBreaker.hpp"
+
+CircuitBreaker::CircuitBreaker(int threshold, int cooldownMs)
+    : failureThreshold(threshold > 0 ? threshold : 1),
+      cooldown(cooldownMs > 0 ? cooldownMs : 0) {
+}
+
+bool CircuitBreaker::allowRequest() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (state == State::CLOSED) {
+        return true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (state == State::OPEN) {
+        if (now - openedAt < cooldown) {
+            return false;
+        }
+        state = State::HALF_OPEN;
+    } else if (probeInFlight && now - probeStartedAt < cooldown) {
+        return false;
+    }
+
+    // После cooldown пропускаем одну пробу
+    probeInFlight = true;
+    probeStartedAt = now;
+    return true;
+}
+
+void CircuitBreaker::recordSuccess() {
+    std::lock_guard<std::mutex> lock(mutex);
+    consecutiveFailures = 0;
+    probeInFlight = false;
+    state = State::CLOSED;
+}
+
+void CircuitBreaker::recordFailure() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++consecutiveFailures;
+    probeInFlight = false;
+    if (state == State::HALF_OPEN || consecutiveFailures >= failureThreshold) {
+        state = State::OPEN;
+        openedAt = std::chrono::steady_clock::now();
+    }
+}
+
+CircuitBreaker::State CircuitBreaker::getState() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return state;
+}
@@ -0,0 +1,69 @@
+#include "../headers/ColumnStore.hpp"
+#include <stdexcept>
+
+// ============= StringArena =============
+
+StringRef StringArena::add(std::string_view text) {
+    if (size() + text.size() > UINT32_MAX) {
+        throw std::length_error("StringArena is full");
+    }
+
+    StringRef ref = {static_cast<uint32_t>(size()), static_cast<uint32_t>(text.size())};
+    if (buffer.isBorrowed()) {
+        tail.insert(tail.end(), text.begin(), text.end());
+    } else {
+        buffer.append(text.data(), text.size());
+    }
+    return ref;
+}
+
+std::string_view StringArena::get(StringRef ref) const {
+    size_t end = static_cast<size_t>(ref.offset) + ref.length;
+    if (ref.length == 0 || end > size()) {
+        return std::string_view();
+    }
+    if (end <= buffer.size()) {
+        return std::string_view(buffer.data() + ref.offset, ref.length);
+    }
+    return std::string_view(tail.data() + (ref.offset - buffer.size()), ref.length);
+}
+
+// ============= StringDictionary =============
+
+uint16_t StringDictionary::intern(std::string_view value) {
+    std::string key(value);
+    auto it = codes.find(key);
+    if (it != codes.end()) {
+        return it->second;
+    }
+    if (values.size() >= NO_CODE) {
+        throw std::length_error("StringDictionary is full");
+    }
+
+    uint16_t code = static_cast<uint16_t>(values.size());
+    values.push_back(key);
+    codes.emplace(std::move(key), code);
+    return code;
+}
+
+uint16_t StringDictionary::find(std::string_view value) const {
+    auto it = codes.find(std::string(value));
+    return it != codes.end() ? it->second : NO_CODE;
+}
+
+std::string_view StringDictionary::value(uint16_t code) const {
+    return code < values.size() ? std::string_view(values[code]) : std::string_view();
+}
+
+void StringDictionary::clear() {
+    values.clear();
+    codes.clear();
+}
+
+size_t StringDictionary::memoryUsage() const {
+    size_t bytes = values.capacity() * sizeof(std::string);
+    for (const auto& value : values) {
+        bytes += value.capacity() * 2;   // строка + копия ключа в codes
+    }
+    return bytes + codes.bucket_count() * sizeof(void*) + codes.size() * (sizeof(std::string) + 16);
+}
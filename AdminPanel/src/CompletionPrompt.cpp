@@ -0,0 +1,80 @@
+#include "../headers/CompletionPrompt.hpp"
+#include <algorithm>
+
+// Строки экрана вокруг списка дополнений
+static const int PROMPT_CHROME_ROWS = 11;
+
+CompletionPrompt::CompletionPrompt(const NameTrie& trie, const std::string& title, const std::string& label,
+                                   const std::string& existsNote)
+    : trie(trie), title(title), label(label), existsNote(existsNote) {
+}
+
+bool CompletionPrompt::read(ScreenRenderer& screen, TerminalInput& input, std::string& text) {
+    int cursor = 0;
+
+    while (true) {
+        int termRows, termCols;
+        ScreenRenderer::getTerminalSize(termRows, termCols);
+        size_t visible = static_cast<size_t>(std::max(termRows - PROMPT_CHROME_ROWS, 3));
+
+        std::vector<NameMatch> matches = text.empty() ? std::vector<NameMatch>() : trie.complete(text, visible);
+        cursor = std::max(0, std::min(cursor, static_cast<int>(matches.size()) - 1));
+
+        screen.beginFrame();
+        std::ostream& out = screen.frame();
+        out << "\n════════════════════════════════════════════════\n";
+        out << " " << title << "\n";
+        out << "════════════════════════════════════════════════\n";
+        out << " " << label << ": " << text << "▌\n";
+        if (!message.empty()) {
+            out << " " << message;
+        } else if (!text.empty() && trie.contains(text)) {
+            out << " ⚠ " << existsNote;
+        }
+        out << "\n";
+        out << "────────────────────────────────────────────────\n";
+        for (size_t i = 0; i < matches.size(); ++i) {
+            out << (static_cast<int>(i) == cursor ? "▶ " : "  ") << *matches[i].name;
+            if (matches[i].score > 0) {
+                out << "  (" << matches[i].score << ")";
+            }
+            out << "\n";
+        }
+        out << "────────────────────────────────────────────────\n";
+        out << "[Type] [↑/↓ Move] [Tab Complete] [Enter Accept] [ESC Cancel]\n";
+        screen.present();
+
+        KeyEvent key = input.readKey();
+        message.clear();
+        switch (key.code) {
+            case KeyCode::ESCAPE:
+                return false;
+            case KeyCode::ENTER:
+                return true;
+            case KeyCode::TAB:
+                if (!matches.empty()) {
+                    text = *matches[cursor].name;
+                    cursor = 0;
+                }
+                break;
+            case KeyCode::UP: cursor--; break;
+            case KeyCode::DOWN: cursor++; break;
+            case KeyCode::BACKSPACE:
+                // Удаляем целый символ UTF-8
+                while (!text.empty()) {
+                    unsigned char c = static_cast<unsigned char>(text.back());
+                    text.pop_back();
+                    if ((c & 0xC0) != 0x80) {
+                        break;
+                    }
+                }
+                cursor = 0;
+                break;
+            case KeyCode::CHAR:
+                text += key.text;
+                cursor = 0;
+                break;
+            default: break;
+        }
+    }
+}
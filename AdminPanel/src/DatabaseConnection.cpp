@@ -1,33 +1,26 @@
 ﻿#include "../headers/DatabaseConnection.hpp"
+#include <errmsg.h>
 #include <iostream>
+#include <csignal>
+#include <random>
+#include <algorithm>
+
+std::atomic<DatabaseConnection*> DatabaseConnection::interruptTarget{nullptr};
+void (*volatile DatabaseConnection::interruptExitHook)() = nullptr;
 
 DatabaseConnection::DatabaseConnection(const std::string& host, 
                                        const std::string& user,
                                        const std::string& password,
-                                       const std::string& database)
-    : host(host), user(user), password(password), database(database), isConnected(false) {
+                                       const std::string& database,
+                                       unsigned int port,
+                                       const ConnectionOptions& opts)
+    : connection(nullptr), host(host), user(user), password(password), database(database),
+      port(port), isConnected(false), options(opts),
+      breaker(opts.breakerThreshold, opts.breakerCooldownMs) {
     
     try {
-        // Инициализировать объект MYSQL
-        connection = mysql_init(NULL);
-        
-        if (!connection) {
-            std::cerr << "ERROR: mysql_init failed!\n";
-            throw std::runtime_error("Failed to initialize MySQL");
-        }
-        
-        // Подключиться к БД
-        if (!mysql_real_connect(connection,
-                               host.c_str(),
-                               user.c_str(),
-                               password.c_str(),
-                               database.c_str(),
-                               3306, NULL, 0)) {
-            std::string error = std::string("MySQL Connection Error: ") + mysql_error(connection);
-            std::cerr << "ERROR: " << error << "\n";
-            mysql_close(connection);
-            throw std::runtime_error(error);
-        }
+        // Подключиться к primary
+        connection = openConnection(host, port);
         
         isConnected = true;
         std::cout << "[✓] Database connection established successfully!\n";
@@ -36,39 +29,458 @@ DatabaseConnection::DatabaseConnection(const std::string& host,
         std::cerr << "ERROR in DatabaseConnection constructor: " << e.what() << "\n";
         throw;
     }
+
+    watchdog = std::thread(&DatabaseConnection::watchdogLoop, this);
 }
 
 DatabaseConnection::~DatabaseConnection() {
     try {
+        DatabaseConnection* self = this;
+        interruptTarget.compare_exchange_strong(self, nullptr);
+        {
+            std::lock_guard<std::mutex> lock(watchdogMutex);
+            stopWatchdog = true;
+        }
+        watchdogWake.notify_all();
+        if (watchdog.joinable()) {
+            watchdog.join();
+        }
         disconnect();
     } catch (const std::exception& e) {
         std::cerr << "ERROR in ~DatabaseConnection: " << e.what() << "\n";
     }
 }
 
+MYSQL* DatabaseConnection::openConnection(const std::string& h, unsigned int p) {
+    // Инициализировать объект MYSQL
+    MYSQL* conn = mysql_init(NULL);
+
+    if (!conn) {
+        std::cerr << "ERROR: mysql_init failed!\n";
+        throw std::runtime_error("Failed to initialize MySQL");
+    }
+
+    // Без таймаутов зависший сервер блокирует весь TUI
+    mysql_options(conn, MYSQL_OPT_CONNECT_TIMEOUT, &options.connectTimeoutSec);
+    mysql_options(conn, MYSQL_OPT_READ_TIMEOUT, &options.readTimeoutSec);
+    mysql_options(conn, MYSQL_OPT_WRITE_TIMEOUT, &options.writeTimeoutSec);
+
+    if (!mysql_real_connect(conn,
+                           h.c_str(),
+                           user.c_str(),
+                           password.c_str(),
+                           database.c_str(),
+                           p, NULL, 0)) {
+        std::string error = std::string("MySQL Connection Error: ") + mysql_error(conn);
+        std::cerr << "ERROR: " << error << "\n";
+        mysql_close(conn);
+        throw std::runtime_error(error);
+    }
+
+    return conn;
+}
+
+bool DatabaseConnection::connect() {
+    try {
+        if (connection) {
+            mysql_close(connection);
+            connection = nullptr;
+        }
+        isConnected = false;
+
+        connection = openConnection(host, port);
+        isConnected = true;
+        if (consistency == ReadConsistency::GTID_WAIT) {
+            enableGtidTracking();
+        }
+        std::cout << "[✓] Database connection re-established!\n";
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in connect: " << e.what() << "\n";
+        return false;
+    }
+}
+
 bool DatabaseConnection::isActive() const {
     return isConnected && connection != nullptr;
 }
 
-bool DatabaseConnection::executeQuery(const std::string& query) {
+MYSQL* DatabaseConnection::getConnection() {
+    return connection;
+}
+
+CircuitBreaker::State DatabaseConnection::getBreakerState() const {
+    return breaker.getState();
+}
+
+bool DatabaseConnection::isConnectionError(unsigned int errorCode) {
+    return errorCode == CR_SERVER_GONE_ERROR
+        || errorCode == CR_SERVER_LOST
+        || errorCode == CR_CONN_HOST_ERROR
+        || errorCode == CR_CONNECTION_ERROR;
+}
+
+void DatabaseConnection::markPrimaryLost() {
+    if (isConnected) {
+        std::cerr << "[ℹ] Lost connection to database\n";
+    }
+    isConnected = false;
+}
+
+void DatabaseConnection::backoff(int attempt) {
+    // Экспоненциальная задержка с jitter, чтобы клиенты не долбили сервер разом
+    static thread_local std::mt19937 rng(std::random_device{}());
+    long long delay = static_cast<long long>(options.backoffBaseMs) << std::min(attempt, 20);
+    delay = std::min<long long>(delay, options.backoffMaxMs);
+    std::uniform_int_distribution<long long> jitter(delay / 2, std::max(delay, 1LL));
+    std::this_thread::sleep_for(std::chrono::milliseconds(jitter(rng)));
+}
+
+// ============= CANCELLATION =============
+
+void DatabaseConnection::beginInFlight(MYSQL* conn, const std::string& h, unsigned int p) {
+    std::lock_guard<std::mutex> lock(inFlightMutex);
+    inFlight.active = true;
+    inFlight.cancelled = false;
+    inFlight.host = h;
+    inFlight.port = p;
+    inFlight.threadId = mysql_thread_id(conn);
+    inFlight.startedAt = std::chrono::steady_clock::now();
+    queryRunning = true;
+}
+
+void DatabaseConnection::endInFlight() {
+    std::lock_guard<std::mutex> lock(inFlightMutex);
+    inFlight.active = false;
+    queryRunning = false;
+    interruptRequested = false;
+}
+
+int DatabaseConnection::runQuery(MYSQL* conn, const std::string& h, unsigned int p,
+                                 const std::string& query) {
+    beginInFlight(conn, h, p);
+    int result = mysql_query(conn, query.c_str());
+    endInFlight();
+    return result;
+}
+
+bool DatabaseConnection::killQuery(const std::string& h, unsigned int p, unsigned long threadId) {
+    // KILL QUERY идет по отдельному соединению: основное занято запросом
     try {
-        if (!isConnected || !connection) {
-            std::cerr << "ERROR: Database not connected!\n";
+        MYSQL* killer = openConnection(h, p);
+        std::string query = "KILL QUERY " + std::to_string(threadId) + ";";
+        bool ok = mysql_query(killer, query.c_str()) == 0;
+        if (!ok) {
+            std::cerr << "ERROR: KILL QUERY failed: " << mysql_error(killer) << "\n";
+        }
+        mysql_close(killer);
+        return ok;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in killQuery: " << e.what() << "\n";
+        return false;
+    }
+}
+
+bool DatabaseConnection::cancelCurrentQuery() {
+    std::string h;
+    unsigned int p = 0;
+    unsigned long threadId = 0;
+    {
+        std::lock_guard<std::mutex> lock(inFlightMutex);
+        if (!inFlight.active || inFlight.cancelled) {
             return false;
         }
+        inFlight.cancelled = true;
+        h = inFlight.host;
+        p = inFlight.port;
+        threadId = inFlight.threadId;
+    }
+    return killQuery(h, p, threadId);
+}
+
+void DatabaseConnection::cancelOnInterrupt(void (*onExit)()) {
+    interruptExitHook = onExit;
+    interruptTarget = this;
+    std::signal(SIGINT, &DatabaseConnection::handleInterrupt);
+}
+
+void DatabaseConnection::handleInterrupt(int signal) {
+    // Ctrl+C без активного запроса TUI - обычное завершение
+    DatabaseConnection* target = interruptTarget;
+    if (!target || !target->queryRunning) {
+        // SIG_DFL не вызывает atexit: терминал возвращаем в обычный режим здесь
+        if (interruptExitHook) {
+            interruptExitHook();
+        }
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+        return;
+    }
+    target->interruptRequested = true;
+    std::signal(signal, &DatabaseConnection::handleInterrupt);
+}
+
+void DatabaseConnection::watchdogLoop() {
+    std::unique_lock<std::mutex> lock(watchdogMutex);
+    while (!stopWatchdog) {
+        watchdogWake.wait_for(lock, std::chrono::milliseconds(100));
+        if (stopWatchdog) {
+            break;
+        }
+
+        bool expired = false;
+        {
+            std::lock_guard<std::mutex> flightLock(inFlightMutex);
+            if (inFlight.active && !inFlight.cancelled && options.queryTimeoutSec > 0) {
+                expired = std::chrono::steady_clock::now() - inFlight.startedAt
+                          >= std::chrono::seconds(options.queryTimeoutSec);
+            }
+        }
+
+        if (expired || interruptRequested.exchange(false)) {
+            lock.unlock();
+            if (cancelCurrentQuery()) {
+                std::cerr << "\n[ℹ] Query cancelled" << (expired ? " (timeout)" : "") << "\n";
+            }
+            lock.lock();
+        }
+    }
+}
+
+// ============= REPLICA ROUTING =============
+
+bool DatabaseConnection::addReplica(const std::string& replicaHost, unsigned int replicaPort) {
+    try {
+        MYSQL* conn = openConnection(replicaHost, replicaPort);
+        replicas.push_back({replicaHost, replicaPort, conn, true, {}});
+        std::cout << "[✓] Read replica " << replicaHost << ":" << replicaPort << " connected\n";
+        return true;
+    } catch (const std::exception& e) {
+        // Реплика недоступна - просто читаем с primary
+        std::cerr << "ERROR in addReplica: " << e.what() << "\n";
+        return false;
+    }
+}
+
+void DatabaseConnection::setReadConsistency(ReadConsistency mode) {
+    consistency = mode;
+    if (consistency == ReadConsistency::GTID_WAIT && isConnected) {
+        enableGtidTracking();
+    }
+}
+
+void DatabaseConnection::setReadYourWritesWindow(int milliseconds) {
+    readYourWritesWindow = std::chrono::milliseconds(milliseconds < 0 ? 0 : milliseconds);
+}
+
+size_t DatabaseConnection::getReplicaCount() const {
+    return replicas.size();
+}
+
+bool DatabaseConnection::isWithinWriteWindow() const {
+    return hasWritten && std::chrono::steady_clock::now() - lastWriteTime < readYourWritesWindow;
+}
+
+bool DatabaseConnection::isPinnedToPrimary() const {
+    return consistency == ReadConsistency::PIN_AFTER_WRITE && isWithinWriteWindow();
+}
+
+void DatabaseConnection::enableGtidTracking() {
+    // Сервер сам возвращает GTID каждой записи в ответе на нее, без лишнего SELECT
+    gtidTracking = runQuery(connection, host, port, "SET SESSION session_track_gtids = OWN_GTID;") == 0;
+    if (!gtidTracking) {
+        std::cerr << "[ℹ] session_track_gtids unavailable (" << mysql_error(connection)
+                  << "), using @@GLOBAL.gtid_executed\n";
+    }
+}
+
+std::string DatabaseConnection::trackedGtid() {
+    // Читается сразу после записи: следующий запрос сбросит данные трекера
+    std::string gtids;
+    const char* data = nullptr;
+    size_t length = 0;
+    if (mysql_session_track_get_first(connection, SESSION_TRACK_GTIDS, &data, &length) != 0) {
+        return gtids;
+    }
+    do {
+        if (!gtids.empty()) {
+            gtids += ',';
+        }
+        gtids.append(data, length);
+    } while (mysql_session_track_get_next(connection, SESSION_TRACK_GTIDS, &data, &length) == 0);
+    return gtids;
+}
+
+void DatabaseConnection::rememberWrite() {
+    hasWritten = true;
+    lastWriteTime = std::chrono::steady_clock::now();
+
+    if (consistency != ReadConsistency::GTID_WAIT || replicas.empty()) {
+        return;
+    }
+    ++writeSequence;
+
+    lastWriteGtid = gtidTracking ? trackedGtid() : "";
+    if (!lastWriteGtid.empty()) {
+        return;
+    }
+
+    // Без трекера - все выполненное на primary: оно включает и нашу запись.
+    // gtid_executed только глобальная (в MySQL 8 @@SESSION - ошибка)
+    MYSQL_RES* result = runSelect(connection, host, port, "SELECT @@GLOBAL.gtid_executed;");
+    if (!result) {
+        return;
+    }
+    MYSQL_ROW row = mysql_fetch_row(result);
+    lastWriteGtid = (row && row[0]) ? row[0] : "";
+    mysql_free_result(result);
+}
+
+bool DatabaseConnection::waitForGtid(ReplicaEndpoint& replica) {
+    if (!isWithinWriteWindow()) {
+        // Окно прошло - дальше реплики читаются без ожидания, как в режиме pin
+        lastWriteGtid.clear();
+        return true;
+    }
+    if (lastWriteGtid.empty()) {
+        // GTID записи неизвестен - до конца окна читаем с primary
+        return false;
+    }
+    if (replica.appliedWrite == writeSequence) {
+        return true;
+    }
+
+    // Ждем не дольше остатка окна: одно чтение не блокируется дольше окна,
+    // сколько бы реплик ни пришлось перебрать
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        lastWriteTime + readYourWritesWindow - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0) {
+        return false;
+    }
+    std::string query = "SELECT WAIT_FOR_EXECUTED_GTID_SET('" + lastWriteGtid + "', "
+                        + std::to_string(remaining.count() / 1000.0) + ");";
+    MYSQL_RES* result = runSelect(replica.connection, replica.host, replica.port, query);
+    if (!result) {
+        return false;
+    }
+    MYSQL_ROW row = mysql_fetch_row(result);
+    bool caughtUp = (row && row[0] && std::string(row[0]) == "0");
+    mysql_free_result(result);
+    if (caughtUp) {
+        // Реплика применила запись - следующие чтения с нее идут без ожидания
+        replica.appliedWrite = writeSequence;
+    }
+    return caughtUp;
+}
+
+MYSQL_RES* DatabaseConnection::runSelect(MYSQL* conn, const std::string& h, unsigned int p,
+                                         const std::string& query) {
+    if (runQuery(conn, h, p, query) != 0) {
+        std::cerr << "ERROR: Query failed: " << mysql_error(conn) << "\n";
+        return nullptr;
+    }
+
+    MYSQL_RES* resultSet = mysql_store_result(conn);
+    if (!resultSet) {
+        std::cerr << "ERROR: Failed to store result: " << mysql_error(conn) << "\n";
+    }
+    return resultSet;
+}
+
+MYSQL_RES* DatabaseConnection::getReadResult(const std::string& query) {
+    try {
+        if (replicas.empty() || primaryReads > 0 || isPinnedToPrimary()) {
+            return getQueryResult(query);
+        }
 
         if (query.empty()) {
             std::cerr << "ERROR: Empty query!\n";
+            return nullptr;
+        }
+
+        // Round-robin по живым репликам, при ошибке - следующая, в конце - primary
+        auto now = std::chrono::steady_clock::now();
+        for (size_t attempt = 0; attempt < replicas.size(); ++attempt) {
+            ReplicaEndpoint& replica = replicas[nextReplica];
+            nextReplica = (nextReplica + 1) % replicas.size();
+
+            if (!replica.isConnected) {
+                if (now < replica.retryAt) {
+                    continue;
+                }
+                try {
+                    if (replica.connection) {
+                        mysql_close(replica.connection);
+                    }
+                    replica.connection = openConnection(replica.host, replica.port);
+                    replica.isConnected = true;
+                } catch (const std::exception&) {
+                    replica.connection = nullptr;
+                    replica.retryAt = now + std::chrono::milliseconds(options.breakerCooldownMs);
+                    continue;
+                }
+            }
+            if (consistency == ReadConsistency::GTID_WAIT && !waitForGtid(replica)) {
+                continue;
+            }
+
+            MYSQL_RES* result = runSelect(replica.connection, replica.host, replica.port, query);
+            if (result) {
+                return result;
+            }
+            if (isConnectionError(mysql_errno(replica.connection))) {
+                replica.isConnected = false;
+                replica.retryAt = now + std::chrono::milliseconds(options.breakerCooldownMs);
+            }
+            std::cerr << "[ℹ] Replica " << replica.host << ":" << replica.port
+                      << " failed, trying next\n";
+        }
+
+        return getQueryResult(query);
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in getReadResult: " << e.what() << "\n";
+        return nullptr;
+    }
+}
+
+// ============= PRIMARY =============
+
+bool DatabaseConnection::executeQuery(const std::string& query) {
+    try {
+        if (query.empty()) {
+            std::cerr << "ERROR: Empty query!\n";
+            return false;
+        }
+
+        if (!breaker.allowRequest()) {
+            std::cerr << "ERROR: Database unavailable, failing fast (circuit open)\n";
             return false;
         }
 
-        int result = mysql_query(connection, query.c_str());
+        // Переподключаемся, но запись не повторяем: она не идемпотентна
+        if (!isConnected && !connect()) {
+            breaker.recordFailure();
+            return false;
+        }
+
+        int result = runQuery(connection, host, port, query);
         if (result != 0) {
             std::cerr << "ERROR: Query failed: " << mysql_error(connection) << "\n";
             std::cerr << "Query: " << query << "\n";
+            if (isConnectionError(mysql_errno(connection))) {
+                markPrimaryLost();
+                breaker.recordFailure();
+            } else {
+                // Сервер ответил ошибкой SQL - он доступен
+                breaker.recordSuccess();
+            }
             return false;
         }
 
+        // rememberWrite может выполнить SELECT, и mysql_insert_id обнулится
+        lastInsertId = mysql_insert_id(connection);
+        breaker.recordSuccess();
+        rememberWrite();
         return true;
     } catch (const std::exception& e) {
         std::cerr << "ERROR in executeQuery: " << e.what() << "\n";
@@ -76,31 +488,123 @@ bool DatabaseConnection::executeQuery(const std::string& query) {
     }
 }
 
-MYSQL_RES* DatabaseConnection::getQueryResult(const std::string& query) {
+unsigned long long DatabaseConnection::getLastInsertId() const {
+    return lastInsertId;
+}
+
+bool DatabaseConnection::executeTransaction(const std::vector<std::string>& statements,
+                                            std::vector<unsigned long long>* insertIds) {
     try {
-        if (!isConnected || !connection) {
-            std::cerr << "ERROR: Database not connected!\n";
-            return nullptr;
+        if (statements.empty()) {
+            std::cerr << "ERROR: Empty transaction!\n";
+            return false;
+        }
+
+        if (!breaker.allowRequest()) {
+            std::cerr << "ERROR: Database unavailable, failing fast (circuit open)\n";
+            return false;
+        }
+
+        if (!isConnected && !connect()) {
+            breaker.recordFailure();
+            return false;
         }
 
+        if (insertIds) {
+            insertIds->clear();
+        }
+        if (runQuery(connection, host, port, "START TRANSACTION") != 0) {
+            std::cerr << "ERROR: START TRANSACTION failed: " << mysql_error(connection) << "\n";
+            if (isConnectionError(mysql_errno(connection))) {
+                markPrimaryLost();
+                breaker.recordFailure();
+            } else {
+                breaker.recordSuccess();
+            }
+            return false;
+        }
+
+        for (const std::string& query : statements) {
+            if (runQuery(connection, host, port, query) != 0) {
+                std::cerr << "ERROR: Query failed: " << mysql_error(connection) << "\n";
+                std::cerr << "Query: " << query << "\n";
+                // Соединение потеряно - сервер откатит транзакцию сам
+                if (isConnectionError(mysql_errno(connection))) {
+                    markPrimaryLost();
+                    breaker.recordFailure();
+                } else {
+                    breaker.recordSuccess();
+                    runQuery(connection, host, port, "ROLLBACK");
+                }
+                return false;
+            }
+            lastInsertId = mysql_insert_id(connection);
+            if (insertIds) {
+                insertIds->push_back(lastInsertId);
+            }
+        }
+
+        if (runQuery(connection, host, port, "COMMIT") != 0) {
+            std::cerr << "ERROR: COMMIT failed: " << mysql_error(connection) << "\n";
+            if (isConnectionError(mysql_errno(connection))) {
+                markPrimaryLost();
+                breaker.recordFailure();
+            } else {
+                breaker.recordSuccess();
+                runQuery(connection, host, port, "ROLLBACK");
+            }
+            return false;
+        }
+
+        breaker.recordSuccess();
+        rememberWrite();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in executeTransaction: " << e.what() << "\n";
+        return false;
+    }
+}
+
+MYSQL_RES* DatabaseConnection::getQueryResult(const std::string& query) {
+    try {
         if (query.empty()) {
             std::cerr << "ERROR: Empty query!\n";
             return nullptr;
         }
 
-        int result = mysql_query(connection, query.c_str());
-        if (result != 0) {
-            std::cerr << "ERROR: Query failed: " << mysql_error(connection) << "\n";
-            return nullptr;
-        }
+        // Чтение идемпотентно: переподключаемся и повторяем с backoff
+        for (int attempt = 0; attempt <= options.maxRetries; ++attempt) {
+            if (!breaker.allowRequest()) {
+                std::cerr << "ERROR: Database unavailable, failing fast (circuit open)\n";
+                return nullptr;
+            }
 
-        MYSQL_RES* resultSet = mysql_store_result(connection);
-        if (!resultSet) {
-            std::cerr << "ERROR: Failed to store result: " << mysql_error(connection) << "\n";
-            return nullptr;
+            if (attempt > 0) {
+                backoff(attempt - 1);
+            }
+
+            if (!isConnected && !connect()) {
+                breaker.recordFailure();
+                continue;
+            }
+
+            MYSQL_RES* resultSet = runSelect(connection, host, port, query);
+            if (resultSet) {
+                breaker.recordSuccess();
+                return resultSet;
+            }
+
+            if (!isConnectionError(mysql_errno(connection))) {
+                // Сервер ответил ошибкой SQL - повтор не поможет
+                breaker.recordSuccess();
+                return nullptr;
+            }
+
+            markPrimaryLost();
+            breaker.recordFailure();
         }
 
-        return resultSet;
+        return nullptr;
     } catch (const std::exception& e) {
         std::cerr << "ERROR in getQueryResult: " << e.what() << "\n";
         return nullptr;
@@ -119,7 +623,15 @@ void DatabaseConnection::freeResult(MYSQL_RES* result) {
 
 void DatabaseConnection::disconnect() {
     try {
-        if (isConnected && connection) {
+        for (auto& replica : replicas) {
+            if (replica.connection) {
+                mysql_close(replica.connection);
+                replica.connection = nullptr;
+                replica.isConnected = false;
+            }
+        }
+
+        if (connection) {
             mysql_close(connection);
             connection = nullptr;
             isConnected = false;
@@ -130,10 +642,36 @@ void DatabaseConnection::disconnect() {
     }
 }
 
+std::string DatabaseConnection::escapeString(const std::string& value) {
+    if (connection && isConnected) {
+        std::string escaped(value.size() * 2 + 1, '\0');
+        unsigned long length = mysql_real_escape_string(connection, &escaped[0], value.c_str(),
+                                                        static_cast<unsigned long>(value.size()));
+        escaped.resize(length);
+        return escaped;
+    }
+
+    // Нет соединения - экранируем сами те же символы, что и libmysql
+    std::string escaped;
+    escaped.reserve(value.size() + 8);
+    for (char c : value) {
+        switch (c) {
+            case '\0':   escaped += "\\0"; break;
+            case '\n':   escaped += "\\n"; break;
+            case '\r':   escaped += "\\r"; break;
+            case '\x1a': escaped += "\\Z"; break;
+            case '\\':   escaped += "\\\\"; break;
+            case '\'':   escaped += "\\'"; break;
+            case '"':    escaped += "\\\""; break;
+            default:     escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
 std::string DatabaseConnection::getLastError() const {
     if (connection) {
         return std::string(mysql_error(connection));
     }
     return "Connection not initialized";
 }
-
@@ -0,0 +1,113 @@
+#include "../headers/EntityLoader.hpp"
+#include <iostream>
+#include <stdexcept>
+
+EntityLoader::EntityLoader(std::shared_ptr<User> user, std::shared_ptr<Game> game,
+                           std::shared_ptr<Platform> platform)
+    : userMgr(user), gameMgr(game), platformMgr(platform) {
+    if (!userMgr || !gameMgr || !platformMgr) {
+        throw std::runtime_error("ERROR: Null pointers passed to EntityLoader constructor!");
+    }
+}
+
+void EntityLoader::requestUser(int userId) {
+    if (userId > 0 && users.find(userId) == users.end()) {
+        pendingUsers.insert(userId);
+    }
+}
+
+void EntityLoader::requestGame(int gameId) {
+    if (gameId > 0 && games.find(gameId) == games.end()) {
+        pendingGames.insert(gameId);
+    }
+}
+
+void EntityLoader::requestPlatform(int platformId) {
+    if (platformId > 0 && platforms.find(platformId) == platforms.end()) {
+        pendingPlatforms.insert(platformId);
+    }
+}
+
+void EntityLoader::load() {
+    try {
+        if (!pendingUsers.empty()) {
+            std::vector<int> ids(pendingUsers.begin(), pendingUsers.end());
+            for (auto& user : userMgr->getUsersByIds(ids)) {
+                users[user.idUser] = std::move(user);
+            }
+            pendingUsers.clear();
+        }
+        if (!pendingGames.empty()) {
+            std::vector<int> ids(pendingGames.begin(), pendingGames.end());
+            for (auto& game : gameMgr->getGamesByIds(ids)) {
+                games[game.idGame] = std::move(game);
+            }
+            pendingGames.clear();
+        }
+        if (!pendingPlatforms.empty()) {
+            std::vector<int> ids(pendingPlatforms.begin(), pendingPlatforms.end());
+            for (auto& platform : platformMgr->getPlatformsByIds(ids)) {
+                platforms[platform.idPlatform] = std::move(platform);
+            }
+            pendingPlatforms.clear();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in EntityLoader::load: " << e.what() << "\n";
+    }
+}
+
+void EntityLoader::reset() {
+    pendingUsers.clear();
+    pendingGames.clear();
+    pendingPlatforms.clear();
+    users.clear();
+    games.clear();
+    platforms.clear();
+}
+
+const UserData* EntityLoader::findUser(int userId) const {
+    auto it = users.find(userId);
+    return it != users.end() ? &it->second : nullptr;
+}
+
+const GameData* EntityLoader::findGame(int gameId) const {
+    auto it = games.find(gameId);
+    return it != games.end() ? &it->second : nullptr;
+}
+
+const PlatformData* EntityLoader::findPlatform(int platformId) const {
+    auto it = platforms.find(platformId);
+    return it != platforms.end() ? &it->second : nullptr;
+}
+
+std::string EntityLoader::userName(int userId) const {
+    const UserData* user = findUser(userId);
+    return user ? user->username : "#" + std::to_string(userId);
+}
+
+std::string EntityLoader::gameName(int gameId) const {
+    const GameData* game = findGame(gameId);
+    return game ? game->name : "#" + std::to_string(gameId);
+}
+
+std::string EntityLoader::platformName(int platformId) const {
+    const PlatformData* platform = findPlatform(platformId);
+    return platform ? platform->platformName : "#" + std::to_string(platformId);
+}
+
+std::vector<ReviewView> EntityLoader::joinReviews(const std::vector<ReviewData>& reviews) {
+    for (const auto& review : reviews) {
+        requestUser(review.idUser);
+        requestGame(review.idGame);
+        requestPlatform(review.idPlatform);
+    }
+    load();
+
+    std::vector<ReviewView> views;
+    views.reserve(reviews.size());
+    for (const auto& review : reviews) {
+        views.push_back({review, userName(review.idUser), gameName(review.idGame),
+                         platformName(review.idPlatform)});
+    }
+    return views;
+}
@@ -0,0 +1,78 @@
+#include "../headers/EntityPicker.hpp"
+#include <algorithm>
+#include <iomanip>
+
+// Строки экрана вокруг списка совпадений
+static const int PICKER_CHROME_ROWS = 10;
+
+EntityPicker::EntityPicker(const FuzzyIndex& index, const std::string& title)
+    : index(index), title(title) {
+}
+
+void EntityPicker::eraseLastChar(std::string& text) {
+    // Удаляем целый символ UTF-8, а не последний байт
+    while (!text.empty()) {
+        unsigned char c = static_cast<unsigned char>(text.back());
+        text.pop_back();
+        if ((c & 0xC0) != 0x80) {
+            break;
+        }
+    }
+}
+
+int EntityPicker::pick(ScreenRenderer& screen, TerminalInput& input) {
+    std::string query;
+    int cursor = 0;
+
+    while (true) {
+        int termRows, termCols;
+        ScreenRenderer::getTerminalSize(termRows, termCols);
+        size_t visible = static_cast<size_t>(std::max(termRows - PICKER_CHROME_ROWS, 3));
+
+        std::vector<FuzzyMatch> matches = index.search(query, visible);
+        cursor = std::max(0, std::min(cursor, static_cast<int>(matches.size()) - 1));
+
+        screen.beginFrame();
+        std::ostream& out = screen.frame();
+        out << "\n════════════════════════════════════════════════\n";
+        out << " " << title << "\n";
+        out << "════════════════════════════════════════════════\n";
+        out << " Search: " << query << "▌\n";
+        out << "────────────────────────────────────────────────\n";
+        if (matches.empty()) {
+            out << "[ℹ] Nothing found.\n";
+        }
+        for (size_t i = 0; i < matches.size(); ++i) {
+            out << (static_cast<int>(i) == cursor ? "▶ " : "  ")
+                << std::left << std::setw(7) << matches[i].id << *matches[i].name << "\n";
+        }
+        out << "────────────────────────────────────────────────\n";
+        out << " " << matches.size() << " shown of " << index.size() << "\n";
+        out << "[Type to filter] [↑/↓ Move] [Enter Choose] [ESC Cancel]\n";
+        screen.present();
+
+        KeyEvent key = input.readKey();
+        switch (key.code) {
+            case KeyCode::ESCAPE:
+                return -1;
+            case KeyCode::ENTER:
+                if (!matches.empty()) {
+                    return matches[cursor].id;
+                }
+                break;
+            case KeyCode::UP: cursor--; break;
+            case KeyCode::DOWN: cursor++; break;
+            case KeyCode::HOME: cursor = 0; break;
+            case KeyCode::END: cursor = static_cast<int>(matches.size()) - 1; break;
+            case KeyCode::BACKSPACE:
+                eraseLastChar(query);
+                cursor = 0;
+                break;
+            case KeyCode::CHAR:
+                query += key.text;
+                cursor = 0;
+                break;
+            default: break;
+        }
+    }
+}
@@ -0,0 +1,19 @@
+#include "../headers/EventBus.hpp"
+
+const char* changeTypeName(ChangeType type) {
+    switch (type) {
+        case ChangeType::INSERTED: return "INSERT";
+        case ChangeType::UPDATED: return "UPDATE";
+        case ChangeType::DELETED: return "DELETE";
+        default: return "";
+    }
+}
+
+void EventBus::unsubscribe(int subscription) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& channel : channels) {
+        if (channel.second->remove(subscription)) {
+            return;
+        }
+    }
+}
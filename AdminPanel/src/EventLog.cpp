@@ -0,0 +1,355 @@
+#include "../headers/EventLog.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Тело записи: фиксированная часть, затем table, changeType, createdDate, payload
+struct RecordFields {
+    uint64_t eventId;
+    int32_t rowId;
+    int32_t rowId2;
+    uint16_t tableLength;
+    uint16_t typeLength;
+    uint16_t createdLength;
+    uint16_t reserved;
+    uint32_t payloadLength;
+};
+
+// Прочитать одну запись с текущей позиции; false - конец или неполная/битая запись
+bool readRecord(std::istream& in, EventLog::RecordHeader& header, std::string& body) {
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    if (header.length < sizeof(RecordFields)) {
+        return false;
+    }
+    body.resize(header.length);
+    if (!in.read(&body[0], header.length)) {
+        return false;
+    }
+    return EventLog::crc32(body.data(), body.size()) == header.crc;
+}
+
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+}
+
+// ============= Формат =============
+
+uint32_t EventLog::crc32(const char* data, size_t length) {
+    static const std::vector<uint32_t> table = []() {
+        std::vector<uint32_t> entries(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+            }
+            entries[i] = value;
+        }
+        return entries;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; ++i) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void EventLog::encode(const LogRecord& record, std::string& out) {
+    RecordFields fields{};
+    fields.eventId = record.eventId;
+    fields.rowId = record.rowId;
+    fields.rowId2 = record.rowId2;
+    fields.tableLength = static_cast<uint16_t>(std::min<size_t>(record.table.size(), UINT16_MAX));
+    fields.typeLength = static_cast<uint16_t>(std::min<size_t>(record.changeType.size(), UINT16_MAX));
+    fields.createdLength = static_cast<uint16_t>(std::min<size_t>(record.createdDate.size(), UINT16_MAX));
+    fields.payloadLength = static_cast<uint32_t>(record.payload.size());
+
+    std::string body(reinterpret_cast<const char*>(&fields), sizeof(fields));
+    body.append(record.table, 0, fields.tableLength);
+    body.append(record.changeType, 0, fields.typeLength);
+    body.append(record.createdDate, 0, fields.createdLength);
+    body.append(record.payload);
+
+    RecordHeader header{static_cast<uint32_t>(body.size()), crc32(body.data(), body.size()), record.offset};
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(body);
+}
+
+bool EventLog::decode(const RecordHeader& header, const std::string& body, LogRecord& record) {
+    if (body.size() != header.length || body.size() < sizeof(RecordFields) ||
+        crc32(body.data(), body.size()) != header.crc) {
+        return false;
+    }
+    RecordFields fields;
+    std::memcpy(&fields, body.data(), sizeof(fields));
+    size_t expected = sizeof(fields) + fields.tableLength + fields.typeLength + fields.createdLength +
+                      static_cast<size_t>(fields.payloadLength);
+    if (expected != body.size()) {
+        return false;
+    }
+
+    const char* cursor = body.data() + sizeof(fields);
+    record.offset = header.offset;
+    record.eventId = fields.eventId;
+    record.rowId = fields.rowId;
+    record.rowId2 = fields.rowId2;
+    record.table.assign(cursor, fields.tableLength);
+    cursor += fields.tableLength;
+    record.changeType.assign(cursor, fields.typeLength);
+    cursor += fields.typeLength;
+    record.createdDate.assign(cursor, fields.createdLength);
+    cursor += fields.createdLength;
+    record.payload.assign(cursor, fields.payloadLength);
+    return true;
+}
+
+std::string EventLog::segmentPath(const std::string& dir, uint64_t baseOffset) {
+    std::ostringstream name;
+    name << std::setw(20) << std::setfill('0') << baseOffset << ".log";
+    return (fs::path(dir) / name.str()).string();
+}
+
+std::vector<uint64_t> EventLog::listSegments(const std::string& dir) {
+    std::vector<uint64_t> bases;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(dir, error)) {
+        const fs::path& path = entry.path();
+        std::string stem = path.stem().string();
+        if (path.extension() == ".log" && stem.size() == 20 &&
+            std::all_of(stem.begin(), stem.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            bases.push_back(std::stoull(stem));
+        }
+    }
+    std::sort(bases.begin(), bases.end());
+    return bases;
+}
+
+// ============= Писатель =============
+
+EventLog::EventLog(const std::string& dir, uint64_t maxSegmentBytes)
+    : directory(dir), segmentBytes(maxSegmentBytes > 0 ? maxSegmentBytes : DEFAULT_SEGMENT_BYTES) {
+    try {
+        fs::create_directories(directory);
+        recover();
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in EventLog: " << e.what() << "\n";
+    }
+}
+
+EventLog::~EventLog() {
+    if (segment) {
+        std::fclose(segment);
+    }
+}
+
+bool EventLog::openSegment(uint64_t baseOffset) {
+    if (segment) {
+        std::fclose(segment);
+    }
+    std::string path = segmentPath(directory, baseOffset);
+    segment = std::fopen(path.c_str(), "ab");
+    if (!segment) {
+        std::cerr << "ERROR in EventLog: cannot open " << path << "\n";
+        return false;
+    }
+    std::error_code error;
+    segmentSize = fs::file_size(path, error);
+    return true;
+}
+
+bool EventLog::recover() {
+    if (segment) {
+        std::fclose(segment);
+        segment = nullptr;
+    }
+    tailEventIds.clear();
+
+    std::vector<uint64_t> bases = listSegments(directory);
+    if (bases.empty()) {
+        nextOffset = 0;
+        return openSegment(0);
+    }
+
+    while (true) {
+        uint64_t base = bases.back();
+        std::string path = segmentPath(directory, base);
+        std::ifstream in(path, std::ios::binary);
+        uint64_t offset = base;
+        uint64_t validBytes = 0;
+        RecordHeader header;
+        std::string body;
+        while (readRecord(in, header, body) && header.offset == offset) {
+            RecordFields fields;
+            std::memcpy(&fields, body.data(), sizeof(fields));
+            tailEventIds.insert(fields.eventId);
+            ++offset;
+            validBytes += sizeof(header) + header.length;
+        }
+        in.close();
+
+        // Хвост после сбоя во время записи
+        if (validBytes < fs::file_size(path)) {
+            std::cerr << "[!] EventLog: truncating damaged tail of " << path << "\n";
+            fs::resize_file(path, validBytes);
+        }
+        // Пустой сегмент, созданный перед сбоем, - продолжаем предыдущий
+        if (validBytes == 0 && bases.size() > 1) {
+            fs::remove(path);
+            bases.pop_back();
+            continue;
+        }
+        nextOffset = offset;
+        return openSegment(base);
+    }
+}
+
+bool EventLog::append(std::vector<LogRecord>& records) {
+    if (records.empty()) {
+        return true;
+    }
+    if (!segment && !recover()) {
+        return false;
+    }
+
+    std::string buffer;
+    uint64_t offset = nextOffset;
+    for (LogRecord& record : records) {
+        record.offset = offset++;
+        encode(record, buffer);
+    }
+
+    // Новый сегмент - только между пачками
+    if (segmentSize > 0 && segmentSize + buffer.size() > segmentBytes && !openSegment(nextOffset)) {
+        return false;
+    }
+
+    if (std::fwrite(buffer.data(), 1, buffer.size(), segment) != buffer.size() || !syncFile(segment)) {
+        std::cerr << "ERROR in EventLog::append: write failed\n";
+        // При следующей записи хвост будет обрезан до последней целой записи
+        std::fclose(segment);
+        segment = nullptr;
+        return false;
+    }
+    segmentSize += buffer.size();
+    nextOffset = offset;
+    return true;
+}
+
+// ============= Читатель =============
+
+EventLogReader::EventLogReader(const std::string& dir, const std::string& consumerName)
+    : directory(dir), consumer(consumerName) {
+    std::ifstream in(offsetPath());
+    if (!(in >> committed)) {
+        committed = 0;
+    }
+}
+
+std::string EventLogReader::offsetPath() const {
+    return (fs::path(directory) / "consumers" / (consumer + ".offset")).string();
+}
+
+bool EventLogReader::openSegmentFor(uint64_t offset) {
+    std::vector<uint64_t> bases = EventLog::listSegments(directory);
+    auto it = std::upper_bound(bases.begin(), bases.end(), offset);
+    if (it == bases.begin()) {
+        return false;
+    }
+    uint64_t base = *(it - 1);
+
+    segment.close();
+    segment.clear();
+    segment.open(EventLog::segmentPath(directory, base), std::ios::binary);
+    if (!segment.is_open()) {
+        return false;
+    }
+    segmentBase = base;
+
+    // Пропускаем записи до offset по заголовкам
+    EventLog::RecordHeader header;
+    for (uint64_t current = base; current < offset; ++current) {
+        if (!segment.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.offset != current) {
+            segment.clear();
+            return false;
+        }
+        segment.seekg(header.length, std::ios::cur);
+    }
+    return true;
+}
+
+bool EventLogReader::seek(uint64_t offset) {
+    positioned = openSegmentFor(offset);
+    position = offset;
+    return positioned;
+}
+
+bool EventLogReader::next(LogRecord& record) {
+    if (!positioned && !seek(position < committed ? committed : position)) {
+        return false;
+    }
+
+    std::streampos start = segment.tellg();
+    EventLog::RecordHeader header;
+    std::string body;
+    if (readRecord(segment, header, body) && header.offset == position &&
+        EventLog::decode(header, body, record)) {
+        ++position;
+        return true;
+    }
+
+    // Конец сегмента: продолжение в следующем, если писатель его уже начал
+    segment.clear();
+    std::vector<uint64_t> bases = EventLog::listSegments(directory);
+    if (std::binary_search(bases.begin(), bases.end(), position) && position != segmentBase) {
+        return seek(position) && next(record);
+    }
+    // Запись еще дописывается - прочитаем ее в следующий раз
+    segment.seekg(start);
+    return false;
+}
+
+bool EventLogReader::commit() {
+    try {
+        fs::path path = offsetPath();
+        fs::create_directories(path.parent_path());
+        fs::path tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream out(tmpPath, std::ios::trunc);
+            out << position << "\n";
+            if (!out.flush()) {
+                return false;
+            }
+        }
+        fs::rename(tmpPath, path);
+        committed = position;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in EventLogReader::commit: " << e.what() << "\n";
+        return false;
+    }
+}
@@ -0,0 +1,171 @@
+#include "../headers/FuzzyIndex.hpp"
+#include <algorithm>
+#include <cctype>
+
+void FuzzyIndex::add(int id, const std::string& name) {
+    entries.push_back({id, name, foldCase(name)});
+}
+
+void FuzzyIndex::clear() {
+    entries.clear();
+    byName.clear();
+    trigrams.clear();
+    idToEntry.clear();
+}
+
+size_t FuzzyIndex::size() const {
+    return entries.size();
+}
+
+std::string FuzzyIndex::foldCase(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c < 0x80) {
+            result += static_cast<char>(std::tolower(c));
+            continue;
+        }
+        // Кириллица в UTF-8: А-П (D0 90-9F) -> а-п, Р-Я (D0 A0-AF) -> р-я (D1 80-8F), Ё -> ё
+        if (c == 0xD0 && i + 1 < text.size()) {
+            unsigned char next = static_cast<unsigned char>(text[i + 1]);
+            if (next >= 0x90 && next <= 0x9F) {
+                result += static_cast<char>(0xD0);
+                result += static_cast<char>(next + 0x20);
+                ++i;
+                continue;
+            }
+            if (next >= 0xA0 && next <= 0xAF) {
+                result += static_cast<char>(0xD1);
+                result += static_cast<char>(next - 0x20);
+                ++i;
+                continue;
+            }
+            if (next == 0x81) {
+                result += static_cast<char>(0xD1);
+                result += static_cast<char>(0x91);
+                ++i;
+                continue;
+            }
+        }
+        result += static_cast<char>(c);
+    }
+    return result;
+}
+
+std::vector<uint32_t> FuzzyIndex::extractTrigrams(const std::string& padded) {
+    std::vector<uint32_t> result;
+    for (size_t i = 0; i + 3 <= padded.size(); ++i) {
+        uint32_t key = (static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16)
+                     | (static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8)
+                     | static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2]));
+        result.push_back(key);
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void FuzzyIndex::build() {
+    byName.resize(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        byName[i] = static_cast<int>(i);
+    }
+    std::sort(byName.begin(), byName.end(), [this](int a, int b) {
+        return entries[a].folded < entries[b].folded;
+    });
+
+    trigrams.clear();
+    idToEntry.clear();
+    for (size_t i = 0; i < entries.size(); ++i) {
+        idToEntry[entries[i].id] = static_cast<int>(i);
+        for (uint32_t key : extractTrigrams(" " + entries[i].folded + " ")) {
+            trigrams[key].push_back(static_cast<int>(i));
+        }
+    }
+}
+
+std::vector<FuzzyMatch> FuzzyIndex::search(const std::string& query, size_t limit) const {
+    std::vector<FuzzyMatch> matches;
+    std::string folded = foldCase(query);
+    while (!folded.empty() && folded.back() == ' ') folded.pop_back();
+    while (!folded.empty() && folded.front() == ' ') folded.erase(0, 1);
+
+    if (folded.empty()) {
+        for (size_t i = 0; i < byName.size() && matches.size() < limit; ++i) {
+            const Entry& entry = entries[byName[i]];
+            matches.push_back({entry.id, &entry.name, 0.0});
+        }
+        return matches;
+    }
+
+    // Плотные массивы вместо хеш-таблиц: поиск идет на каждое нажатие
+    std::vector<double> scores(entries.size(), 0.0);
+    std::vector<int> touched;
+    auto raise = [&](int index, double score) {
+        if (scores[index] == 0.0) touched.push_back(index);
+        scores[index] = std::max(scores[index], score);
+    };
+
+    // Точное совпадение по ID, если ввели число
+    if (std::all_of(folded.begin(), folded.end(), [](char c) { return c >= '0' && c <= '9'; })
+        && folded.size() < 10) {
+        auto byId = idToEntry.find(std::stoi(folded));
+        if (byId != idToEntry.end()) {
+            raise(byId->second, 10.0);
+        }
+    }
+
+    // Префикс: бинарный поиск по отсортированным именам
+    auto first = std::lower_bound(byName.begin(), byName.end(), folded,
+                                  [this](int index, const std::string& value) {
+                                      return entries[index].folded < value;
+                                  });
+    for (auto it = first; it != byName.end(); ++it) {
+        if (entries[*it].folded.compare(0, folded.size(), folded) != 0) {
+            break;
+        }
+        raise(*it, 3.0);
+    }
+
+    // Триграммы: конец запроса не дополняем пробелом - пользователь еще печатает
+    std::vector<uint32_t> queryTrigrams = extractTrigrams(" " + folded);
+    if (!queryTrigrams.empty()) {
+        std::vector<uint16_t> shared(entries.size(), 0);
+        std::vector<int> candidates;
+        for (uint32_t key : queryTrigrams) {
+            auto postings = trigrams.find(key);
+            if (postings == trigrams.end()) continue;
+            for (int index : postings->second) {
+                if (shared[index]++ == 0) candidates.push_back(index);
+            }
+        }
+        double total = static_cast<double>(queryTrigrams.size());
+        for (int index : candidates) {
+            double similarity = shared[index] / total;
+            if (similarity < 0.3) continue;
+            double bonus = entries[index].folded.find(folded) != std::string::npos ? 1.0 : 0.0;
+            raise(index, similarity + bonus);
+        }
+    } else {
+        // Один символ - триграмм нет, ищем подстроку
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].folded.find(folded) != std::string::npos) {
+                raise(static_cast<int>(i), 1.0);
+            }
+        }
+    }
+
+    matches.reserve(touched.size());
+    for (int index : touched) {
+        matches.push_back({entries[index].id, &entries[index].name, scores[index]});
+    }
+    size_t keep = std::min(limit, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + keep, matches.end(),
+                      [](const FuzzyMatch& a, const FuzzyMatch& b) {
+                          if (a.score != b.score) return a.score > b.score;
+                          return *a.name < *b.name;
+                      });
+    matches.resize(keep);
+    return matches;
+}
@@ -0,0 +1,687 @@
+#include "../headers/GameApi.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include "../headers/FuzzyIndex.hpp"
+#include "../headers/JsonWriter.hpp"
+#include "../headers/ResultSet.hpp"
+#include "../headers/User.hpp"
+#include "../headers/Game.hpp"
+#include "../headers/Platform.hpp"
+#include "../headers/Review.hpp"
+
+namespace {
+
+void columnString(JsonWriter& json, const char* name, const RowView& row, unsigned int index) {
+    json.key(name);
+    if (row.isNull(index)) {
+        json.null();
+    } else {
+        json.value(row.text(index));
+    }
+}
+
+// Целые колонки: текст MySQL уже является числом JSON
+void columnNumber(JsonWriter& json, const char* name, const RowView& row, unsigned int index) {
+    json.key(name);
+    json.raw(row.isNull(index) ? std::string_view("null") : row.text(index));
+}
+
+// DATETIME -> Date -> JSON.stringify, как у mysql2 (часовой пояс сервера - UTC)
+void columnDate(JsonWriter& json, const char* name, const RowView& row, unsigned int index) {
+    json.key(name);
+    std::string_view value = row.isNull(index) ? std::string_view() : row.text(index);
+    if (value.size() < 19 || value.substr(0, 4) == "0000") {
+        json.null();
+        return;
+    }
+    char iso[27];
+    value.copy(iso + 1, 10, 0);
+    value.copy(iso + 12, 8, 11);
+    iso[0] = '"';
+    iso[11] = 'T';
+    std::string_view(".000Z\"").copy(iso + 20, 6);
+    json.raw(std::string_view(iso, 26));
+}
+
+// DATETIME в UTC -> секунды UNIX; -1 - пусто или нулевая дата
+int64_t parseDateTime(std::string_view value) {
+    if (value.size() < 19 || value.substr(0, 4) == "0000") {
+        return -1;
+    }
+    auto number = [value](size_t start, size_t length) {
+        int result = 0;
+        for (size_t i = start; i < start + length; ++i) {
+            result = result * 10 + (value[i] - '0');
+        }
+        return result;
+    };
+    int year = number(0, 4);
+    int month = number(5, 2);
+    int day = number(8, 2);
+    // Дни от 1970-01-01 по григорианскому календарю (алгоритм days_from_civil)
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    int64_t days = static_cast<int64_t>(era) * 146097 + dayOfEra - 719468;
+    return days * 86400 + number(11, 2) * 3600 + number(14, 2) * 60 + number(17, 2);
+}
+
+// Объект списка игры с дополнительными полями: listJson без '}' + поля extra
+std::string withFields(const std::string& listJson, const std::string& extra) {
+    return listJson.substr(0, listJson.size() - 1) + "," + extra.substr(1);
+}
+
+// DECIMAL со scale 4, как AVG(Mark) в MySQL
+std::string formatAvgMark(int64_t scaled) {
+    std::string fraction = std::to_string(scaled % 10000);
+    return std::to_string(scaled / 10000) + "." + std::string(4 - fraction.size(), '0') + fraction;
+}
+
+// Ключ поиска и сортировки по имени, как LIKE и ORDER BY под utf8mb4_unicode_ci
+// в Node API: регистр латиницы и кириллицы не различается, Ё = Е
+std::string foldName(std::string_view value) {
+    std::string folded = FuzzyIndex::foldCase(std::string(value));
+    for (size_t i = 0; i + 1 < folded.size(); ++i) {
+        // ё (D1 91) -> е (D0 B5); 0xD1 не бывает продолжением символа UTF-8
+        if (static_cast<unsigned char>(folded[i]) == 0xD1 && static_cast<unsigned char>(folded[i + 1]) == 0x91) {
+            folded[i] = static_cast<char>(0xD0);
+            folded[i + 1] = static_cast<char>(0xB5);
+            ++i;
+        }
+    }
+    return folded;
+}
+
+// Сравнение строки с INT в MySQL идет по числовому префиксу: "5abc" = 5, "abc" = 0
+double numericValue(const std::string& value) {
+    return std::strtod(value.c_str(), nullptr);
+}
+
+bool toId(const std::string& value, int& id) {
+    double number = numericValue(value);
+    if (number != std::floor(number) || std::fabs(number) > 2147483647.0) {
+        return false;
+    }
+    id = static_cast<int>(number);
+    return true;
+}
+
+// "1,2,3"; пусто - фильтра нет; false - ни одного числа
+bool parseIdList(const std::string& value, std::vector<int>& ids) {
+    size_t start = 0;
+    while (start < value.size()) {
+        size_t end = value.find(',', start);
+        if (end == std::string::npos) end = value.size();
+        int id = 0;
+        if (end > start && toId(value.substr(start, end - start), id)) {
+            ids.push_back(id);
+        }
+        start = end + 1;
+    }
+    return value.empty() || !ids.empty();
+}
+
+void errorResponse(HttpResponse& response, int status, const char* message) {
+    response.status = status;
+    response.body = std::string("{\"error\":\"") + message + "\"}";
+}
+
+}
+
+GameApi::GameApi(std::vector<std::string> origins) : allowedOrigins(std::move(origins)) {}
+
+void GameApi::setTrending(double halfLifeSeconds, size_t candidates) {
+    trending = TrendingGames(halfLifeSeconds, candidates);
+    lastTrendingReview = 0;
+}
+
+size_t GameApi::getGameCount() const {
+    std::shared_ptr<const ApiSnapshot> data = std::atomic_load(&snapshot);
+    return data ? data->games.size() : 0;
+}
+
+bool GameApi::reload(Game& gameMgr, Review& reviewMgr, Platform& platformMgr, User& userMgr) {
+    try {
+        std::shared_ptr<ApiSnapshot> data = std::make_shared<ApiSnapshot>();
+
+        std::unordered_map<int, std::string> categoryNames;
+        ResultSet categories = gameMgr.scanAllCategories();
+        if (!categories) {
+            return false;
+        }
+        for (const RowView& row : categories) {
+            categoryNames[row.asInt(0)] = row.toString(1);
+        }
+
+        // Платформа: имя для списка и готовый объект для карточки игры
+        std::unordered_map<int, std::pair<std::string, std::string>> platforms;
+        ResultSet platformRows = platformMgr.scanAllPlatforms();
+        if (!platformRows) {
+            return false;
+        }
+        for (const RowView& row : platformRows) {
+            std::string object;
+            JsonWriter json(object);
+            json.beginObject();
+            columnNumber(json, "idPlatform", row, 0);
+            columnString(json, "Platform_name", row, 1);
+            columnString(json, "Type", row, 2);
+            json.endObject();
+            platforms[row.asInt(0)] = {row.toString(1), std::move(object)};
+        }
+
+        std::unordered_map<int, std::string> usernames;
+        ResultSet users = userMgr.scanUsernames();
+        if (!users) {
+            return false;
+        }
+        for (const RowView& row : users) {
+            usernames[row.asInt(0)] = row.toString(1);
+        }
+
+        // Агрегаты отзывов: COUNT считает все активные, AVG - только с оценкой
+        struct Aggregate {
+            int reviewCount = 0;
+            int markCount = 0;
+            int64_t markSum = 0;
+            std::vector<int> platformIds;
+        };
+        std::unordered_map<int, Aggregate> aggregates;
+        // Отзывы, которых trending еще не видел; категория игры известна только после списка игр
+        struct NewReview {
+            int idReview;
+            int idGame;
+            int idPlatform;
+            int mark;
+            int64_t time;
+        };
+        std::vector<NewReview> newReviews;
+        ResultSet reviews = reviewMgr.scanActiveReviews();
+        if (!reviews) {
+            return false;
+        }
+        for (const RowView& row : reviews) {
+            int gameId = row.asInt(2);
+            int platformId = row.asInt(3);
+            Aggregate& aggregate = aggregates[gameId];
+            aggregate.reviewCount++;
+            if (!row.isNull(5)) {
+                aggregate.markCount++;
+                aggregate.markSum += row.asInt(5);
+            }
+            aggregate.platformIds.push_back(platformId);
+            int reviewId = row.asInt(0);
+            if (reviewId > lastTrendingReview) {
+                int64_t time = row.isNull(6) ? -1 : parseDateTime(row.text(6));
+                if (time >= 0) {
+                    newReviews.push_back({reviewId, gameId, platformId, row.isNull(5) ? 0 : row.asInt(5), time});
+                }
+            }
+
+            // INNER JOIN user, platform
+            auto user = usernames.find(row.asInt(1));
+            auto platform = platforms.find(platformId);
+            if (user == usernames.end() || platform == platforms.end()) {
+                continue;
+            }
+            std::string& list = data->reviewsJson[gameId];
+            list += list.empty() ? '[' : ',';
+            JsonWriter json(list);
+            json.beginObject();
+            columnNumber(json, "idReview", row, 0);
+            columnNumber(json, "idUser", row, 1);
+            columnNumber(json, "idGame", row, 2);
+            columnNumber(json, "idPlatform", row, 3);
+            columnString(json, "Review_text", row, 4);
+            columnNumber(json, "Mark", row, 5);
+            columnDate(json, "ReviewDate", row, 6);
+            columnString(json, "Validation", row, 7);
+            json.key("Username");
+            json.value(user->second);
+            json.key("Platform_name");
+            json.value(platform->second.first);
+            json.endObject();
+        }
+        for (auto& entry : data->reviewsJson) {
+            entry.second += ']';
+        }
+
+        ResultSet games = gameMgr.scanGameListing();
+        if (!games) {
+            return false;
+        }
+        for (const RowView& row : games) {
+            if (row.isNull(9) || row.asInt(9) != 1) {
+                continue;
+            }
+            ApiSnapshot::GameEntry game;
+            game.idGame = row.asInt(0);
+            game.idCategory = row.asInt(6);
+            game.hasYear = !row.isNull(2);
+            game.releaseYear = game.hasYear ? row.asInt(2) : 0;
+            game.nameFolded = foldName(row.text(1));
+
+            Aggregate& aggregate = aggregates[game.idGame];
+            game.reviewCount = aggregate.reviewCount;
+            if (aggregate.markCount > 0) {
+                // Округление половины от нуля, оценки неотрицательные
+                game.avgMark = (aggregate.markSum * 20000 + aggregate.markCount) / (2 * aggregate.markCount);
+            }
+            std::sort(aggregate.platformIds.begin(), aggregate.platformIds.end());
+            aggregate.platformIds.erase(std::unique(aggregate.platformIds.begin(), aggregate.platformIds.end()),
+                                        aggregate.platformIds.end());
+            data->facets.addGame(game.idGame, game.idCategory, game.hasYear, game.releaseYear, game.avgMark);
+            for (int platformId : aggregate.platformIds) {
+                data->facets.addReviewPlatform(game.idGame, platformId);
+            }
+
+            auto category = categoryNames.find(game.idCategory);
+            std::string avgMark = formatAvgMark(game.avgMark);
+
+            // Список (game_summary): GROUP_CONCAT(DISTINCT Platform_name)
+            std::vector<std::string_view> platformNames;
+            std::vector<const std::string*> platformObjects;
+            for (int platformId : aggregate.platformIds) {
+                auto platform = platforms.find(platformId);
+                if (platform == platforms.end()) {
+                    continue;
+                }
+                platformNames.push_back(platform->second.first);
+                platformObjects.push_back(&platform->second.second);
+            }
+            std::sort(platformNames.begin(), platformNames.end());
+
+            JsonWriter list(game.listJson);
+            list.beginObject();
+            columnNumber(list, "idGame", row, 0);
+            columnString(list, "Name", row, 1);
+            columnNumber(list, "Release_year", row, 2);
+            columnString(list, "Description", row, 3);
+            columnString(list, "Production_cost", row, 5);
+            columnNumber(list, "idCategory", row, 6);
+            columnDate(list, "CreatedDate", row, 7);
+            columnString(list, "ImageURL", row, 4);
+            list.key("CategoryName");
+            if (category == categoryNames.end()) {
+                list.null();
+            } else {
+                list.value(category->second);
+            }
+            list.key("AvgMark");
+            list.value(avgMark);
+            list.key("reviewCount");
+            list.value(game.reviewCount);
+            list.key("platforms");
+            if (platformNames.empty()) {
+                list.null();
+            } else {
+                std::string joined;
+                for (std::string_view name : platformNames) {
+                    if (!joined.empty()) joined += ',';
+                    joined += name;
+                }
+                list.value(joined);
+            }
+            list.endObject();
+
+            // Карточка: g.*, CategoryName, AvgMark, reviewCount, platforms[]
+            std::string detail;
+            JsonWriter card(detail);
+            card.beginObject();
+            columnNumber(card, "idGame", row, 0);
+            columnString(card, "Name", row, 1);
+            columnNumber(card, "Release_year", row, 2);
+            columnString(card, "Description", row, 3);
+            columnString(card, "ImageURL", row, 4);
+            columnString(card, "Production_cost", row, 5);
+            columnNumber(card, "idCategory", row, 6);
+            columnDate(card, "CreatedDate", row, 7);
+            columnDate(card, "UpdatedDate", row, 8);
+            columnNumber(card, "IsActive", row, 9);
+            card.key("CategoryName");
+            if (category == categoryNames.end()) {
+                card.null();
+            } else {
+                card.value(category->second);
+            }
+            card.key("AvgMark");
+            card.value(avgMark);
+            card.key("reviewCount");
+            card.value(game.reviewCount);
+            card.key("platforms");
+            card.beginArray();
+            for (const std::string* object : platformObjects) {
+                card.raw(*object);
+            }
+            card.endArray();
+            card.endObject();
+            data->detailJson[game.idGame] = std::move(detail);
+
+            data->gameIndex[game.idGame] = data->games.size();
+            data->games.push_back(std::move(game));
+        }
+
+        // Платформы, на которых игра продается
+        ResultSet links = platformMgr.scanAllGamePlatforms();
+        if (!links) {
+            return false;
+        }
+        for (const RowView& row : links) {
+            if (data->gameIndex.count(row.asInt(0))) {
+                data->facets.addAvailablePlatform(row.asInt(0), row.asInt(1));
+            }
+        }
+
+        for (const NewReview& review : newReviews) {
+            auto game = data->gameIndex.find(review.idGame);
+            int categoryId = game == data->gameIndex.end() ? 0 : data->games[game->second].idCategory;
+            trending.add(review.idGame, categoryId, review.idPlatform, review.mark, review.time);
+            lastTrendingReview = std::max(lastTrendingReview, review.idReview);
+        }
+
+        // Готовые элементы trending: только активные игры, счет на момент reload
+        int64_t now = static_cast<int64_t>(std::time(nullptr));
+        auto renderTrending = [&](TrendingGames::Scope scope, int scopeId) {
+            std::vector<std::string> items;
+            for (const TrendingGame& game : trending.top(scope, scopeId, trending.getCandidates(), now)) {
+                auto entry = data->gameIndex.find(game.gameId);
+                if (entry == data->gameIndex.end()) {
+                    continue;
+                }
+                std::string extra;
+                JsonWriter fields(extra);
+                fields.beginObject();
+                fields.key("trendingScore");
+                fields.value(std::round(game.score * 1000) / 1000);
+                fields.key("recentAvgMark");
+                if (game.avgMark > 0) {
+                    fields.value(std::round(game.avgMark * 10000) / 10000);
+                } else {
+                    fields.null();
+                }
+                fields.endObject();
+                items.push_back(withFields(data->games[entry->second].listJson, extra));
+            }
+            return items;
+        };
+        data->trending = renderTrending(TrendingGames::ALL, 0);
+        for (int categoryId : trending.scopeIds(TrendingGames::CATEGORY)) {
+            data->trendingByCategory[categoryId] = renderTrending(TrendingGames::CATEGORY, categoryId);
+        }
+        for (int platformId : trending.scopeIds(TrendingGames::PLATFORM)) {
+            data->trendingByPlatform[platformId] = renderTrending(TrendingGames::PLATFORM, platformId);
+        }
+
+        // Порядки ORDER BY из routes/games.js; при равенстве - по idGame
+        const std::vector<ApiSnapshot::GameEntry>& all = data->games;
+        std::vector<uint32_t> order(all.size());
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        auto byId = [&all](uint32_t a, uint32_t b) { return all[a].idGame < all[b].idGame; };
+
+        data->byRating = order;
+        std::sort(data->byRating.begin(), data->byRating.end(), [&](uint32_t a, uint32_t b) {
+            if (all[a].avgMark != all[b].avgMark) return all[a].avgMark > all[b].avgMark;
+            if (all[a].reviewCount != all[b].reviewCount) return all[a].reviewCount > all[b].reviewCount;
+            return byId(a, b);
+        });
+        // NULL в MySQL меньше любого числа: при DESC идут последними
+        data->byNewest = order;
+        std::sort(data->byNewest.begin(), data->byNewest.end(), [&](uint32_t a, uint32_t b) {
+            if (all[a].hasYear != all[b].hasYear) return all[a].hasYear;
+            if (all[a].releaseYear != all[b].releaseYear) return all[a].releaseYear > all[b].releaseYear;
+            return byId(a, b);
+        });
+        data->byName = order;
+        std::sort(data->byName.begin(), data->byName.end(), [&](uint32_t a, uint32_t b) {
+            if (all[a].nameFolded != all[b].nameFolded) return all[a].nameFolded < all[b].nameFolded;
+            return byId(a, b);
+        });
+        data->byReviews = order;
+        std::sort(data->byReviews.begin(), data->byReviews.end(), [&](uint32_t a, uint32_t b) {
+            if (all[a].reviewCount != all[b].reviewCount) return all[a].reviewCount > all[b].reviewCount;
+            return byId(a, b);
+        });
+
+        JsonWriter defaultList(data->defaultList);
+        defaultList.beginArray();
+        for (uint32_t index : data->byRating) {
+            defaultList.raw(all[index].listJson);
+        }
+        defaultList.endArray();
+
+        std::atomic_store(&snapshot, std::shared_ptr<const ApiSnapshot>(std::move(data)));
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in GameApi::reload: " << e.what() << "\n";
+        return false;
+    }
+}
+
+// false - фильтр заведомо пуст (ID не число)
+bool GameApi::parseFilter(const ApiSnapshot& data, const HttpRequest& request, GameFacets::Filter& filter,
+                          RoaringBitmap& names) const {
+    std::string category = request.queryParam("category");
+    std::string platform = request.queryParam("platform");
+    std::string search = request.queryParam("search");
+    std::string minRating = request.queryParam("minRating");
+    int id = 0;
+
+    if (!category.empty()) {
+        if (!toId(category, id)) return false;
+        filter.categories.push_back(id);
+    }
+    if (!platform.empty()) {
+        if (!toId(platform, id)) return false;
+        filter.reviewedOn.push_back(id);
+    }
+    // Только у этого сервера: списки через запятую, OR внутри параметра
+    if (!parseIdList(request.queryParam("available"), filter.availableOn) ||
+        !parseIdList(request.queryParam("year"), filter.years)) {
+        return false;
+    }
+    if (!minRating.empty()) {
+        filter.minRating = numericValue(minRating);
+    }
+    // Подстрока не индексируется: один проход по именам
+    if (!search.empty()) {
+        std::string folded = foldName(search);
+        for (const ApiSnapshot::GameEntry& game : data.games) {
+            if (game.nameFolded.find(folded) != std::string::npos) {
+                names.add(static_cast<uint32_t>(game.idGame));
+            }
+        }
+        filter.only = &names;
+    }
+    return true;
+}
+
+void GameApi::listGames(const ApiSnapshot& data, const HttpRequest& request, HttpResponse& response) const {
+    GameFacets::Filter filter;
+    RoaringBitmap names;
+    bool possible = parseFilter(data, request, filter, names);
+    std::string sortBy = request.queryParam("sortBy");
+
+    if (possible && filter.isEmpty() && (sortBy.empty() || sortBy == "rating")) {
+        response.body = data.defaultList;
+        return;
+    }
+
+    const std::vector<uint32_t>* order = &data.byRating;
+    if (sortBy == "newest") order = &data.byNewest;
+    else if (sortBy == "name") order = &data.byName;
+    else if (sortBy == "reviews") order = &data.byReviews;
+
+    RoaringBitmap selected = possible ? data.facets.select(filter) : RoaringBitmap();
+    size_t averageSize = data.defaultList.size() / std::max<size_t>(data.games.size(), 1);
+    response.body.reserve(static_cast<size_t>(selected.cardinality()) * averageSize + 2);
+
+    JsonWriter body(response.body);
+    body.beginArray();
+    if (!selected.empty()) {
+        for (uint32_t index : *order) {
+            const ApiSnapshot::GameEntry& game = data.games[index];
+            if (selected.contains(static_cast<uint32_t>(game.idGame))) {
+                body.raw(game.listJson);
+            }
+        }
+    }
+    body.endArray();
+}
+
+void GameApi::countFacets(const ApiSnapshot& data, const HttpRequest& request, HttpResponse& response) const {
+    GameFacets::Filter filter;
+    RoaringBitmap names;
+    GameFacets::Counts counts;
+    if (parseFilter(data, request, filter, names)) {
+        counts = data.facets.count(filter);
+    }
+
+    JsonWriter json(response.body);
+    auto values = [&json](const char* name, const std::vector<std::pair<int, uint64_t>>& entries) {
+        json.key(name);
+        json.beginArray();
+        for (const auto& entry : entries) {
+            json.beginObject();
+            json.key("value");
+            json.value(entry.first);
+            json.key("count");
+            json.value(static_cast<unsigned long long>(entry.second));
+            json.endObject();
+        }
+        json.endArray();
+    };
+    json.beginObject();
+    json.key("total");
+    json.value(static_cast<unsigned long long>(counts.total));
+    values("categories", counts.categories);
+    values("platforms", counts.reviewedOn);
+    values("available", counts.availableOn);
+    values("years", counts.years);
+    values("ratings", counts.ratings);
+    json.endObject();
+}
+
+void GameApi::listTrending(const ApiSnapshot& data, const HttpRequest& request, HttpResponse& response) const {
+    std::string category = request.queryParam("category");
+    std::string platform = request.queryParam("platform");
+    std::string limit = request.queryParam("limit");
+    int id = 0;
+
+    const std::vector<std::string>* items = &data.trending;
+    static const std::vector<std::string> none;
+    if (!category.empty() && !platform.empty()) {
+        errorResponse(response, 400, "Use either category or platform");
+        return;
+    }
+    if (!category.empty() || !platform.empty()) {
+        const auto& index = category.empty() ? data.trendingByPlatform : data.trendingByCategory;
+        auto it = toId(category.empty() ? platform : category, id) ? index.find(id) : index.end();
+        items = it == index.end() ? &none : &it->second;
+    }
+
+    size_t count = std::min<size_t>(items->size(), 10);
+    if (!limit.empty() && toId(limit, id) && id > 0) {
+        count = std::min(items->size(), static_cast<size_t>(id));
+    }
+
+    JsonWriter body(response.body);
+    body.beginArray();
+    for (size_t i = 0; i < count; ++i) {
+        body.raw((*items)[i]);
+    }
+    body.endArray();
+}
+
+void GameApi::applyCors(const HttpRequest& request, HttpResponse& response) const {
+    std::string_view origin = request.header("Origin");
+    if (!origin.empty() &&
+        std::find(allowedOrigins.begin(), allowedOrigins.end(), origin) != allowedOrigins.end()) {
+        response.headers.emplace_back("Access-Control-Allow-Origin", std::string(origin));
+    }
+    response.headers.emplace_back("Vary", "Origin");
+    response.headers.emplace_back("Access-Control-Allow-Credentials", "true");
+}
+
+void GameApi::handle(const HttpRequest& request, HttpResponse& response) const {
+    applyCors(request, response);
+
+    // Preflight отвечает так же, как пакет cors у Node
+    if (request.method == "OPTIONS") {
+        response.contentType.clear();
+        response.headers.emplace_back("Access-Control-Allow-Methods", "GET,HEAD,PUT,PATCH,POST,DELETE");
+        std::string_view requested = request.header("Access-Control-Request-Headers");
+        if (!requested.empty()) {
+            response.headers.emplace_back("Access-Control-Allow-Headers", std::string(requested));
+        }
+        return;
+    }
+    if (request.method != "GET" && request.method != "HEAD") {
+        response.headers.emplace_back("Allow", "GET, HEAD");
+        errorResponse(response, 405, "Method not allowed");
+        return;
+    }
+
+    std::string_view path = request.path;
+    if (path.size() > 1 && path.back() == '/') {
+        path.remove_suffix(1);
+    }
+
+    if (path == "/api/health") {
+        response.body = "{\"status\":\"ok\",\"message\":\"Server is running\"}";
+        return;
+    }
+
+    std::shared_ptr<const ApiSnapshot> data = std::atomic_load(&snapshot);
+    if (!data) {
+        errorResponse(response, 503, "Service unavailable");
+        return;
+    }
+
+    const std::string_view GAMES = "/api/games";
+    const std::string_view GAME_REVIEWS = "/api/reviews/game/";
+
+    if (path == GAMES) {
+        listGames(*data, request, response);
+        return;
+    }
+    if (path == "/api/games/facets") {
+        countFacets(*data, request, response);
+        return;
+    }
+    if (path == "/api/games/trending") {
+        listTrending(*data, request, response);
+        return;
+    }
+
+    if (path.substr(0, GAMES.size() + 1) == "/api/games/" &&
+        path.find('/', GAMES.size() + 1) == std::string_view::npos) {
+        int gameId = 0;
+        auto it = toId(std::string(path.substr(GAMES.size() + 1)), gameId)
+                      ? data->detailJson.find(gameId) : data->detailJson.end();
+        if (it == data->detailJson.end()) {
+            errorResponse(response, 404, "Game not found");
+            return;
+        }
+        response.body = it->second;
+        return;
+    }
+
+    if (path.substr(0, GAME_REVIEWS.size()) == GAME_REVIEWS &&
+        path.size() > GAME_REVIEWS.size() &&
+        path.find('/', GAME_REVIEWS.size()) == std::string_view::npos) {
+        int gameId = 0;
+        auto it = toId(std::string(path.substr(GAME_REVIEWS.size())), gameId)
+                      ? data->reviewsJson.find(gameId) : data->reviewsJson.end();
+        response.body = it == data->reviewsJson.end() ? "[]" : it->second;
+        return;
+    }
+
+    errorResponse(response, 404, "Not found");
+}
@@ -0,0 +1,168 @@
+#include "../headers/GameFacets.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const RoaringBitmap EMPTY;
+
+void countValues(const std::map<int, RoaringBitmap>& index, const RoaringBitmap& base,
+                 std::vector<std::pair<int, uint64_t>>& out) {
+    for (const auto& entry : index) {
+        uint64_t count = RoaringBitmap::intersectCount(base, entry.second);
+        if (count > 0) {
+            out.emplace_back(entry.first, count);
+        }
+    }
+}
+}
+
+void GameFacets::addGame(int gameId, int categoryId, bool hasYear, int releaseYear, int64_t avgMark) {
+    uint32_t id = static_cast<uint32_t>(gameId);
+    all.add(id);
+    byCategory[categoryId].add(id);
+    if (hasYear) {
+        byYear[releaseYear].add(id);
+    }
+    int bucket = static_cast<int>(std::min<int64_t>(std::max<int64_t>(avgMark / 10000, 0), RATING_BUCKETS - 1));
+    byRating[bucket].add(id);
+    avgMarks[id] = avgMark;
+}
+
+void GameFacets::addReviewPlatform(int gameId, int platformId) {
+    byReviewPlatform[platformId].add(static_cast<uint32_t>(gameId));
+}
+
+void GameFacets::addAvailablePlatform(int gameId, int platformId) {
+    byAvailablePlatform[platformId].add(static_cast<uint32_t>(gameId));
+}
+
+void GameFacets::clear() {
+    all.clear();
+    byCategory.clear();
+    byReviewPlatform.clear();
+    byAvailablePlatform.clear();
+    byYear.clear();
+    for (RoaringBitmap& bucket : byRating) {
+        bucket.clear();
+    }
+    avgMarks.clear();
+}
+
+const RoaringBitmap& GameFacets::category(int categoryId) const {
+    auto it = byCategory.find(categoryId);
+    return it == byCategory.end() ? EMPTY : it->second;
+}
+
+RoaringBitmap GameFacets::anyOf(const std::map<int, RoaringBitmap>& index, const std::vector<int>& values) {
+    RoaringBitmap result;
+    for (int value : values) {
+        auto it = index.find(value);
+        if (it != index.end()) {
+            result = result.empty() ? it->second : RoaringBitmap::unite(result, it->second);
+        }
+    }
+    return result;
+}
+
+RoaringBitmap GameFacets::ratingAtLeast(double minRating) const {
+    if (minRating <= 0) {
+        return all;
+    }
+    RoaringBitmap result;
+    int partial = static_cast<int>(std::floor(minRating));
+    for (int bucket = std::max(partial + 1, 0); bucket < RATING_BUCKETS; ++bucket) {
+        result = RoaringBitmap::unite(result, byRating[bucket]);
+    }
+    // В корзине floor(minRating) проходит только часть игр
+    if (partial >= 0 && partial < RATING_BUCKETS) {
+        RoaringBitmap matching;
+        byRating[partial].forEach([&](uint32_t id) {
+            if (avgMarks.at(id) / 10000.0 >= minRating) {
+                matching.add(id);
+            }
+        });
+        result = RoaringBitmap::unite(result, matching);
+    }
+    return result;
+}
+
+void GameFacets::resolve(const Filter& filter, RoaringBitmap (&sets)[DIMENSIONS],
+                         bool (&active)[DIMENSIONS]) const {
+    active[CATEGORY] = !filter.categories.empty();
+    active[REVIEWED_ON] = !filter.reviewedOn.empty();
+    active[AVAILABLE_ON] = !filter.availableOn.empty();
+    active[YEAR] = !filter.years.empty();
+    active[RATING] = filter.minRating > 0;
+    active[ONLY] = filter.only != nullptr;
+
+    if (active[CATEGORY]) sets[CATEGORY] = anyOf(byCategory, filter.categories);
+    if (active[REVIEWED_ON]) sets[REVIEWED_ON] = anyOf(byReviewPlatform, filter.reviewedOn);
+    if (active[AVAILABLE_ON]) sets[AVAILABLE_ON] = anyOf(byAvailablePlatform, filter.availableOn);
+    if (active[YEAR]) sets[YEAR] = anyOf(byYear, filter.years);
+    if (active[RATING]) sets[RATING] = ratingAtLeast(filter.minRating);
+    if (active[ONLY]) sets[ONLY] = *filter.only;
+}
+
+RoaringBitmap GameFacets::combine(const RoaringBitmap (&sets)[DIMENSIONS], const bool (&active)[DIMENSIONS],
+                                  int skip) const {
+    // Сначала самые маленькие множества: промежуточные результаты быстрее пустеют
+    std::vector<int> order;
+    for (int dimension = 0; dimension < DIMENSIONS; ++dimension) {
+        if (active[dimension] && dimension != skip) {
+            order.push_back(dimension);
+        }
+    }
+    if (order.empty()) {
+        return all;
+    }
+    std::sort(order.begin(), order.end(), [&sets](int a, int b) {
+        return sets[a].cardinality() < sets[b].cardinality();
+    });
+    RoaringBitmap result = sets[order[0]];
+    for (size_t i = 1; i < order.size() && !result.empty(); ++i) {
+        result = RoaringBitmap::intersect(result, sets[order[i]]);
+    }
+    return result;
+}
+
+RoaringBitmap GameFacets::select(const Filter& filter) const {
+    RoaringBitmap sets[DIMENSIONS];
+    bool active[DIMENSIONS];
+    resolve(filter, sets, active);
+    return combine(sets, active, -1);
+}
+
+GameFacets::Counts GameFacets::count(const Filter& filter) const {
+    RoaringBitmap sets[DIMENSIONS];
+    bool active[DIMENSIONS];
+    resolve(filter, sets, active);
+
+    Counts counts;
+    counts.total = combine(sets, active, -1).cardinality();
+    countValues(byCategory, combine(sets, active, CATEGORY), counts.categories);
+    countValues(byReviewPlatform, combine(sets, active, REVIEWED_ON), counts.reviewedOn);
+    countValues(byAvailablePlatform, combine(sets, active, AVAILABLE_ON), counts.availableOn);
+    countValues(byYear, combine(sets, active, YEAR), counts.years);
+
+    RoaringBitmap base = combine(sets, active, RATING);
+    for (int bucket = 0; bucket < RATING_BUCKETS; ++bucket) {
+        uint64_t count = RoaringBitmap::intersectCount(base, byRating[bucket]);
+        if (count > 0) {
+            counts.ratings.emplace_back(bucket, count);
+        }
+    }
+    return counts;
+}
+
+size_t GameFacets::memoryUsage() const {
+    size_t total = all.memoryUsage();
+    for (const auto* index : {&byCategory, &byReviewPlatform, &byAvailablePlatform, &byYear}) {
+        for (const auto& entry : *index) {
+            total += sizeof(entry) + entry.second.memoryUsage();
+        }
+    }
+    for (const RoaringBitmap& bucket : byRating) {
+        total += bucket.memoryUsage();
+    }
+    return total + avgMarks.size() * (sizeof(uint32_t) + sizeof(int64_t));
+}
@@ -0,0 +1,416 @@
+#include "../headers/GameRecommender.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace {
+const char FILE_MAGIC[8] = {'G', 'R', 'R', 'E', 'C', 'O', 'M', '\0'};
+const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+// Игры раздаются потокам пачками: меньше обращений к общему счетчику
+const uint32_t GAMES_PER_TASK = 64;
+
+uint64_t fnv1a(uint64_t hash, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+struct MarkEntry {
+    int32_t user;
+    int32_t game;
+    float mark;
+};
+
+// Разреженная матрица в CSR: строка r - столбцы index[offsets[r] .. offsets[r + 1])
+struct SparseRows {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> index;
+    std::vector<float> value;
+};
+
+// Сумма произведений и число общих оценщиков рядом - одно обращение к памяти на пару
+struct Accumulator {
+    float dot;
+    uint32_t common;
+};
+
+struct Neighbor {
+    uint32_t game;
+    float similarity;
+};
+}
+
+uint32_t GameRecommender::gameIndex(int gameId) const {
+    auto it = std::lower_bound(gameIds.begin(), gameIds.end(), gameId);
+    return (it != gameIds.end() && *it == gameId) ? static_cast<uint32_t>(it - gameIds.begin()) : UINT32_MAX;
+}
+
+bool GameRecommender::build(ResultSet markRows, uint32_t neighborsPerGame, unsigned threads) {
+    try {
+        std::vector<MarkEntry> marks;
+        marks.reserve(static_cast<size_t>(markRows.getRowCount()));
+        for (const RowView& row : markRows) {
+            if (!row.isNull(2)) {
+                marks.push_back({row.asInt(0), row.asInt(1), static_cast<float>(row.asInt(2))});
+            }
+        }
+        if (marks.empty()) {
+            return false;
+        }
+
+        // Отзывы одного пользователя на одну игру (разные платформы) - одна усредненная оценка
+        std::sort(marks.begin(), marks.end(), [](const MarkEntry& a, const MarkEntry& b) {
+            return a.user != b.user ? a.user < b.user : a.game < b.game;
+        });
+        size_t unique = 0;
+        for (size_t i = 0; i < marks.size();) {
+            size_t j = i;
+            float sum = 0;
+            while (j < marks.size() && marks[j].user == marks[i].user && marks[j].game == marks[i].game) {
+                sum += marks[j++].mark;
+            }
+            marks[unique++] = {marks[i].user, marks[i].game, sum / static_cast<float>(j - i)};
+            i = j;
+        }
+        marks.resize(unique);
+
+        std::vector<int32_t> ids;
+        ids.reserve(marks.size());
+        for (const MarkEntry& entry : marks) {
+            ids.push_back(entry.game);
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        uint32_t gameCount = static_cast<uint32_t>(ids.size());
+
+        // Строки пользователей (оценки уже по пользователю) с вычтенным средним пользователя.
+        // У пользователя с одной оценкой после центрирования нули - он ничего не дает
+        SparseRows byUser;
+        byUser.offsets.push_back(0);
+        for (size_t i = 0; i < marks.size();) {
+            size_t j = i;
+            double sum = 0;
+            while (j < marks.size() && marks[j].user == marks[i].user) {
+                sum += marks[j++].mark;
+            }
+            if (j - i > 1) {
+                float mean = static_cast<float>(sum / static_cast<double>(j - i));
+                for (size_t k = i; k < j; ++k) {
+                    byUser.index.push_back(static_cast<uint32_t>(
+                        std::lower_bound(ids.begin(), ids.end(), marks[k].game) - ids.begin()));
+                    byUser.value.push_back(marks[k].mark - mean);
+                }
+                byUser.offsets.push_back(static_cast<uint32_t>(byUser.index.size()));
+            }
+            i = j;
+        }
+        marks.clear();
+        marks.shrink_to_fit();
+        uint32_t userCount = static_cast<uint32_t>(byUser.offsets.size() - 1);
+
+        // Транспонирование подсчетом: столбцы игр со списком оценщиков
+        SparseRows byGame;
+        byGame.offsets.assign(gameCount + 1, 0);
+        for (uint32_t game : byUser.index) {
+            byGame.offsets[game + 1]++;
+        }
+        for (uint32_t g = 0; g < gameCount; ++g) {
+            byGame.offsets[g + 1] += byGame.offsets[g];
+        }
+        byGame.index.resize(byUser.index.size());
+        byGame.value.resize(byUser.index.size());
+        std::vector<uint32_t> next(byGame.offsets.begin(), byGame.offsets.end() - 1);
+        for (uint32_t u = 0; u < userCount; ++u) {
+            for (uint32_t k = byUser.offsets[u]; k < byUser.offsets[u + 1]; ++k) {
+                uint32_t slot = next[byUser.index[k]]++;
+                byGame.index[slot] = u;
+                byGame.value[slot] = byUser.value[k];
+            }
+        }
+
+        std::vector<float> norms(gameCount, 0.0f);
+        for (uint32_t g = 0; g < gameCount; ++g) {
+            double sum = 0;
+            for (uint32_t k = byGame.offsets[g]; k < byGame.offsets[g + 1]; ++k) {
+                sum += static_cast<double>(byGame.value[k]) * byGame.value[k];
+            }
+            norms[g] = static_cast<float>(std::sqrt(sum));
+        }
+
+        // Строка i матрицы сходства = сумма строк пользователей, оценивших i (с весом их оценки i).
+        // Каждый поток держит свой плотный аккумулятор и список затронутых игр.
+        std::vector<std::vector<Neighbor>> lists(gameCount);
+        std::atomic<uint32_t> nextGame(0);
+        auto worker = [&]() {
+            std::vector<Accumulator> acc(gameCount, Accumulator{0.0f, 0});
+            std::vector<uint32_t> touched;
+            std::vector<Neighbor> candidates;
+            while (true) {
+                uint32_t first = nextGame.fetch_add(GAMES_PER_TASK);
+                if (first >= gameCount) {
+                    return;
+                }
+                uint32_t last = std::min(gameCount, first + GAMES_PER_TASK);
+                for (uint32_t i = first; i < last; ++i) {
+                    touched.clear();
+                    for (uint32_t k = byGame.offsets[i]; k < byGame.offsets[i + 1]; ++k) {
+                        uint32_t u = byGame.index[k];
+                        float weight = byGame.value[k];
+                        for (uint32_t m = byUser.offsets[u]; m < byUser.offsets[u + 1]; ++m) {
+                            uint32_t j = byUser.index[m];
+                            if (j == i) {
+                                continue;
+                            }
+                            if (acc[j].common++ == 0) {
+                                touched.push_back(j);
+                            }
+                            acc[j].dot += weight * byUser.value[m];
+                        }
+                    }
+
+                    candidates.clear();
+                    for (uint32_t j : touched) {
+                        if (acc[j].common >= MIN_COMMON_USERS && norms[i] > 0 && norms[j] > 0) {
+                            float similarity = acc[j].dot / (norms[i] * norms[j]);
+                            if (similarity > 0) {
+                                candidates.push_back({j, similarity});
+                            }
+                        }
+                        acc[j] = {0.0f, 0};
+                    }
+                    auto better = [](const Neighbor& a, const Neighbor& b) {
+                        return a.similarity != b.similarity ? a.similarity > b.similarity : a.game < b.game;
+                    };
+                    if (candidates.size() > neighborsPerGame) {
+                        std::nth_element(candidates.begin(), candidates.begin() + neighborsPerGame,
+                                         candidates.end(), better);
+                        candidates.resize(neighborsPerGame);
+                    }
+                    std::sort(candidates.begin(), candidates.end(), better);
+                    lists[i] = candidates;
+                }
+            }
+        };
+
+        unsigned threadCount = threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threadCount; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+
+        std::vector<uint32_t> newOffsets(1, 0);
+        std::vector<uint32_t> newNeighbors;
+        std::vector<float> newSimilarities;
+        for (const std::vector<Neighbor>& list : lists) {
+            for (const Neighbor& neighbor : list) {
+                newNeighbors.push_back(neighbor.game);
+                newSimilarities.push_back(neighbor.similarity);
+            }
+            newOffsets.push_back(static_cast<uint32_t>(newNeighbors.size()));
+        }
+
+        gameIds = std::move(ids);
+        offsets = std::move(newOffsets);
+        neighbors = std::move(newNeighbors);
+        similarities = std::move(newSimilarities);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in GameRecommender::build: " << e.what() << "\n";
+        return false;
+    }
+}
+
+bool GameRecommender::save(const std::string& path) const {
+    try {
+        std::string tmpPath = path + ".tmp";
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "ERROR in GameRecommender::save: cannot open " << tmpPath << "\n";
+            return false;
+        }
+
+        FileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+        header.formatVersion = FORMAT_VERSION;
+        header.gameCount = static_cast<uint32_t>(gameIds.size());
+        header.neighborCount = neighbors.size();
+
+        uint64_t checksum = FNV_OFFSET;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        auto emit = [&](const void* data, size_t size) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            checksum = fnv1a(checksum, static_cast<const char*>(data), size);
+        };
+        emit(gameIds.data(), gameIds.size() * sizeof(int32_t));
+        emit(offsets.data(), offsets.size() * sizeof(uint32_t));
+        emit(neighbors.data(), neighbors.size() * sizeof(uint32_t));
+        emit(similarities.data(), similarities.size() * sizeof(float));
+
+        header.checksum = checksum;
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        if (!out) {
+            std::cerr << "ERROR in GameRecommender::save: failed to write " << tmpPath << "\n";
+            return false;
+        }
+        std::filesystem::rename(tmpPath, path);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in GameRecommender::save: " << e.what() << "\n";
+        return false;
+    }
+}
+
+bool GameRecommender::load(const std::string& path) {
+    try {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        FileHeader header;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0 ||
+            header.formatVersion != FORMAT_VERSION) {
+            std::cerr << "ERROR: Recommendations file " << path << " has an unknown format\n";
+            return false;
+        }
+        uint64_t expected = static_cast<uint64_t>(header.gameCount) * sizeof(int32_t) +
+                            (static_cast<uint64_t>(header.gameCount) + 1) * sizeof(uint32_t) +
+                            header.neighborCount * (sizeof(uint32_t) + sizeof(float));
+        if (std::filesystem::file_size(path) != sizeof(header) + expected) {
+            std::cerr << "ERROR: Recommendations file " << path << " is truncated\n";
+            return false;
+        }
+
+        std::vector<int32_t> newIds(header.gameCount);
+        std::vector<uint32_t> newOffsets(static_cast<size_t>(header.gameCount) + 1);
+        std::vector<uint32_t> newNeighbors(static_cast<size_t>(header.neighborCount));
+        std::vector<float> newSimilarities(static_cast<size_t>(header.neighborCount));
+        uint64_t checksum = FNV_OFFSET;
+        auto take = [&](void* data, size_t size) {
+            in.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+            checksum = fnv1a(checksum, static_cast<const char*>(data), size);
+        };
+        take(newIds.data(), newIds.size() * sizeof(int32_t));
+        take(newOffsets.data(), newOffsets.size() * sizeof(uint32_t));
+        take(newNeighbors.data(), newNeighbors.size() * sizeof(uint32_t));
+        take(newSimilarities.data(), newSimilarities.size() * sizeof(float));
+        if (!in || checksum != header.checksum) {
+            std::cerr << "ERROR: Recommendations file " << path << " is corrupted\n";
+            return false;
+        }
+        if (newOffsets.back() != header.neighborCount ||
+            std::any_of(newNeighbors.begin(), newNeighbors.end(),
+                        [&header](uint32_t game) { return game >= header.gameCount; })) {
+            std::cerr << "ERROR: Recommendations file " << path << " is inconsistent\n";
+            return false;
+        }
+
+        gameIds = std::move(newIds);
+        offsets = std::move(newOffsets);
+        neighbors = std::move(newNeighbors);
+        similarities = std::move(newSimilarities);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in GameRecommender::load: " << e.what() << "\n";
+        return false;
+    }
+}
+
+std::vector<Recommendation> GameRecommender::similarGames(int gameId, size_t limit) const {
+    std::vector<Recommendation> result;
+    uint32_t game = gameIndex(gameId);
+    if (game == UINT32_MAX) {
+        return result;
+    }
+    for (uint32_t k = offsets[game]; k < offsets[game + 1] && result.size() < limit; ++k) {
+        result.push_back({gameIds[neighbors[k]], similarities[k]});
+    }
+    return result;
+}
+
+std::vector<Recommendation> GameRecommender::recommendForUser(const std::vector<std::pair<int, int>>& userMarks,
+                                                              size_t limit) const {
+    std::vector<Recommendation> result;
+    if (userMarks.empty() || gameIds.empty()) {
+        return result;
+    }
+    double mean = 0;
+    for (const auto& mark : userMarks) {
+        mean += mark.second;
+    }
+    mean /= static_cast<double>(userMarks.size());
+
+    // Прогноз для j: mean + sum(sim(i, j) * (r_i - mean)) / sum(|sim(i, j)|) по оцененным i
+    std::vector<float> weighted(gameIds.size(), 0.0f);
+    std::vector<float> weights(gameIds.size(), 0.0f);
+    std::vector<uint8_t> rated(gameIds.size(), 0);
+    std::vector<uint32_t> touched;
+    for (const auto& mark : userMarks) {
+        uint32_t game = gameIndex(mark.first);
+        if (game != UINT32_MAX) {
+            rated[game] = 1;
+        }
+    }
+    for (const auto& mark : userMarks) {
+        uint32_t game = gameIndex(mark.first);
+        if (game == UINT32_MAX) {
+            continue;
+        }
+        float centered = static_cast<float>(mark.second - mean);
+        for (uint32_t k = offsets[game]; k < offsets[game + 1]; ++k) {
+            uint32_t j = neighbors[k];
+            if (rated[j]) {
+                continue;
+            }
+            if (weights[j] == 0) {
+                touched.push_back(j);
+            }
+            weighted[j] += similarities[k] * centered;
+            weights[j] += std::fabs(similarities[k]);
+        }
+    }
+
+    // При равном прогнозе выше та игра, за которую говорит больше сходства
+    std::vector<std::pair<Recommendation, float>> scored;
+    scored.reserve(touched.size());
+    for (uint32_t j : touched) {
+        // Оценки в review - от 1 до 10
+        double predicted = std::min(10.0, std::max(1.0, mean + weighted[j] / weights[j]));
+        scored.push_back({{gameIds[j], static_cast<float>(predicted)}, weights[j]});
+    }
+    auto better = [](const std::pair<Recommendation, float>& a, const std::pair<Recommendation, float>& b) {
+        if (a.first.score != b.first.score) return a.first.score > b.first.score;
+        if (a.second != b.second) return a.second > b.second;
+        return a.first.gameId < b.first.gameId;
+    };
+    if (scored.size() > limit) {
+        std::partial_sort(scored.begin(), scored.begin() + limit, scored.end(), better);
+        scored.resize(limit);
+    } else {
+        std::sort(scored.begin(), scored.end(), better);
+    }
+    for (const auto& entry : scored) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
+
+size_t GameRecommender::memoryUsage() const {
+    return gameIds.capacity() * sizeof(int32_t) + offsets.capacity() * sizeof(uint32_t) +
+           neighbors.capacity() * sizeof(uint32_t) + similarities.capacity() * sizeof(float);
+}
@@ -0,0 +1,188 @@
+#include "../headers/GameSummary.hpp"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include "../headers/ResultSet.hpp"
+#include "../headers/User.hpp"
+#include "../headers/Game.hpp"
+#include "../headers/Platform.hpp"
+#include "../headers/Review.hpp"
+
+namespace {
+
+// Те же выражения, что в GET /api/games (server/routes/games.js)
+const char* const SUMMARY_SELECT =
+    "REPLACE INTO game_summary (idGame, Name, Release_year, Description, Production_cost, idCategory, "
+    "CreatedDate, ImageURL, IsActive, CategoryName, AvgMark, ReviewCount, Platforms) "
+    "SELECT g.idGame, g.Name, g.Release_year, g.Description, g.Production_cost, g.idCategory, "
+    "g.CreatedDate, g.ImageURL, g.IsActive, c.CategoryName, COALESCE(AVG(r.Mark), 0), "
+    "COUNT(DISTINCT r.idReview), GROUP_CONCAT(DISTINCT p.Platform_name) "
+    "FROM game g "
+    "LEFT JOIN category c ON g.idCategory = c.idCategory "
+    "LEFT JOIN review r ON g.idGame = r.idGame AND r.IsActive = 1 "
+    "LEFT JOIN platform p ON r.idPlatform = p.idPlatform ";
+
+std::string idList(const std::vector<int>& ids) {
+    std::ostringstream list;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        list << (i ? ", " : "") << ids[i];
+    }
+    return list.str();
+}
+
+}
+
+GameSummary::GameSummary(std::shared_ptr<DatabaseConnection> connection) : db(connection) {
+    if (!db) {
+        throw std::runtime_error("ERROR: Database connection is null!");
+    }
+}
+
+GameSummary::~GameSummary() {
+    setEventBus(nullptr);
+}
+
+void GameSummary::setEventBus(std::shared_ptr<EventBus> bus) {
+    // Отписка пачек дорабатывает последнюю пачку
+    gameBatches.reset();
+    reviewBatches.reset();
+    if (events) {
+        for (int subscription : subscriptions) {
+            events->unsubscribe(subscription);
+        }
+        subscriptions.clear();
+    }
+    events = std::move(bus);
+    if (events) {
+        subscribe();
+    }
+}
+
+void GameSummary::subscribe() {
+    // Строки удаленных игр убирает внешний ключ ON DELETE CASCADE
+    gameBatches = std::make_unique<BatchingSubscriber<GameData>>(
+        events, [this](std::vector<ChangeEvent<GameData>>& batch) {
+            std::vector<int> gameIds;
+            for (const ChangeEvent<GameData>& event : batch) {
+                gameIds.push_back(event.id);
+            }
+            refreshGames(gameIds);
+        });
+
+    reviewBatches = std::make_unique<BatchingSubscriber<ReviewData>>(
+        events, [this](std::vector<ChangeEvent<ReviewData>>& batch) {
+            std::vector<int> gameIds;
+            for (const ChangeEvent<ReviewData>& event : batch) {
+                if (event.before) gameIds.push_back(event.before->idGame);
+                if (event.after) gameIds.push_back(event.after->idGame);
+            }
+            std::sort(gameIds.begin(), gameIds.end());
+            gameIds.erase(std::unique(gameIds.begin(), gameIds.end()), gameIds.end());
+            refreshGames(gameIds);
+        });
+
+    // Остальное редко и сразу, в потоке писателя
+    subscriptions.push_back(events->subscribe<CategoryData>([this](const ChangeEvent<CategoryData>& event) {
+        if (event.type != ChangeType::UPDATED || !event.after) {
+            return;
+        }
+        std::ostringstream query;
+        query << "UPDATE game_summary SET CategoryName = '" << db->escapeString(event.after->categoryName)
+              << "' WHERE idCategory = " << event.id << ";";
+        execute(query.str());
+    }));
+
+    // Платформа в списке по имени: пересчитываем игры, где было старое имя
+    subscriptions.push_back(events->subscribe<PlatformData>([this](const ChangeEvent<PlatformData>& event) {
+        if (!event.before || (event.after && event.after->platformName == event.before->platformName)) {
+            return;
+        }
+        refreshGames(selectIds("SELECT idGame FROM game_summary WHERE FIND_IN_SET('" +
+                               db->escapeString(event.before->platformName) + "', Platforms);"));
+    }));
+
+    // Отзывы удаленного пользователя исчезают каскадом, без событий:
+    // пересчитываем игры, у которых разошлось число отзывов
+    subscriptions.push_back(events->subscribe<UserData>([this](const ChangeEvent<UserData>& event) {
+        if (event.type != ChangeType::DELETED) {
+            return;
+        }
+        refreshGames(selectIds(
+            "SELECT s.idGame FROM game_summary s "
+            "LEFT JOIN (SELECT idGame, COUNT(*) AS reviews FROM review WHERE IsActive = 1 GROUP BY idGame) r "
+            "ON r.idGame = s.idGame WHERE s.ReviewCount <> COALESCE(r.reviews, 0);"));
+    }));
+}
+
+bool GameSummary::execute(const std::string& query) {
+    std::lock_guard<std::mutex> lock(dbMutex);
+    return db->executeQuery(query);
+}
+
+bool GameSummary::refreshWhere(const std::string& condition) {
+    return execute(std::string(SUMMARY_SELECT) + "WHERE " + condition + " GROUP BY g.idGame;");
+}
+
+std::vector<int> GameSummary::selectIds(const std::string& query) {
+    std::vector<int> ids;
+    try {
+        std::lock_guard<std::mutex> lock(dbMutex);
+        ResultSet rows(db->getQueryResult(query));
+        for (const RowView& row : rows) {
+            ids.push_back(row.asInt(0));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in GameSummary::selectIds: " << e.what() << "\n";
+    }
+    return ids;
+}
+
+bool GameSummary::refreshGames(const std::vector<int>& gameIds) {
+    try {
+        if (gameIds.empty()) {
+            return true;
+        }
+        return refreshWhere("g.idGame IN (" + idList(gameIds) + ")");
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in GameSummary::refreshGames: " << e.what() << "\n";
+        return false;
+    }
+}
+
+bool GameSummary::rebuild(int chunkSize, const std::function<void(int, int)>& progress) {
+    try {
+        chunkSize = std::max(chunkSize, 1);
+        long long first = 0;
+        long long last = -1;
+        {
+            std::lock_guard<std::mutex> lock(dbMutex);
+            ResultSet bounds(db->getQueryResult("SELECT COALESCE(MIN(idGame), 0), COALESCE(MAX(idGame), -1) FROM game;"));
+            RowView row;
+            if (!bounds || !bounds.next(row)) {
+                return false;
+            }
+            first = row.asInt(0);
+            last = row.asInt(1);
+        }
+        int chunks = last >= first ? static_cast<int>((last - first) / chunkSize + 1) : 0;
+
+        // Короткие запросы по диапазонам ключа: блокировки держатся недолго
+        for (int chunk = 0; chunk < chunks; ++chunk) {
+            long long from = first + static_cast<long long>(chunk) * chunkSize;
+            std::ostringstream condition;
+            condition << "g.idGame BETWEEN " << from << " AND " << (from + chunkSize - 1);
+            if (!refreshWhere(condition.str())) {
+                return false;
+            }
+            if (progress) {
+                progress(chunk + 1, chunks);
+            }
+        }
+
+        return execute("DELETE s FROM game_summary s LEFT JOIN game g ON g.idGame = s.idGame "
+                       "WHERE g.idGame IS NULL;");
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in GameSummary::rebuild: " << e.what() << "\n";
+        return false;
+    }
+}
@@ -0,0 +1,506 @@
+#include "../headers/HttpServer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i] >= 'A' && a[i] <= 'Z' ? a[i] + 32 : a[i];
+        char y = b[i] >= 'A' && b[i] <= 'Z' ? b[i] + 32 : b[i];
+        if (x != y) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+std::string urlDecode(std::string_view value) {
+    std::string decoded;
+    decoded.reserve(value.size());
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '+') {
+            decoded += ' ';
+        } else if (value[i] == '%' && i + 2 < value.size() && hexValue(value[i + 1]) >= 0 &&
+                   hexValue(value[i + 2]) >= 0) {
+            decoded += static_cast<char>(hexValue(value[i + 1]) * 16 + hexValue(value[i + 2]));
+            i += 2;
+        } else {
+            decoded += value[i];
+        }
+    }
+    return decoded;
+}
+
+std::string_view trim(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+    return value;
+}
+
+int64_t nowSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+// ============= Запрос =============
+
+std::string_view HttpRequest::header(std::string_view name) const {
+    for (const auto& entry : headers) {
+        if (equalsIgnoreCase(entry.first, name)) {
+            return entry.second;
+        }
+    }
+    return std::string_view();
+}
+
+std::string HttpRequest::queryParam(std::string_view name) const {
+    std::string_view rest = query;
+    while (!rest.empty()) {
+        size_t end = rest.find('&');
+        std::string_view pair = rest.substr(0, end);
+        rest = end == std::string_view::npos ? std::string_view() : rest.substr(end + 1);
+
+        size_t equals = pair.find('=');
+        std::string key = urlDecode(pair.substr(0, equals));
+        if (key == name) {
+            return equals == std::string_view::npos ? std::string() : urlDecode(pair.substr(equals + 1));
+        }
+    }
+    return std::string();
+}
+
+// ============= Сервер =============
+
+struct HttpServer::Connection {
+    int fd = -1;
+    std::string input;
+    std::string output;
+    size_t outputSent = 0;
+    bool closeAfterWrite = false;
+    bool waitingWrite = false;
+    int64_t lastActive = 0;
+};
+
+struct HttpServer::Worker {
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;
+    std::thread thread;
+    std::unordered_map<int, Connection> connections;
+};
+
+HttpServer::HttpServer(uint16_t listenPort, int threads, HttpHandler requestHandler)
+    : port(listenPort), handler(std::move(requestHandler)) {
+    if (!handler) {
+        throw std::runtime_error("ERROR: Null pointers passed to HttpServer constructor!");
+    }
+    threadCount = threads > 0 ? threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+HttpServer::~HttpServer() {
+    stop();
+}
+
+const char* HttpServer::statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "Unknown";
+    }
+}
+
+bool HttpServer::start() {
+    if (running) {
+        return true;
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        std::unique_ptr<Worker> worker = std::make_unique<Worker>();
+
+        worker->listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int enable = 1;
+        setsockopt(worker->listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        setsockopt(worker->listenFd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(port);
+        if (worker->listenFd < 0 ||
+            bind(worker->listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(worker->listenFd, SOMAXCONN) != 0) {
+            std::cerr << "ERROR in HttpServer::start: cannot listen on port " << port << ": "
+                      << std::strerror(errno) << "\n";
+            if (worker->listenFd >= 0) close(worker->listenFd);
+            stop();
+            return false;
+        }
+
+        worker->epollFd = epoll_create1(EPOLL_CLOEXEC);
+        worker->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = worker->listenFd;
+        epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, worker->listenFd, &event);
+        event.data.fd = worker->wakeFd;
+        epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, worker->wakeFd, &event);
+        workers.push_back(std::move(worker));
+    }
+
+    running = true;
+    for (auto& worker : workers) {
+        Worker* raw = worker.get();
+        worker->thread = std::thread([this, raw]() { runWorker(*raw); });
+    }
+    return true;
+}
+
+void HttpServer::stop() {
+    running = false;
+    for (auto& worker : workers) {
+        if (worker->wakeFd >= 0) {
+            uint64_t one = 1;
+            ssize_t written = write(worker->wakeFd, &one, sizeof(one));
+            (void)written;
+        }
+    }
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+        for (auto& entry : worker->connections) {
+            close(entry.first);
+        }
+        worker->connections.clear();
+        if (worker->listenFd >= 0) close(worker->listenFd);
+        if (worker->epollFd >= 0) close(worker->epollFd);
+        if (worker->wakeFd >= 0) close(worker->wakeFd);
+    }
+    workers.clear();
+}
+
+void HttpServer::closeConnection(Worker& worker, int fd) {
+    epoll_ctl(worker.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    worker.connections.erase(fd);
+}
+
+void HttpServer::runWorker(Worker& worker) {
+    const int MAX_EVENTS = 256;
+    epoll_event events[MAX_EVENTS];
+    int64_t lastSweep = nowSeconds();
+
+    while (running) {
+        int count = epoll_wait(worker.epollFd, events, MAX_EVENTS, 1000);
+        if (count < 0 && errno != EINTR) {
+            std::cerr << "ERROR in HttpServer: epoll_wait: " << std::strerror(errno) << "\n";
+            break;
+        }
+        int64_t now = nowSeconds();
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == worker.wakeFd) {
+                continue;
+            }
+            if (fd == worker.listenFd) {
+                while (true) {
+                    int client = accept4(worker.listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (client < 0) {
+                        break;
+                    }
+                    int enable = 1;
+                    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+                    epoll_event event{};
+                    event.events = EPOLLIN | EPOLLRDHUP;
+                    event.data.fd = client;
+                    epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, client, &event);
+                    Connection& connection = worker.connections[client];
+                    connection.fd = client;
+                    connection.lastActive = now;
+                }
+                continue;
+            }
+
+            auto it = worker.connections.find(fd);
+            if (it == worker.connections.end()) {
+                continue;
+            }
+            Connection& connection = it->second;
+            connection.lastActive = now;
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeConnection(worker, fd);
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) && !flush(worker, connection)) {
+                closeConnection(worker, fd);
+                continue;
+            }
+            if ((events[i].events & (EPOLLIN | EPOLLRDHUP)) && !readFrom(worker, connection)) {
+                closeConnection(worker, fd);
+                continue;
+            }
+        }
+
+        // Простаивающие keep-alive соединения
+        if (now - lastSweep >= 1) {
+            lastSweep = now;
+            std::vector<int> idle;
+            for (const auto& entry : worker.connections) {
+                if (now - entry.second.lastActive > IDLE_TIMEOUT_SEC) {
+                    idle.push_back(entry.first);
+                }
+            }
+            for (int fd : idle) {
+                closeConnection(worker, fd);
+            }
+        }
+    }
+}
+
+// false - соединение нужно закрыть
+bool HttpServer::readFrom(Worker& worker, Connection& connection) {
+    char buffer[16 * 1024];
+    bool peerClosed = false;
+    // Пока клиент не забрал ответы, новые запросы не читаем (EPOLLIN снят в flush)
+    while (!connection.closeAfterWrite &&
+           connection.output.size() - connection.outputSent < MAX_PENDING_OUTPUT) {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection.input.append(buffer, static_cast<size_t>(received));
+            processRequests(connection);
+            continue;
+        }
+        if (received == 0) {
+            peerClosed = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            return false;
+        }
+        break;
+    }
+    if (!flush(worker, connection)) {
+        return false;
+    }
+    // Клиент закрыл свою сторону: дописываем ответы и закрываем
+    if (peerClosed) {
+        if (connection.outputSent == connection.output.size()) {
+            return false;
+        }
+        connection.closeAfterWrite = true;
+    }
+    return true;
+}
+
+void HttpServer::processRequests(Connection& connection) {
+    size_t consumed = 0;
+    while (!connection.closeAfterWrite && connection.output.size() - connection.outputSent < MAX_PENDING_OUTPUT) {
+        std::string_view pending(connection.input.data() + consumed, connection.input.size() - consumed);
+        size_t headerEnd = pending.find("\r\n\r\n");
+        if (headerEnd == std::string_view::npos) {
+            if (pending.size() > MAX_HEADER_BYTES) {
+                HttpResponse response;
+                response.status = 431;
+                response.body = "{\"error\":\"Request header too large\"}";
+                connection.output += "HTTP/1.1 431 Request Header Fields Too Large\r\nContent-Type: " +
+                                     response.contentType + "\r\nContent-Length: " +
+                                     std::to_string(response.body.size()) + "\r\nConnection: close\r\n\r\n" +
+                                     response.body;
+                connection.closeAfterWrite = true;
+                consumed = connection.input.size();
+            }
+            break;
+        }
+
+        HttpRequest request;
+        std::string_view head = pending.substr(0, headerEnd);
+        size_t lineEnd = head.find("\r\n");
+        std::string_view requestLine = head.substr(0, lineEnd);
+
+        // METHOD SP target SP HTTP/x.y
+        size_t firstSpace = requestLine.find(' ');
+        size_t lastSpace = requestLine.rfind(' ');
+        bool valid = firstSpace != std::string_view::npos && lastSpace > firstSpace;
+        std::string_view version;
+        if (valid) {
+            request.method = requestLine.substr(0, firstSpace);
+            std::string_view target = requestLine.substr(firstSpace + 1, lastSpace - firstSpace - 1);
+            version = requestLine.substr(lastSpace + 1);
+            size_t question = target.find('?');
+            request.path = target.substr(0, question);
+            request.query = question == std::string_view::npos ? std::string_view() : target.substr(question + 1);
+            valid = version.substr(0, 5) == "HTTP/";
+        }
+
+        size_t bodyLength = 0;
+        bool bodyTooLarge = false;
+        if (valid && lineEnd != std::string_view::npos) {
+            std::string_view rest = head.substr(lineEnd + 2);
+            while (!rest.empty()) {
+                size_t end = rest.find("\r\n");
+                std::string_view line = rest.substr(0, end);
+                rest = end == std::string_view::npos ? std::string_view() : rest.substr(end + 2);
+                size_t colon = line.find(':');
+                if (colon == std::string_view::npos) {
+                    continue;
+                }
+                request.headers.emplace_back(trim(line.substr(0, colon)), trim(line.substr(colon + 1)));
+            }
+            std::string_view length = request.header("Content-Length");
+            for (char c : length) {
+                if (c < '0' || c > '9') {
+                    valid = false;
+                    break;
+                }
+                bodyLength = bodyLength * 10 + static_cast<size_t>(c - '0');
+                // Проверка на каждой цифре: длинное число не переполнит size_t
+                if (bodyLength > MAX_BODY_BYTES) {
+                    bodyTooLarge = true;
+                    break;
+                }
+            }
+            // Chunked-тело не поддерживается
+            if (!request.header("Transfer-Encoding").empty()) {
+                valid = false;
+            }
+        }
+
+        // Тело (для GET обычно пустое) пропускаем целиком; слишком большое не буферизуем
+        size_t total = headerEnd + 4 + bodyLength;
+        if (valid && !bodyTooLarge && pending.size() < total) {
+            break;
+        }
+
+        HttpResponse response;
+        if (!valid) {
+            response.status = 400;
+            response.body = "{\"error\":\"Bad request\"}";
+            request.keepAlive = false;
+            consumed = connection.input.size();
+        } else if (bodyTooLarge) {
+            response.status = 413;
+            response.body = "{\"error\":\"Request body too large\"}";
+            request.keepAlive = false;
+            consumed = connection.input.size();
+        } else {
+            std::string_view connectionHeader = request.header("Connection");
+            request.keepAlive = version == "HTTP/1.0" ? equalsIgnoreCase(connectionHeader, "keep-alive")
+                                                      : !equalsIgnoreCase(connectionHeader, "close");
+            try {
+                handler(request, response);
+            } catch (const std::exception& e) {
+                std::cerr << "ERROR in HttpServer handler: " << e.what() << "\n";
+                response = HttpResponse();
+                response.status = 500;
+                response.body = "{\"error\":\"Internal server error\"}";
+            }
+            consumed += total;
+        }
+
+        std::string& out = connection.output;
+        out += "HTTP/1.1 ";
+        out += std::to_string(response.status);
+        out += ' ';
+        out += statusText(response.status);
+        if (!response.contentType.empty()) {
+            out += "\r\nContent-Type: ";
+            out += response.contentType;
+        }
+        out += "\r\nContent-Length: ";
+        out += std::to_string(response.body.size());
+        out += request.keepAlive ? "\r\nConnection: keep-alive\r\n" : "\r\nConnection: close\r\n";
+        for (const auto& header : response.headers) {
+            out += header.first;
+            out += ": ";
+            out += header.second;
+            out += "\r\n";
+        }
+        out += "\r\n";
+        if (request.method != "HEAD") {
+            out += response.body;
+        }
+        if (!request.keepAlive) {
+            connection.closeAfterWrite = true;
+        }
+    }
+    connection.input.erase(0, consumed);
+}
+
+// Отправить накопленный вывод; false - соединение нужно закрыть
+bool HttpServer::flush(Worker& worker, Connection& connection) {
+    while (connection.outputSent < connection.output.size()) {
+        ssize_t sent = send(connection.fd, connection.output.data() + connection.outputSent,
+                            connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.outputSent += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        return false;
+    }
+
+    bool drained = connection.outputSent == connection.output.size();
+    if (drained) {
+        connection.output.clear();
+        connection.outputSent = 0;
+        if (connection.closeAfterWrite) {
+            return false;
+        }
+        // Запросы, отложенные из-за переполненного вывода
+        if (!connection.input.empty()) {
+            processRequests(connection);
+            if (!connection.output.empty()) {
+                return flush(worker, connection);
+            }
+        }
+    }
+
+    // Недописанный ответ - ждем EPOLLOUT и не читаем новые запросы
+    if (drained == connection.waitingWrite) {
+        connection.waitingWrite = !drained;
+        epoll_event event{};
+        event.events = drained ? (EPOLLIN | EPOLLRDHUP) : EPOLLOUT;
+        event.data.fd = connection.fd;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+    }
+    return true;
+}
@@ -0,0 +1,232 @@
+#include "../headers/HyperLogLog.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+// Бит хеша на значимость после индекса регистра
+const uint32_t RANK_BITS = 64 - HyperLogLog::PRECISION;
+const uint8_t MODE_SPARSE = 0;
+const uint8_t MODE_DENSE = 1;
+
+uint32_t sparseIndex(uint32_t entry) {
+    return entry >> 8;
+}
+
+uint8_t sparseRank(uint32_t entry) {
+    return static_cast<uint8_t>(entry & 0xFF);
+}
+
+// Поправочные ряды оценки Ertl (2017, "New cardinality estimation algorithms
+// for HyperLogLog sketches"): без эмпирических таблиц и без переключения
+// на linear counting при малых числах
+double sigma(double x) {
+    if (x == 1.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double y = 1.0;
+    double z = x;
+    double previous;
+    do {
+        x *= x;
+        previous = z;
+        z += x * y;
+        y += y;
+    } while (z != previous);
+    return z;
+}
+
+double tau(double x) {
+    if (x == 0.0 || x == 1.0) {
+        return 0.0;
+    }
+    double y = 1.0;
+    double z = 1.0 - x;
+    double previous;
+    do {
+        x = std::sqrt(x);
+        previous = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    } while (z != previous);
+    return z / 3.0;
+}
+}
+
+uint64_t HyperLogLog::hashId(uint64_t id) {
+    // splitmix64
+    id += 0x9E3779B97F4A7C15ULL;
+    id = (id ^ (id >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    id = (id ^ (id >> 27)) * 0x94D049BB133111EBULL;
+    return id ^ (id >> 31);
+}
+
+void HyperLogLog::clear() {
+    sparse.clear();
+    dense.clear();
+}
+
+void HyperLogLog::densify() {
+    dense.assign(REGISTERS, 0);
+    for (uint32_t entry : sparse) {
+        dense[sparseIndex(entry)] = sparseRank(entry);
+    }
+    sparse.clear();
+    sparse.shrink_to_fit();
+}
+
+void HyperLogLog::setRegister(uint32_t index, uint8_t rank) {
+    if (!dense.empty()) {
+        dense[index] = std::max(dense[index], rank);
+        return;
+    }
+    auto it = std::lower_bound(sparse.begin(), sparse.end(), index << 8);
+    if (it != sparse.end() && sparseIndex(*it) == index) {
+        if (sparseRank(*it) < rank) {
+            *it = (index << 8) | rank;
+        }
+        return;
+    }
+    sparse.insert(it, (index << 8) | rank);
+    if (sparse.size() > SPARSE_LIMIT) {
+        densify();
+    }
+}
+
+void HyperLogLog::add(uint64_t hash) {
+    uint32_t index = static_cast<uint32_t>(hash >> RANK_BITS);
+    uint64_t rest = hash << PRECISION;
+    // Номер первой единицы в оставшихся битах, 1..RANK_BITS + 1
+    uint8_t rank = 1;
+    while (rank <= RANK_BITS && !(rest & (1ULL << 63))) {
+        rest <<= 1;
+        ++rank;
+    }
+    setRegister(index, rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    if (other.empty()) {
+        return;
+    }
+    if (!other.dense.empty()) {
+        if (dense.empty()) {
+            densify();
+        }
+        for (uint32_t i = 0; i < REGISTERS; ++i) {
+            dense[i] = std::max(dense[i], other.dense[i]);
+        }
+        return;
+    }
+    if (!dense.empty()) {
+        for (uint32_t entry : other.sparse) {
+            dense[sparseIndex(entry)] = std::max(dense[sparseIndex(entry)], sparseRank(entry));
+        }
+        return;
+    }
+
+    // Оба разреженные: слияние отсортированных списков
+    std::vector<uint32_t> merged;
+    merged.reserve(sparse.size() + other.sparse.size());
+    size_t a = 0;
+    size_t b = 0;
+    while (a < sparse.size() || b < other.sparse.size()) {
+        if (b == other.sparse.size() ||
+            (a < sparse.size() && sparseIndex(sparse[a]) < sparseIndex(other.sparse[b]))) {
+            merged.push_back(sparse[a++]);
+        } else if (a == sparse.size() || sparseIndex(other.sparse[b]) < sparseIndex(sparse[a])) {
+            merged.push_back(other.sparse[b++]);
+        } else {
+            merged.push_back(std::max(sparse[a++], other.sparse[b++]));
+        }
+    }
+    sparse.swap(merged);
+    if (sparse.size() > SPARSE_LIMIT) {
+        densify();
+    }
+}
+
+uint64_t HyperLogLog::estimate() const {
+    if (empty()) {
+        return 0;
+    }
+    // Число регистров с каждым значением
+    double counts[RANK_BITS + 2] = {};
+    if (!dense.empty()) {
+        for (uint8_t rank : dense) {
+            counts[rank] += 1;
+        }
+    } else {
+        counts[0] = REGISTERS - static_cast<double>(sparse.size());
+        for (uint32_t entry : sparse) {
+            counts[sparseRank(entry)] += 1;
+        }
+    }
+
+    const double m = REGISTERS;
+    double z = m * tau(1.0 - counts[RANK_BITS + 1] / m);
+    for (int k = RANK_BITS; k >= 1; --k) {
+        z = 0.5 * (z + counts[k]);
+    }
+    z += m * sigma(counts[0] / m);
+    const double alpha = 0.5 / std::log(2.0);
+    return static_cast<uint64_t>(std::llround(alpha * m * m / z));
+}
+
+void HyperLogLog::write(std::ostream& out) const {
+    uint8_t mode = dense.empty() ? MODE_SPARSE : MODE_DENSE;
+    uint32_t size = static_cast<uint32_t>(dense.empty() ? sparse.size() : dense.size());
+    out.write(reinterpret_cast<const char*>(&mode), sizeof(mode));
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    if (dense.empty()) {
+        out.write(reinterpret_cast<const char*>(sparse.data()), static_cast<std::streamsize>(size * sizeof(uint32_t)));
+    } else {
+        out.write(reinterpret_cast<const char*>(dense.data()), static_cast<std::streamsize>(size));
+    }
+}
+
+bool HyperLogLog::read(std::istream& in) {
+    clear();
+    uint8_t mode = 0;
+    uint32_t size = 0;
+    if (!in.read(reinterpret_cast<char*>(&mode), sizeof(mode)) ||
+        !in.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+        return false;
+    }
+
+    if (mode == MODE_DENSE) {
+        if (size != REGISTERS) {
+            return false;
+        }
+        dense.resize(size);
+        if (!in.read(reinterpret_cast<char*>(dense.data()), size)) {
+            clear();
+            return false;
+        }
+        for (uint8_t rank : dense) {
+            if (rank > RANK_BITS + 1) {
+                clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (mode != MODE_SPARSE || size > SPARSE_LIMIT) {
+        return false;
+    }
+    sparse.resize(size);
+    if (!in.read(reinterpret_cast<char*>(sparse.data()), static_cast<std::streamsize>(size * sizeof(uint32_t)))) {
+        clear();
+        return false;
+    }
+    for (size_t i = 0; i < sparse.size(); ++i) {
+        uint8_t rank = sparseRank(sparse[i]);
+        if (sparseIndex(sparse[i]) >= REGISTERS || rank == 0 || rank > RANK_BITS + 1 ||
+            (i > 0 && sparseIndex(sparse[i - 1]) >= sparseIndex(sparse[i]))) {
+            clear();
+            return false;
+        }
+    }
+    return true;
+}
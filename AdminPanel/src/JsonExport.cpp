@@ -0,0 +1,78 @@
+#include "../headers/JsonExport.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include "../headers/JsonWriter.hpp"
+
+namespace {
+
+bool flush(std::ofstream& file, std::string& buffer) {
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+    return static_cast<bool>(file);
+}
+
+template <typename Entity>
+bool writeTable(std::ofstream& file, std::string& buffer, JsonWriter& json,
+                const char* name, ResultSet result, size_t& rows) {
+    if (!result.isValid()) {
+        return false;
+    }
+    json.key(name);
+    json.beginArray();
+    for (const RowView& row : result) {
+        json.entity(Repository<Entity>::materialize(row));
+        ++rows;
+        if (buffer.size() >= JsonExport::FLUSH_BYTES && !flush(file, buffer)) {
+            return false;
+        }
+    }
+    json.endArray();
+    return true;
+}
+
+}
+
+bool JsonExport::write(const std::string& path, User& userMgr, Game& gameMgr,
+                       Platform& platformMgr, Review& reviewMgr, size_t* rows) {
+    try {
+        // Пишем во временный файл: прерванная выгрузка не портит прежнюю
+        std::string temporary = path + ".tmp";
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "ERROR in JsonExport::write: cannot open " << temporary << "\n";
+            return false;
+        }
+
+        std::string buffer;
+        buffer.reserve(FLUSH_BYTES * 2);
+        JsonWriter json(buffer);
+        size_t written = 0;
+
+        json.beginObject();
+        bool ok = writeTable<UserData>(file, buffer, json, "users", userMgr.scanAllUsers(), written) &&
+                  writeTable<CategoryData>(file, buffer, json, "categories", gameMgr.scanAllCategories(), written) &&
+                  writeTable<PlatformData>(file, buffer, json, "platforms", platformMgr.scanAllPlatforms(), written) &&
+                  writeTable<GameData>(file, buffer, json, "games", gameMgr.scanAllGames(), written) &&
+                  writeTable<ReviewData>(file, buffer, json, "reviews", reviewMgr.scanAllReviews(), written);
+        if (ok) {
+            json.endObject();
+            buffer += '\n';
+            ok = flush(file, buffer);
+        }
+        file.close();
+
+        if (!ok || !file || std::rename(temporary.c_str(), path.c_str()) != 0) {
+            std::cerr << "ERROR in JsonExport::write: failed to write " << path << "\n";
+            std::remove(temporary.c_str());
+            return false;
+        }
+        if (rows) {
+            *rows = written;
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in JsonExport::write: " << e.what() << "\n";
+        return false;
+    }
+}
@@ -0,0 +1,82 @@
+#include "../headers/JsonWriter.hpp"
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define JSON_WRITER_SSE2 1
+#endif
+
+namespace {
+
+// Длина префикса, который можно скопировать как есть: без '"', '\\' и управляющих символов
+size_t plainPrefix(const char* data, size_t size) {
+    size_t i = 0;
+#ifdef JSON_WRITER_SSE2
+    // 16 байт за шаг: c < 0x20 (сравнение со знаком после сдвига на 0x80), '"', '\\'
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i flip = _mm_set1_epi8(static_cast<char>(0x80));
+    const __m128i control = _mm_set1_epi8(static_cast<char>(0x20 ^ 0x80));
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmplt_epi8(_mm_xor_si128(chunk, flip), control));
+        int mask = _mm_movemask_epi8(special);
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if (c < 0x20 || c == '"' || c == '\\') {
+            break;
+        }
+    }
+    return i;
+}
+
+}
+
+void JsonWriter::appendEscaped(std::string& out, std::string_view value) {
+    static const char* const HEX = "0123456789abcdef";
+    out += '"';
+    const char* data = value.data();
+    size_t size = value.size();
+    while (size > 0) {
+        size_t plain = plainPrefix(data, size);
+        out.append(data, plain);
+        if (plain == size) {
+            break;
+        }
+        char c = data[plain];
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default: {
+                char escaped[6] = {'\\', 'u', '0', '0', HEX[(c >> 4) & 0xF], HEX[c & 0xF]};
+                out.append(escaped, sizeof(escaped));
+            }
+        }
+        data += plain + 1;
+        size -= plain + 1;
+    }
+    out += '"';
+}
+
+void JsonWriter::value(double number) {
+    if (!std::isfinite(number)) {
+        null();
+        return;
+    }
+    separate();
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    out.append(digits, result.ptr);
+}
@@ -0,0 +1,256 @@
+#include "../headers/NameTrie.hpp"
+#include "../headers/FuzzyIndex.hpp"
+#include <algorithm>
+#include <queue>
+
+NameTrie::NameTrie() {
+    nodes.emplace_back();
+}
+
+void NameTrie::clear() {
+    nodes.assign(1, Node());
+    labels.clear();
+    entries.clear();
+    freeEntries.clear();
+    byId.clear();
+    count = 0;
+}
+
+uint32_t NameTrie::findChild(uint32_t node, char first) const {
+    for (uint32_t child = nodes[node].firstChild; child != NONE; child = nodes[child].nextSibling) {
+        if (labelByte(child, 0) == first) {
+            return child;
+        }
+    }
+    return NONE;
+}
+
+void NameTrie::linkChild(uint32_t parent, uint32_t child) {
+    unsigned char first = static_cast<unsigned char>(labelByte(child, 0));
+    nodes[child].parent = parent;
+    uint32_t* link = &nodes[parent].firstChild;
+    while (*link != NONE && static_cast<unsigned char>(labelByte(*link, 0)) < first) {
+        link = &nodes[*link].nextSibling;
+    }
+    nodes[child].nextSibling = *link;
+    *link = child;
+}
+
+void NameTrie::unlinkChild(uint32_t parent, uint32_t child) {
+    uint32_t* link = &nodes[parent].firstChild;
+    while (*link != child) {
+        link = &nodes[*link].nextSibling;
+    }
+    *link = nodes[child].nextSibling;
+    nodes[child].parent = NONE;
+    nodes[child].nextSibling = NONE;
+}
+
+uint32_t NameTrie::splitNode(uint32_t node, uint32_t at) {
+    // Хвост метки, записи и дети уходят в новый узел под node
+    uint32_t lower = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    Node& upper = nodes[node];
+    Node& tail = nodes[lower];
+    tail.labelStart = upper.labelStart + at;
+    tail.labelLength = upper.labelLength - at;
+    tail.parent = node;
+    tail.firstChild = upper.firstChild;
+    tail.entries = upper.entries;
+    tail.best = upper.best;
+    upper.labelLength = at;
+    upper.firstChild = lower;
+    upper.entries = NONE;
+
+    for (uint32_t child = tail.firstChild; child != NONE; child = nodes[child].nextSibling) {
+        nodes[child].parent = lower;
+    }
+    for (uint32_t e = tail.entries; e != NONE; e = entries[e].next) {
+        entries[e].node = lower;
+    }
+    return node;
+}
+
+uint32_t NameTrie::descend(const std::string& key, bool prefix) const {
+    uint32_t node = 0;
+    size_t pos = 0;
+    while (pos < key.size()) {
+        uint32_t child = findChild(node, key[pos]);
+        if (child == NONE) {
+            return NONE;
+        }
+        size_t length = nodes[child].labelLength;
+        size_t compared = std::min(length, key.size() - pos);
+        if (labels.compare(nodes[child].labelStart, compared, key, pos, compared) != 0) {
+            return NONE;
+        }
+        if (compared < length) {
+            return prefix ? child : NONE;
+        }
+        pos += length;
+        node = child;
+    }
+    return node;
+}
+
+void NameTrie::refreshBest(uint32_t node) {
+    while (node != NONE) {
+        uint32_t best = 0;
+        for (uint32_t e = nodes[node].entries; e != NONE; e = entries[e].next) {
+            best = std::max(best, entries[e].score);
+        }
+        for (uint32_t child = nodes[node].firstChild; child != NONE; child = nodes[child].nextSibling) {
+            best = std::max(best, nodes[child].best);
+        }
+        if (best == nodes[node].best) {
+            return;
+        }
+        nodes[node].best = best;
+        node = nodes[node].parent;
+    }
+}
+
+void NameTrie::insert(int id, const std::string& name, uint32_t score) {
+    remove(id);
+
+    std::string key = FuzzyIndex::foldCase(name);
+    uint32_t node = 0;
+    size_t pos = 0;
+    while (pos < key.size()) {
+        uint32_t child = findChild(node, key[pos]);
+        if (child == NONE) {
+            child = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+            nodes[child].labelStart = static_cast<uint32_t>(labels.size());
+            nodes[child].labelLength = static_cast<uint32_t>(key.size() - pos);
+            labels.append(key, pos, std::string::npos);
+            linkChild(node, child);
+            node = child;
+            break;
+        }
+        uint32_t length = nodes[child].labelLength;
+        uint32_t common = 0;
+        while (common < length && pos + common < key.size() && labelByte(child, common) == key[pos + common]) {
+            ++common;
+        }
+        if (common < length) {
+            splitNode(child, common);
+        }
+        node = child;
+        pos += common;
+    }
+
+    uint32_t e;
+    if (!freeEntries.empty()) {
+        e = freeEntries.back();
+        freeEntries.pop_back();
+    } else {
+        e = static_cast<uint32_t>(entries.size());
+        entries.emplace_back();
+    }
+    entries[e] = {id, score, node, nodes[node].entries, name};
+    nodes[node].entries = e;
+    byId[id] = e;
+    ++count;
+
+    for (uint32_t n = node; n != NONE && nodes[n].best < score; n = nodes[n].parent) {
+        nodes[n].best = score;
+    }
+}
+
+bool NameTrie::remove(int id) {
+    auto it = byId.find(id);
+    if (it == byId.end()) {
+        return false;
+    }
+    uint32_t e = it->second;
+    uint32_t node = entries[e].node;
+    uint32_t* link = &nodes[node].entries;
+    while (*link != e) {
+        link = &entries[*link].next;
+    }
+    *link = entries[e].next;
+    entries[e].name.clear();
+    entries[e].name.shrink_to_fit();
+    freeEntries.push_back(e);
+    byId.erase(it);
+    --count;
+
+    // Пустые листья отцепляются; их слоты и метки остаются до clear()
+    while (node != 0 && nodes[node].entries == NONE && nodes[node].firstChild == NONE) {
+        uint32_t parent = nodes[node].parent;
+        unlinkChild(parent, node);
+        nodes[node].best = 0;
+        node = parent;
+    }
+    refreshBest(node);
+    return true;
+}
+
+bool NameTrie::setScore(int id, uint32_t score) {
+    auto it = byId.find(id);
+    if (it == byId.end()) {
+        return false;
+    }
+    entries[it->second].score = score;
+    refreshBest(entries[it->second].node);
+    return true;
+}
+
+int NameTrie::find(const std::string& name) const {
+    uint32_t node = descend(FuzzyIndex::foldCase(name), false);
+    if (node == NONE || nodes[node].entries == NONE) {
+        return -1;
+    }
+    return entries[nodes[node].entries].id;
+}
+
+std::vector<NameMatch> NameTrie::complete(const std::string& prefix, size_t limit) const {
+    std::vector<NameMatch> result;
+    uint32_t start = descend(FuzzyIndex::foldCase(prefix), true);
+    if (start == NONE || limit == 0) {
+        return result;
+    }
+
+    // Обход по убыванию score: узел идет в очередь с лучшим score поддерева,
+    // поэтому первые limit записей из очереди - top-N
+    struct Item {
+        uint32_t score;
+        uint32_t order;
+        uint32_t index;
+        bool isEntry;
+    };
+    auto lower = [](const Item& a, const Item& b) {
+        return a.score != b.score ? a.score < b.score : a.order > b.order;
+    };
+    std::priority_queue<Item, std::vector<Item>, decltype(lower)> queue(lower);
+    uint32_t order = 0;
+    queue.push({nodes[start].best, order++, start, false});
+
+    while (!queue.empty() && result.size() < limit) {
+        Item item = queue.top();
+        queue.pop();
+        if (item.isEntry) {
+            const Entry& entry = entries[item.index];
+            result.push_back({entry.id, &entry.name, entry.score});
+            continue;
+        }
+        const Node& node = nodes[item.index];
+        for (uint32_t e = node.entries; e != NONE; e = entries[e].next) {
+            queue.push({entries[e].score, order++, e, true});
+        }
+        for (uint32_t child = node.firstChild; child != NONE; child = nodes[child].nextSibling) {
+            queue.push({nodes[child].best, order++, child, false});
+        }
+    }
+    return result;
+}
+
+size_t NameTrie::memoryUsage() const {
+    size_t total = nodes.capacity() * sizeof(Node) + labels.capacity() + entries.capacity() * sizeof(Entry) +
+                   freeEntries.capacity() * sizeof(uint32_t);
+    for (const Entry& entry : entries) {
+        total += entry.name.capacity();
+    }
+    return total + byId.size() * (sizeof(int) + sizeof(uint32_t) + sizeof(void*));
+}
@@ -0,0 +1,98 @@
+#include "../headers/OutboxRelay.hpp"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "../headers/ResultSet.hpp"
+
+OutboxRelay::OutboxRelay(std::shared_ptr<DatabaseConnection> connection, const std::string& logDir,
+                         uint64_t segmentBytes, std::chrono::milliseconds pollInterval, size_t maxBatch)
+    : db(connection), log(logDir, segmentBytes), interval(pollInterval), batchSize(maxBatch > 0 ? maxBatch : 1) {
+    if (!db) {
+        throw std::runtime_error("ERROR: Null pointers passed to OutboxRelay constructor!");
+    }
+    worker = std::thread(&OutboxRelay::run, this);
+}
+
+OutboxRelay::~OutboxRelay() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_one();
+    worker.join();
+}
+
+int OutboxRelay::relayBatch() {
+    try {
+        // Сначала дочищаем прошлую пачку, иначе она попадет в журнал второй раз
+        if (!undeleted.empty()) {
+            if (!db->executeQuery("DELETE FROM outbox_event WHERE idEvent IN (" + undeleted + ");")) {
+                return -1;
+            }
+            undeleted.clear();
+        }
+
+        // Без фильтра по idEvent: транзакция с меньшим idEvent могла зафиксироваться позже
+        std::ostringstream query;
+        query << "SELECT idEvent, TableName, ChangeType, RowId, RowId2, CreatedDate, Payload "
+              << "FROM outbox_event ORDER BY idEvent LIMIT " << batchSize << ";";
+        ResultSet rows(db->getQueryResult(query.str()));
+        if (!rows) {
+            return -1;
+        }
+
+        std::vector<LogRecord> records;
+        std::ostringstream relayed;
+        for (const RowView& row : rows) {
+            uint64_t eventId = std::stoull(row.toString(0));
+            relayed << (relayed.tellp() == 0 ? "" : ", ") << eventId;
+            // Уже в журнале: сбой между записью журнала и DELETE
+            if (log.containsRecent(eventId)) {
+                continue;
+            }
+            LogRecord record;
+            record.eventId = eventId;
+            record.table = row.toString(1);
+            record.changeType = row.toString(2);
+            record.rowId = row.asInt(3);
+            record.rowId2 = row.asInt(4);
+            record.createdDate = row.toString(5);
+            record.payload = row.toString(6);
+            records.push_back(std::move(record));
+        }
+        if (relayed.tellp() == 0) {
+            return 0;
+        }
+
+        // Сначала журнал (с fsync), потом удаление: при сбое событие не теряется
+        if (!log.append(records)) {
+            return -1;
+        }
+        if (!db->executeQuery("DELETE FROM outbox_event WHERE idEvent IN (" + relayed.str() + ");")) {
+            undeleted = relayed.str();
+            return -1;
+        }
+        return static_cast<int>(records.size());
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in OutboxRelay::relayBatch: " << e.what() << "\n";
+        return -1;
+    }
+}
+
+void OutboxRelay::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        lock.unlock();
+        // Полная пачка - сразу следующая, иначе ждем интервал
+        int relayed;
+        do {
+            relayed = relayBatch();
+        } while (relayed >= static_cast<int>(batchSize));
+        lock.lock();
+
+        if (stopping) {
+            break;
+        }
+        wakeup.wait_for(lock, interval, [this]() { return stopping; });
+    }
+}
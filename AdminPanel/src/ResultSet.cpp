@@ -0,0 +1,95 @@
+#include "../headers/ResultSet.hpp"
+#include <cstdlib>
+#include <cstring>
+
+// ============= RowView =============
+
+bool RowView::isNull(unsigned int index) const {
+    return !row || index >= fieldCount || row[index] == nullptr;
+}
+
+const char* RowView::raw(unsigned int index) const {
+    return isNull(index) ? nullptr : row[index];
+}
+
+unsigned long RowView::length(unsigned int index) const {
+    if (isNull(index)) {
+        return 0;
+    }
+    return lengths ? lengths[index] : static_cast<unsigned long>(std::strlen(row[index]));
+}
+
+std::string_view RowView::text(unsigned int index) const {
+    if (isNull(index)) {
+        return std::string_view();
+    }
+    return std::string_view(row[index], length(index));
+}
+
+int RowView::asInt(unsigned int index) const {
+    return isNull(index) ? 0 : std::atoi(row[index]);
+}
+
+double RowView::asDouble(unsigned int index) const {
+    return isNull(index) ? 0.0 : std::strtod(row[index], nullptr);
+}
+
+bool RowView::asBool(unsigned int index) const {
+    return length(index) == 1 && row[index][0] == '1';
+}
+
+std::string RowView::toString(unsigned int index) const {
+    return std::string(text(index));
+}
+
+// ============= ResultSet =============
+
+ResultSet::ResultSet(MYSQL_RES* res) : result(res), fieldCount(0) {
+    if (result) {
+        fieldCount = mysql_num_fields(result);
+    }
+}
+
+ResultSet::~ResultSet() {
+    release();
+}
+
+ResultSet::ResultSet(ResultSet&& other) noexcept
+    : result(other.result), fieldCount(other.fieldCount) {
+    other.result = nullptr;
+    other.fieldCount = 0;
+}
+
+ResultSet& ResultSet::operator=(ResultSet&& other) noexcept {
+    if (this != &other) {
+        release();
+        result = other.result;
+        fieldCount = other.fieldCount;
+        other.result = nullptr;
+        other.fieldCount = 0;
+    }
+    return *this;
+}
+
+void ResultSet::release() {
+    if (result) {
+        mysql_free_result(result);
+        result = nullptr;
+    }
+}
+
+unsigned long long ResultSet::getRowCount() const {
+    return result ? static_cast<unsigned long long>(mysql_num_rows(result)) : 0;
+}
+
+bool ResultSet::next(RowView& row) {
+    if (!result) {
+        return false;
+    }
+    MYSQL_ROW raw = mysql_fetch_row(result);
+    if (!raw) {
+        return false;
+    }
+    row = RowView(raw, mysql_fetch_lengths(result), fieldCount);
+    return true;
+}
@@ -1,328 +1,196 @@
 ﻿#include "../headers/Review.hpp"
 #include <sstream>
 #include <iostream>
+#include <algorithm>
 
-Review::Review(std::shared_ptr<DatabaseConnection> database) : db(database) {
-    if (!db) {
-        throw std::runtime_error("ERROR: Database connection is null!");
-    }
+Review::Review(std::shared_ptr<DatabaseConnection> database) : repo(database) {
 }
 
-bool Review::addReview(int idUser, int idGame, int idPlatform,
-                      const std::string& Review_text, int mark) {
-    try {
-        if (idUser <= 0 || idGame <= 0 || idPlatform <= 0 || mark < 1 || mark > 10) {
-            std::cerr << "ERROR: Invalid review parameters!\n";
-            return false;
-        }
+void Review::setEventBus(std::shared_ptr<EventBus> bus) {
+    repo.setEventBus(bus);
+}
 
-        std::ostringstream query;
-        query << "INSERT INTO review (idUser, idGame, idPlatform, Review_text, Mark) "
-              << "VALUES (" << idUser << ", " << idGame << ", " << idPlatform << ", '"
-              << Review_text << "', " << mark << ");";
+void Review::setOutbox(bool enabled) {
+    repo.setOutbox(enabled);
+}
 
-        bool result = db->executeQuery(query.str());
-        if (result) {
-            std::cout << "[✓] Review added successfully!\n";
-        } else {
-            std::cerr << "✗ Failed to add review!\n";
-        }
-        return result;
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in addReview: " << e.what() << "\n";
+bool Review::addReview(int idUser, int idGame, int idPlatform,
+                      const std::string& Review_text, int mark) {
+    if (idUser <= 0 || idGame <= 0 || idPlatform <= 0 || mark < 1 || mark > 10) {
+        std::cerr << "ERROR: Invalid review parameters!\n";
         return false;
     }
+
+    ReviewData review{};
+    review.idUser = idUser;
+    review.idGame = idGame;
+    review.idPlatform = idPlatform;
+    review.reviewText = Review_text;
+    review.mark = mark;
+
+    bool result = repo.insert(review);
+    if (result) {
+        std::cout << "[✓] Review added successfully!\n";
+    } else {
+        std::cerr << "✗ Failed to add review!\n";
+    }
+    return result;
 }
 
 bool Review::deleteReview(int reviewId) {
-    try {
-        if (reviewId <= 0) {
-            std::cerr << "ERROR: Invalid review ID!\n";
-            return false;
-        }
-
-        std::ostringstream query;
-        query << "DELETE FROM review WHERE idReview = " << reviewId << ";";
-
-        return db->executeQuery(query.str());
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in deleteReview: " << e.what() << "\n";
+    if (reviewId <= 0) {
+        std::cerr << "ERROR: Invalid review ID!\n";
         return false;
     }
+    return repo.removeById(reviewId);
 }
 
 bool Review::updateReview(int reviewId, const std::string& Review_text, int mark) {
-    try {
-        if (reviewId <= 0 || mark < 1 || mark > 10) {
-            std::cerr << "ERROR: Invalid parameters!\n";
-            return false;
-        }
-
-        std::ostringstream query;
-        query << "UPDATE review SET Review_text = '" << Review_text << "', Mark = " << mark
-              << " WHERE idReview = " << reviewId << ";";
-
-        return db->executeQuery(query.str());
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in updateReview: " << e.what() << "\n";
+    if (reviewId <= 0 || mark < 1 || mark > 10) {
+        std::cerr << "ERROR: Invalid parameters!\n";
         return false;
     }
+
+    ReviewData review{};
+    review.idReview = reviewId;
+    review.reviewText = Review_text;
+    review.mark = mark;
+    return repo.update(review, &ReviewData::reviewText, &ReviewData::mark);
 }
 
 std::vector<ReviewData> Review::getAllReviews() {
-    std::vector<ReviewData> reviews;
-    try {
-        std::string query = "SELECT idReview, idUser, idGame, idPlatform, Review_text, Mark, IsActive "
-                           "FROM review;";
-        MYSQL_RES* result = db->getQueryResult(query);
-
-        if (!result) {
-            std::cerr << "ERROR: Failed to get reviews from database!\n";
-            return reviews;
-        }
-
-        MYSQL_ROW row;
-        while ((row = mysql_fetch_row(result))) {
-            ReviewData review;
-            review.idReview = std::stoi(row[0] ? row[0] : "0");
-            review.idUser = std::stoi(row[1] ? row[1] : "0");
-            review.idGame = std::stoi(row[2] ? row[2] : "0");
-            review.idPlatform = std::stoi(row[3] ? row[3] : "0");
-            review.reviewText = row[4] ? row[4] : "";
-            review.mark = std::stoi(row[5] ? row[5] : "0");
-            review.isActive = (row[6] && std::string(row[6]) == "1");
-            reviews.push_back(review);
-        }
-
-        db->freeResult(result);
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getAllReviews: " << e.what() << "\n";
-    }
-    return reviews;
+    return repo.findAll();
 }
 
 ReviewData Review::getReviewById(int reviewId) {
     ReviewData review = {-1, 0, 0, 0, "", 0, 0, "", "", false};
-    try {
-        if (reviewId <= 0) {
-            return review;
-        }
-
-        std::ostringstream query;
-        query << "SELECT idReview, idUser, idGame, idPlatform, Review_text, Mark, IsActive "
-              << "FROM review WHERE idReview = " << reviewId << ";";
-
-        MYSQL_RES* result = db->getQueryResult(query.str());
-        if (!result) {
-            return review;
-        }
-
-        MYSQL_ROW row = mysql_fetch_row(result);
-        if (row) {
-            review.idReview = std::stoi(row[0] ? row[0] : "0");
-            review.idUser = std::stoi(row[1] ? row[1] : "0");
-            review.idGame = std::stoi(row[2] ? row[2] : "0");
-            review.idPlatform = std::stoi(row[3] ? row[3] : "0");
-            review.reviewText = row[4] ? row[4] : "";
-            review.mark = std::stoi(row[5] ? row[5] : "0");
-            review.isActive = (row[6] && std::string(row[6]) == "1");
-        }
-
-        db->freeResult(result);
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getReviewById: " << e.what() << "\n";
+    if (reviewId <= 0) {
+        return review;
     }
+    repo.findById(reviewId, review);
     return review;
 }
 
 std::vector<ReviewData> Review::getGameReviews(int gameId) {
-    std::vector<ReviewData> reviews;
-    try {
-        if (gameId <= 0) {
-            return reviews;
-        }
-
-        std::ostringstream query;
-        query << "SELECT idReview, idUser, idGame, idPlatform, Review_text, Mark, IsActive "
-              << "FROM review WHERE idGame = " << gameId << ";";
-
-        MYSQL_RES* result = db->getQueryResult(query.str());
-        if (!result) {
-            return reviews;
-        }
-
-        MYSQL_ROW row;
-        while ((row = mysql_fetch_row(result))) {
-            ReviewData review;
-            review.idReview = std::stoi(row[0] ? row[0] : "0");
-            review.idUser = std::stoi(row[1] ? row[1] : "0");
-            review.idGame = std::stoi(row[2] ? row[2] : "0");
-            review.idPlatform = std::stoi(row[3] ? row[3] : "0");
-            review.reviewText = row[4] ? row[4] : "";
-            review.mark = std::stoi(row[5] ? row[5] : "0");
-            review.isActive = (row[6] && std::string(row[6]) == "1");
-            reviews.push_back(review);
-        }
-
-        db->freeResult(result);
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getGameReviews: " << e.what() << "\n";
+    if (gameId <= 0) {
+        return {};
     }
-    return reviews;
+    return repo.findWhere("idGame = " + std::to_string(gameId));
 }
 
 std::vector<ReviewData> Review::getUserReviews(int userId) {
-    std::vector<ReviewData> reviews;
-    try {
-        if (userId <= 0) {
-            return reviews;
-        }
-
-        std::ostringstream query;
-        query << "SELECT idReview, idUser, idGame, idPlatform, Review_text, Mark, IsActive "
-              << "FROM review WHERE idUser = " << userId << ";";
+    if (userId <= 0) {
+        return {};
+    }
+    return repo.findWhere("idUser = " + std::to_string(userId));
+}
 
-        MYSQL_RES* result = db->getQueryResult(query.str());
-        if (!result) {
-            return reviews;
-        }
+std::vector<ReviewData> Review::getPlatformReviews(int platformId) {
+    if (platformId <= 0) {
+        return {};
+    }
+    return repo.findWhere("idPlatform = " + std::to_string(platformId));
+}
 
-        MYSQL_ROW row;
-        while ((row = mysql_fetch_row(result))) {
-            ReviewData review;
-            review.idReview = std::stoi(row[0] ? row[0] : "0");
-            review.idUser = std::stoi(row[1] ? row[1] : "0");
-            review.idGame = std::stoi(row[2] ? row[2] : "0");
-            review.idPlatform = std::stoi(row[3] ? row[3] : "0");
-            review.reviewText = row[4] ? row[4] : "";
-            review.mark = std::stoi(row[5] ? row[5] : "0");
-            review.isActive = (row[6] && std::string(row[6]) == "1");
-            reviews.push_back(review);
-        }
+std::vector<ReviewData> Review::getGameReviewsPage(int gameId, int offset, int limit,
+                                                  const std::string& orderBy, bool ascending) {
+    return Repository<ReviewData>::materializeAll(
+        scanGameReviewsPage(gameId, offset, limit, orderBy, ascending));
+}
 
-        db->freeResult(result);
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getUserReviews: " << e.what() << "\n";
+ResultSet Review::scanGameReviewsPage(int gameId, int offset, int limit,
+                                      const std::string& orderBy, bool ascending) {
+    if (gameId <= 0 || offset < 0 || limit <= 0) {
+        return ResultSet();
     }
-    return reviews;
+
+    // Имя колонки подставляется в SQL - только из белого списка
+    static const std::vector<std::string> sortable = {"idReview", "idUser", "idPlatform", "Mark", "ReviewDate"};
+    std::string column = std::find(sortable.begin(), sortable.end(), orderBy) != sortable.end()
+                             ? orderBy : "idReview";
+    std::string direction = ascending ? " ASC" : " DESC";
+
+    // Deferred join: OFFSET проходит только по индексу, полные строки читаются для одной страницы.
+    // Колонки в порядке схемы, вместо Review_text - превью.
+    std::ostringstream query;
+    query << "SELECT r.idReview, r.idUser, r.idGame, r.idPlatform, LEFT(r.Review_text, 200), r.Mark, r.IsActive "
+          << "FROM review r JOIN (SELECT idReview FROM review WHERE idGame = " << gameId
+          << " ORDER BY " << column << direction << ", idReview LIMIT " << offset << ", " << limit
+          << ") page ON page.idReview = r.idReview "
+          << "ORDER BY r." << column << direction << ", r.idReview;";
+
+    return repo.select(query.str());
 }
 
-std::vector<ReviewData> Review::getPlatformReviews(int platformId) {
-    std::vector<ReviewData> reviews;
-    try {
-        if (platformId <= 0) {
-            return reviews;
-        }
+ResultSet Review::scanAllReviews() {
+    return repo.selectAll();
+}
 
-        std::ostringstream query;
-        query << "SELECT idReview, idUser, idGame, idPlatform, Review_text, Mark, IsActive "
-              << "FROM review WHERE idPlatform = " << platformId << ";";
+ResultSet Review::scanRatingsByGame() {
+    return repo.selectRaw("SELECT idGame, COUNT(*), COALESCE(SUM(Mark), 0) FROM review GROUP BY idGame;");
+}
 
-        MYSQL_RES* result = db->getQueryResult(query.str());
-        if (!result) {
-            return reviews;
-        }
+ResultSet Review::scanActiveReviews() {
+    return repo.selectRaw("SELECT idReview, idUser, idGame, idPlatform, Review_text, Mark, ReviewDate, Validation "
+                          "FROM review WHERE IsActive = 1 ORDER BY idGame, ReviewDate DESC, idReview DESC;");
+}
 
-        MYSQL_ROW row;
-        while ((row = mysql_fetch_row(result))) {
-            ReviewData review;
-            review.idReview = std::stoi(row[0] ? row[0] : "0");
-            review.idUser = std::stoi(row[1] ? row[1] : "0");
-            review.idGame = std::stoi(row[2] ? row[2] : "0");
-            review.idPlatform = std::stoi(row[3] ? row[3] : "0");
-            review.reviewText = row[4] ? row[4] : "";
-            review.mark = std::stoi(row[5] ? row[5] : "0");
-            review.isActive = (row[6] && std::string(row[6]) == "1");
-            reviews.push_back(review);
-        }
+ResultSet Review::scanUserMarks() {
+    return repo.selectRaw("SELECT idUser, idGame, Mark FROM review WHERE IsActive = 1 AND Mark IS NOT NULL;");
+}
 
-        db->freeResult(result);
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getPlatformReviews: " << e.what() << "\n";
-    }
-    return reviews;
+ResultSet Review::scanRecentMarks(int days) {
+    return repo.selectRaw("SELECT idReview, idGame, idPlatform, Mark, UNIX_TIMESTAMP(ReviewDate) FROM review "
+                          "WHERE IsActive = 1 AND Mark IS NOT NULL AND ReviewDate >= NOW() - INTERVAL " +
+                          std::to_string(std::max(days, 1)) + " DAY ORDER BY ReviewDate, idReview;");
 }
 
-double Review::getAverageRating(int gameId) {
-    try {
-        if (gameId <= 0) {
-            return 0.0;
-        }
+ResultSet Review::scanMarksSince(int afterReviewId) {
+    return repo.selectRaw("SELECT idReview, idGame, idPlatform, Mark, UNIX_TIMESTAMP(ReviewDate) FROM review "
+                          "WHERE IsActive = 1 AND Mark IS NOT NULL AND idReview > " +
+                          std::to_string(afterReviewId) + " ORDER BY idReview;");
+}
 
-        std::ostringstream query;
-        query << "SELECT AVG(Mark) FROM review WHERE idGame = " << gameId << ";";
+ResultSet Review::scanReviewAudienceSince(int afterReviewId) {
+    return repo.selectRaw("SELECT r.idReview, r.idUser, r.idGame, g.idCategory, r.idPlatform, "
+                          "UNIX_TIMESTAMP(r.ReviewDate) FROM review r LEFT JOIN game g ON g.idGame = r.idGame "
+                          "WHERE r.IsActive = 1 AND r.idReview > " + std::to_string(afterReviewId) +
+                          " ORDER BY r.idReview;");
+}
 
-        MYSQL_RES* result = db->getQueryResult(query.str());
-        if (!result) {
-            return 0.0;
-        }
+// Агрегаты пересчитываются целиком, поэтому повторное применение безопасно
+ResultSet Review::scanRatingsForGames(const std::vector<int>& gameIds) {
+    if (gameIds.empty()) {
+        return ResultSet();
+    }
+    std::ostringstream query;
+    query << "SELECT idGame, COUNT(*), COALESCE(SUM(Mark), 0) FROM review WHERE idGame IN (";
+    for (size_t i = 0; i < gameIds.size(); ++i) {
+        query << (i ? ", " : "") << gameIds[i];
+    }
+    query << ") GROUP BY idGame;";
+    return repo.selectRaw(query.str());
+}
 
-        MYSQL_ROW row = mysql_fetch_row(result);
-        double avg = 0.0;
-        if (row && row[0]) {
-            avg = std::stod(row[0]);
-        }
+ResultSet Review::scanReviewedGamesSince(const std::string& since) {
+    return repo.selectRaw("SELECT DISTINCT idGame FROM review WHERE UpdatedDate >= DATE_SUB('" +
+                          repo.escape(since) + "', INTERVAL 60 SECOND);");
+}
 
-        db->freeResult(result);
-        return avg;
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getAverageRating: " << e.what() << "\n";
+double Review::getAverageRating(int gameId) {
+    if (gameId <= 0) {
         return 0.0;
     }
+    return repo.aggregate("AVG(Mark)", "idGame = " + std::to_string(gameId));
 }
 
 int Review::getReviewCount() {
-    try {
-        std::string query = "SELECT COUNT(*) FROM review;";
-        MYSQL_RES* result = db->getQueryResult(query);
-
-        if (!result) {
-            return 0;
-        }
-
-        MYSQL_ROW row = mysql_fetch_row(result);
-        int count = 0;
-        if (row && row[0]) {
-            count = std::stoi(row[0]);
-        }
-
-        db->freeResult(result);
-        return count;
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getReviewCount: " << e.what() << "\n";
-        return 0;
-    }
+    return repo.count();
 }
 
 int Review::getGameReviewCount(int gameId) {
-    try {
-        if (gameId <= 0) {
-            return 0;
-        }
-
-        std::ostringstream query;
-        query << "SELECT COUNT(*) FROM review WHERE idGame = " << gameId << ";";
-
-        MYSQL_RES* result = db->getQueryResult(query.str());
-        if (!result) {
-            return 0;
-        }
-
-        MYSQL_ROW row = mysql_fetch_row(result);
-        int count = 0;
-        if (row && row[0]) {
-            count = std::stoi(row[0]);
-        }
-
-        db->freeResult(result);
-        return count;
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getGameReviewCount: " << e.what() << "\n";
+    if (gameId <= 0) {
         return 0;
     }
+    return repo.count("idGame = " + std::to_string(gameId));
 }
-
-
-
-
-
@@ -0,0 +1,274 @@
+#include "../headers/ReviewAnomalyDetector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+namespace {
+// Вес закрытой корзины в экспоненциальном среднем
+const double ALPHA = 2.0 / (ReviewAnomalyDetector::BASELINE_BUCKETS + 1);
+// Пока отзывов нет - типичная доля оценок 1..3
+const double DEFAULT_LOW_SHARE = 0.2;
+
+uint32_t slotOf(int64_t bucket) {
+    int64_t slot = bucket % static_cast<int64_t>(ReviewAnomalyDetector::WINDOW_BUCKETS);
+    return static_cast<uint32_t>(slot < 0 ? slot + ReviewAnomalyDetector::WINDOW_BUCKETS : slot);
+}
+
+// Знаковый корень отношения правдоподобия: в отличие от (x - mean) / sd
+// правильно ведет себя на хвостах при малых ожидаемых числах
+double poissonScore(double observed, double expected) {
+    double deviance = observed > 0 ? observed * std::log(observed / expected) - (observed - expected) : expected;
+    return std::copysign(std::sqrt(2 * std::max(deviance, 0.0)), observed - expected);
+}
+
+double binomialScore(double hits, double trials, double share) {
+    double expected = trials * share;
+    double deviance = 0;
+    if (hits > 0) {
+        deviance += hits * std::log(hits / expected);
+    }
+    if (hits < trials) {
+        deviance += (trials - hits) * std::log((trials - hits) / (trials - expected));
+    }
+    return std::copysign(std::sqrt(2 * std::max(deviance, 0.0)), hits - expected);
+}
+
+void increment(uint16_t& counter) {
+    if (counter < UINT16_MAX) {
+        ++counter;
+    }
+}
+}
+
+ReviewAnomalyDetector::ReviewAnomalyDetector(const Settings& settings) : settings(settings) {
+    if (this->settings.bucketSeconds == 0) {
+        this->settings.bucketSeconds = Settings().bucketSeconds;
+    }
+}
+
+void ReviewAnomalyDetector::clear() {
+    games.clear();
+    platforms.clear();
+    alerts.clear();
+    nextSequence = 1;
+    observed = 0;
+    lowObserved = 0;
+    lastReviewId = 0;
+}
+
+int64_t ReviewAnomalyDetector::bucketOf(int64_t time) const {
+    int64_t size = settings.bucketSeconds;
+    return time >= 0 ? time / size : -((-time + size - 1) / size);
+}
+
+bool ReviewAnomalyDetector::advance(Series& series, int64_t bucket) const {
+    if (series.head == INT64_MIN) {
+        series.head = bucket;
+        return true;
+    }
+    if (bucket <= series.head) {
+        return series.head - bucket < WINDOW_BUCKETS;
+    }
+
+    // Закрытая корзина входит в среднее и дисперсию (обновление Уэлфорда с весом ALPHA)
+    uint32_t slot = slotOf(series.head);
+    double reviews = series.totals[slot];
+    if (series.history == 0) {
+        series.meanReviews = static_cast<float>(reviews);
+        series.varReviews = 0;
+        series.meanLows = series.lows[slot];
+    } else {
+        double diff = reviews - series.meanReviews;
+        double step = ALPHA * diff;
+        series.meanReviews = static_cast<float>(series.meanReviews + step);
+        series.varReviews = static_cast<float>((1 - ALPHA) * (series.varReviews + diff * step));
+        series.meanLows = static_cast<float>(series.meanLows + ALPHA * (series.lows[slot] - series.meanLows));
+    }
+
+    // Пустые корзины между ними - сразу, без цикла: после k нулей
+    // mean' = mean * r^k, var' = var * r^k + mean^2 * r^k * (1 - r^k), r = 1 - ALPHA
+    int64_t gap = bucket - series.head;
+    if (gap > 1) {
+        double decay = std::pow(1 - ALPHA, static_cast<double>(gap - 1));
+        double mean = series.meanReviews;
+        series.varReviews = static_cast<float>(series.varReviews * decay + mean * mean * decay * (1 - decay));
+        series.meanReviews = static_cast<float>(mean * decay);
+        series.meanLows = static_cast<float>(series.meanLows * decay);
+    }
+    series.history = static_cast<uint32_t>(
+        std::min<int64_t>(BASELINE_BUCKETS, static_cast<int64_t>(series.history) + gap));
+
+    for (int64_t b = bucket - std::min<int64_t>(gap, WINDOW_BUCKETS) + 1; b <= bucket; ++b) {
+        uint32_t fresh = slotOf(b);
+        std::fill(std::begin(series.marks[fresh]), std::end(series.marks[fresh]), 0);
+        series.totals[fresh] = 0;
+        series.lows[fresh] = 0;
+    }
+    series.head = bucket;
+    series.alerts[0] = series.alerts[1] = 0;
+    return true;
+}
+
+void ReviewAnomalyDetector::add(Series& series, int64_t bucket, int mark) const {
+    uint32_t slot = slotOf(bucket);
+    increment(series.marks[slot][mark - 1]);
+    increment(series.totals[slot]);
+    if (mark <= LOW_MARK) {
+        increment(series.lows[slot]);
+    }
+}
+
+double ReviewAnomalyDetector::lowShare(const Series& series) const {
+    double prior = observed ? static_cast<double>(lowObserved) / observed : DEFAULT_LOW_SHARE;
+    // Среднее за корзину / ALPHA - примерно число отзывов, которое помнит среднее
+    double share = (series.meanLows / ALPHA + PRIOR_REVIEWS * prior) / (series.meanReviews / ALPHA + PRIOR_REVIEWS);
+    return std::clamp(share, 0.01, 0.99);
+}
+
+void ReviewAnomalyDetector::check(Series& series, ReviewAnomaly::Scope scope, int id) {
+    uint32_t slot = slotOf(series.head);
+    double reviews = series.totals[slot];
+    double lows = series.lows[slot];
+    if (reviews < settings.minReviews) {
+        return;
+    }
+
+    if (series.history >= MIN_HISTORY) {
+        // Разброс больше пуассоновского (сезонность, выходные) - ожидание сдвигается
+        // на лишнюю дисперсию; у редко оцениваемых игр ожидание не меньше 1
+        double mean = series.meanReviews;
+        double overdispersion = std::max(static_cast<double>(series.varReviews) - mean, 0.0);
+        double z = poissonScore(reviews, std::max(mean + std::sqrt(overdispersion), 1.0));
+        if (z >= settings.zThreshold) {
+            raise(series, ReviewAnomaly::VOLUME, scope, id, mean, z);
+        }
+    }
+
+    if (lows >= settings.minReviews) {
+        double share = lowShare(series);
+        double z = binomialScore(lows, reviews, share);
+        if (z >= settings.zThreshold) {
+            raise(series, ReviewAnomaly::LOW_MARKS, scope, id, share, z);
+        }
+    }
+}
+
+void ReviewAnomalyDetector::raise(Series& series, ReviewAnomaly::Kind kind, ReviewAnomaly::Scope scope, int id,
+                                  double expected, double zScore) {
+    uint32_t slot = slotOf(series.head);
+    ReviewAnomaly alert{0, kind, scope, id, series.head * static_cast<int64_t>(settings.bucketSeconds),
+                        series.totals[slot], series.lows[slot], expected, zScore};
+
+    // Одна тревога на корзину: следующие отзывы обновляют ее числа
+    uint64_t sequence = series.alerts[kind];
+    if (sequence != 0) {
+        size_t index = (sequence - 1) % MAX_ALERTS;
+        if (index < alerts.size() && alerts[index].sequence == sequence) {
+            alert.sequence = sequence;
+            alerts[index] = alert;
+        }
+        return;
+    }
+
+    alert.sequence = nextSequence++;
+    if (alerts.size() < MAX_ALERTS) {
+        alerts.push_back(alert);
+    } else {
+        alerts[(alert.sequence - 1) % MAX_ALERTS] = alert;
+    }
+    series.alerts[kind] = alert.sequence;
+}
+
+void ReviewAnomalyDetector::observe(int gameId, int platformId, int mark, int64_t time) {
+    if (mark < 1 || mark > MAX_MARK) {
+        return;
+    }
+    int64_t bucket = bucketOf(time);
+    ++observed;
+    if (mark <= LOW_MARK) {
+        ++lowObserved;
+    }
+
+    Series& game = games[gameId];
+    if (advance(game, bucket)) {
+        add(game, bucket, mark);
+        if (bucket == game.head) {
+            check(game, ReviewAnomaly::GAME, gameId);
+        }
+    }
+    if (platformId > 0) {
+        Series& platform = platforms[platformId];
+        if (advance(platform, bucket)) {
+            add(platform, bucket, mark);
+            if (bucket == platform.head) {
+                check(platform, ReviewAnomaly::PLATFORM, platformId);
+            }
+        }
+    }
+}
+
+bool ReviewAnomalyDetector::backfill(ResultSet reviewRows) {
+    clear();
+    return apply(std::move(reviewRows));
+}
+
+bool ReviewAnomalyDetector::apply(ResultSet reviewRows) {
+    try {
+        for (const RowView& row : reviewRows) {
+            lastReviewId = std::max(lastReviewId, row.asInt(0));
+            if (row.isNull(3) || row.isNull(4)) {
+                continue;
+            }
+            observe(row.asInt(1), row.asInt(2), row.asInt(3), static_cast<int64_t>(row.asDouble(4)));
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in ReviewAnomalyDetector::apply: " << e.what() << "\n";
+        return false;
+    }
+}
+
+std::vector<ReviewAnomaly> ReviewAnomalyDetector::recentAlerts(size_t limit) const {
+    std::vector<ReviewAnomaly> result;
+    for (uint64_t sequence = nextSequence - 1; sequence > 0 && result.size() < limit; --sequence) {
+        size_t index = (sequence - 1) % MAX_ALERTS;
+        if (index >= alerts.size() || alerts[index].sequence != sequence) {
+            break;
+        }
+        result.push_back(alerts[index]);
+    }
+    return result;
+}
+
+ReviewAnomalyDetector::WindowStats ReviewAnomalyDetector::window(ReviewAnomaly::Scope scope, int id,
+                                                                 int64_t now) const {
+    WindowStats stats;
+    const auto& index = scope == ReviewAnomaly::GAME ? games : platforms;
+    auto it = index.find(id);
+    if (it == index.end()) {
+        stats.baselineLowShare = observed ? static_cast<double>(lowObserved) / observed : DEFAULT_LOW_SHARE;
+        return stats;
+    }
+
+    const Series& series = it->second;
+    int64_t last = std::max(bucketOf(now), series.head);
+    for (int64_t bucket = series.head; bucket > series.head - WINDOW_BUCKETS; --bucket) {
+        if (last - bucket >= WINDOW_BUCKETS) {
+            break;
+        }
+        uint32_t slot = slotOf(bucket);
+        stats.reviews += series.totals[slot];
+        for (int mark = 0; mark < MAX_MARK; ++mark) {
+            stats.marks[mark] += series.marks[slot][mark];
+        }
+    }
+    stats.baselineReviews = series.meanReviews;
+    stats.baselineLowShare = lowShare(series);
+    return stats;
+}
+
+size_t ReviewAnomalyDetector::memoryUsage() const {
+    size_t perSeries = sizeof(Series) + sizeof(int) + 2 * sizeof(void*);
+    return (games.size() + platforms.size()) * perSeries + alerts.capacity() * sizeof(ReviewAnomaly);
+}
@@ -0,0 +1,208 @@
+#include "../headers/ReviewCardinality.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+const char FILE_MAGIC[8] = {'R', 'V', 'C', 'A', 'R', 'D', '\0', '\0'};
+const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+const int64_t SECONDS_PER_DAY = 86400;
+// Ключ: 4 бита измерения, 32 бита ID, 28 бит дня (до 2700-х годов)
+const uint32_t DAY_BITS = 28;
+const int64_t MAX_DAY = (int64_t(1) << DAY_BITS) - 1;
+
+uint64_t fnv1a(uint64_t hash, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+}
+
+uint64_t ReviewCardinality::cellKey(Dimension dimension, int id, int64_t day) {
+    return (static_cast<uint64_t>(dimension) << 60) | (static_cast<uint64_t>(static_cast<uint32_t>(id)) << DAY_BITS) |
+           static_cast<uint64_t>(std::clamp<int64_t>(day, 0, MAX_DAY));
+}
+
+int64_t ReviewCardinality::dayOf(int64_t time) {
+    return time >= 0 ? time / SECONDS_PER_DAY : -((-time + SECONDS_PER_DAY - 1) / SECONDS_PER_DAY);
+}
+
+void ReviewCardinality::clear() {
+    cells.clear();
+    lastReviewId = 0;
+    firstDay = 0;
+    lastDay = -1;
+}
+
+void ReviewCardinality::addTo(Dimension dimension, int id, int64_t day, int userId, int gameId) {
+    Cell& cell = cells[cellKey(dimension, id, day)];
+    cell.reviewers.addId(static_cast<uint32_t>(userId));
+    if (dimension != GAME) {
+        cell.games.addId(static_cast<uint32_t>(gameId));
+    }
+}
+
+void ReviewCardinality::add(int userId, int gameId, int categoryId, int platformId, int64_t time) {
+    int64_t day = std::clamp<int64_t>(dayOf(time), 0, MAX_DAY);
+    if (lastDay < firstDay) {
+        firstDay = lastDay = day;
+    } else {
+        firstDay = std::min(firstDay, day);
+        lastDay = std::max(lastDay, day);
+    }
+    addTo(ALL, 0, day, userId, gameId);
+    addTo(GAME, gameId, day, userId, gameId);
+    if (platformId > 0) {
+        addTo(PLATFORM, platformId, day, userId, gameId);
+    }
+    if (categoryId > 0) {
+        addTo(CATEGORY, categoryId, day, userId, gameId);
+    }
+}
+
+bool ReviewCardinality::apply(ResultSet reviewRows) {
+    try {
+        for (const RowView& row : reviewRows) {
+            // Отметка сдвигается только по просканированным строкам: отзыв с меньшим
+            // ID, добавленный другим клиентом, не окажется позади нее
+            lastReviewId = std::max(lastReviewId, row.asInt(0));
+            if (row.isNull(5)) {
+                continue;
+            }
+            add(row.asInt(1), row.asInt(2), row.isNull(3) ? 0 : row.asInt(3), row.asInt(4),
+                static_cast<int64_t>(row.asDouble(5)));
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in ReviewCardinality::apply: " << e.what() << "\n";
+        return false;
+    }
+}
+
+ReviewCardinality::Estimate ReviewCardinality::count(Dimension dimension, int id, int64_t fromDay,
+                                                     int64_t toDay) const {
+    Estimate result;
+    if (dimension == ALL) {
+        id = 0;
+    }
+    HyperLogLog reviewers;
+    HyperLogLog games;
+    for (int64_t day = std::max(fromDay, firstDay); day <= std::min(toDay, lastDay); ++day) {
+        auto it = cells.find(cellKey(dimension, id, day));
+        if (it != cells.end()) {
+            reviewers.merge(it->second.reviewers);
+            games.merge(it->second.games);
+        }
+    }
+    result.reviewers = reviewers.estimate();
+    result.games = games.estimate();
+    return result;
+}
+
+bool ReviewCardinality::save(const std::string& path) const {
+    try {
+        // Скетчи разной длины: тело собирается в памяти, потом считается контрольная сумма
+        std::ostringstream body(std::ios::binary);
+        for (const auto& entry : cells) {
+            body.write(reinterpret_cast<const char*>(&entry.first), sizeof(entry.first));
+            entry.second.reviewers.write(body);
+            entry.second.games.write(body);
+        }
+        std::string data = body.str();
+
+        FileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+        header.formatVersion = FORMAT_VERSION;
+        header.precision = HyperLogLog::PRECISION;
+        header.cellCount = cells.size();
+        header.lastReviewId = lastReviewId;
+        header.checksum = fnv1a(FNV_OFFSET, data.data(), data.size());
+
+        std::string tmpPath = path + ".tmp";
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "ERROR in ReviewCardinality::save: cannot open " << tmpPath << "\n";
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        out.close();
+        if (!out) {
+            std::cerr << "ERROR in ReviewCardinality::save: failed to write " << tmpPath << "\n";
+            return false;
+        }
+        std::filesystem::rename(tmpPath, path);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in ReviewCardinality::save: " << e.what() << "\n";
+        return false;
+    }
+}
+
+bool ReviewCardinality::load(const std::string& path) {
+    try {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        FileHeader header;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0 ||
+            header.formatVersion != FORMAT_VERSION || header.precision != HyperLogLog::PRECISION) {
+            std::cerr << "ERROR: Review cardinality file " << path << " has an unknown format\n";
+            return false;
+        }
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (fnv1a(FNV_OFFSET, data.data(), data.size()) != header.checksum) {
+            std::cerr << "ERROR: Review cardinality file " << path << " is corrupted\n";
+            return false;
+        }
+
+        std::istringstream body(data, std::ios::binary);
+        std::unordered_map<uint64_t, Cell> newCells;
+        newCells.reserve(static_cast<size_t>(header.cellCount));
+        int64_t newFirstDay = 0;
+        int64_t newLastDay = -1;
+        for (uint64_t i = 0; i < header.cellCount; ++i) {
+            uint64_t key = 0;
+            Cell cell;
+            if (!body.read(reinterpret_cast<char*>(&key), sizeof(key)) || !cell.reviewers.read(body) ||
+                !cell.games.read(body)) {
+                std::cerr << "ERROR: Review cardinality file " << path << " is inconsistent\n";
+                return false;
+            }
+            int64_t day = static_cast<int64_t>(key & MAX_DAY);
+            newFirstDay = newLastDay < newFirstDay ? day : std::min(newFirstDay, day);
+            newLastDay = std::max(newLastDay, day);
+            newCells.emplace(key, std::move(cell));
+        }
+        if (body.peek() != std::char_traits<char>::eof()) {
+            std::cerr << "ERROR: Review cardinality file " << path << " is inconsistent\n";
+            return false;
+        }
+
+        cells = std::move(newCells);
+        firstDay = newFirstDay;
+        lastDay = newLastDay;
+        lastReviewId = static_cast<int>(header.lastReviewId);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in ReviewCardinality::load: " << e.what() << "\n";
+        return false;
+    }
+}
+
+size_t ReviewCardinality::memoryUsage() const {
+    size_t total = cells.size() * (sizeof(uint64_t) + sizeof(Cell) + 4 * sizeof(void*));
+    for (const auto& entry : cells) {
+        total += entry.second.reviewers.memoryUsage() + entry.second.games.memoryUsage();
+    }
+    return total;
+}
@@ -0,0 +1,249 @@
+#include "../headers/RoaringBitmap.hpp"
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+
+// ============= Блок =============
+
+bool RoaringBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) {
+        return (bits[low >> 6] >> (low & 63)) & 1;
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+void RoaringBitmap::Container::add(uint16_t low) {
+    if (isBitmap()) {
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (!(bits[low >> 6] & mask)) {
+            bits[low >> 6] |= mask;
+            cardinality++;
+        }
+        return;
+    }
+    // Значения обычно идут по возрастанию
+    if (array.empty() || array.back() < low) {
+        array.push_back(low);
+    } else {
+        auto it = std::lower_bound(array.begin(), array.end(), low);
+        if (*it == low) {
+            return;
+        }
+        array.insert(it, low);
+    }
+    cardinality++;
+    if (cardinality > ARRAY_MAX) {
+        toBitmap();
+    }
+}
+
+void RoaringBitmap::Container::toBitmap() {
+    bits.assign(BITMAP_WORDS, 0);
+    for (uint16_t low : array) {
+        bits[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+    array.clear();
+    array.shrink_to_fit();
+}
+
+void RoaringBitmap::Container::toArrayIfSmall() {
+    if (!isBitmap() || cardinality > ARRAY_MAX) {
+        return;
+    }
+    array.reserve(cardinality);
+    for (size_t word = 0; word < BITMAP_WORDS; ++word) {
+        uint64_t value = bits[word];
+        while (value) {
+            array.push_back(static_cast<uint16_t>(word * 64 + __builtin_ctzll(value)));
+            value &= value - 1;
+        }
+    }
+    bits.clear();
+    bits.shrink_to_fit();
+}
+
+RoaringBitmap::Container RoaringBitmap::andContainers(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+    if (a.isBitmap() && b.isBitmap()) {
+        result.bits.resize(BITMAP_WORDS);
+        for (size_t word = 0; word < BITMAP_WORDS; ++word) {
+            result.bits[word] = a.bits[word] & b.bits[word];
+            result.cardinality += static_cast<uint32_t>(__builtin_popcountll(result.bits[word]));
+        }
+        result.toArrayIfSmall();
+    } else if (a.isBitmap() || b.isBitmap()) {
+        const Container& array = a.isBitmap() ? b : a;
+        const Container& bitmap = a.isBitmap() ? a : b;
+        for (uint16_t low : array.array) {
+            if (bitmap.contains(low)) {
+                result.array.push_back(low);
+            }
+        }
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+    } else {
+        std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                              std::back_inserter(result.array));
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+    }
+    return result;
+}
+
+RoaringBitmap::Container RoaringBitmap::orContainers(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+    if (!a.isBitmap() && !b.isBitmap() && a.cardinality + b.cardinality <= ARRAY_MAX) {
+        std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                       std::back_inserter(result.array));
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+        return result;
+    }
+
+    result.bits.assign(BITMAP_WORDS, 0);
+    for (const Container* source : {&a, &b}) {
+        if (source->isBitmap()) {
+            for (size_t word = 0; word < BITMAP_WORDS; ++word) {
+                result.bits[word] |= source->bits[word];
+            }
+        } else {
+            for (uint16_t low : source->array) {
+                result.bits[low >> 6] |= uint64_t(1) << (low & 63);
+            }
+        }
+    }
+    for (uint64_t word : result.bits) {
+        result.cardinality += static_cast<uint32_t>(__builtin_popcountll(word));
+    }
+    result.toArrayIfSmall();
+    return result;
+}
+
+uint32_t RoaringBitmap::andCardinality(const Container& a, const Container& b) {
+    uint32_t count = 0;
+    if (a.isBitmap() && b.isBitmap()) {
+        for (size_t word = 0; word < BITMAP_WORDS; ++word) {
+            count += static_cast<uint32_t>(__builtin_popcountll(a.bits[word] & b.bits[word]));
+        }
+    } else if (a.isBitmap() || b.isBitmap()) {
+        const Container& array = a.isBitmap() ? b : a;
+        const Container& bitmap = a.isBitmap() ? a : b;
+        for (uint16_t low : array.array) {
+            count += bitmap.contains(low) ? 1 : 0;
+        }
+    } else {
+        auto i = a.array.begin();
+        auto j = b.array.begin();
+        while (i != a.array.end() && j != b.array.end()) {
+            if (*i < *j) {
+                ++i;
+            } else if (*j < *i) {
+                ++j;
+            } else {
+                ++count;
+                ++i;
+                ++j;
+            }
+        }
+    }
+    return count;
+}
+
+// ============= Множество =============
+
+void RoaringBitmap::add(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+    if (containers.empty() || containers.back().key < key) {
+        containers.emplace_back();
+        containers.back().key = key;
+        containers.back().add(low);
+        return;
+    }
+    auto it = std::lower_bound(containers.begin(), containers.end(), key,
+                               [](const Container& c, uint16_t k) { return c.key < k; });
+    if (it == containers.end() || it->key != key) {
+        it = containers.insert(it, Container());
+        it->key = key;
+    }
+    it->add(low);
+}
+
+bool RoaringBitmap::contains(uint32_t value) const {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    auto it = std::lower_bound(containers.begin(), containers.end(), key,
+                               [](const Container& c, uint16_t k) { return c.key < k; });
+    return it != containers.end() && it->key == key && it->contains(static_cast<uint16_t>(value & 0xFFFF));
+}
+
+uint64_t RoaringBitmap::cardinality() const {
+    uint64_t total = 0;
+    for (const Container& container : containers) {
+        total += container.cardinality;
+    }
+    return total;
+}
+
+RoaringBitmap RoaringBitmap::intersect(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() && j < b.containers.size()) {
+        if (a.containers[i].key < b.containers[j].key) {
+            ++i;
+        } else if (b.containers[j].key < a.containers[i].key) {
+            ++j;
+        } else {
+            Container merged = andContainers(a.containers[i], b.containers[j]);
+            if (merged.cardinality > 0) {
+                result.containers.push_back(std::move(merged));
+            }
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+RoaringBitmap RoaringBitmap::unite(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() || j < b.containers.size()) {
+        if (j == b.containers.size() || (i < a.containers.size() && a.containers[i].key < b.containers[j].key)) {
+            result.containers.push_back(a.containers[i++]);
+        } else if (i == a.containers.size() || b.containers[j].key < a.containers[i].key) {
+            result.containers.push_back(b.containers[j++]);
+        } else {
+            result.containers.push_back(orContainers(a.containers[i++], b.containers[j++]));
+        }
+    }
+    return result;
+}
+
+uint64_t RoaringBitmap::intersectCount(const RoaringBitmap& a, const RoaringBitmap& b) {
+    uint64_t count = 0;
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() && j < b.containers.size()) {
+        if (a.containers[i].key < b.containers[j].key) {
+            ++i;
+        } else if (b.containers[j].key < a.containers[i].key) {
+            ++j;
+        } else {
+            count += andCardinality(a.containers[i++], b.containers[j++]);
+        }
+    }
+    return count;
+}
+
+std::vector<uint32_t> RoaringBitmap::toVector() const {
+    std::vector<uint32_t> values;
+    values.reserve(static_cast<size_t>(cardinality()));
+    forEach([&values](uint32_t value) { values.push_back(value); });
+    return values;
+}
+
+size_t RoaringBitmap::memoryUsage() const {
+    size_t total = sizeof(*this) + containers.capacity() * sizeof(Container);
+    for (const Container& container : containers) {
+        total += container.array.capacity() * sizeof(uint16_t) + container.bits.capacity() * sizeof(uint64_t);
+    }
+    return total;
+}
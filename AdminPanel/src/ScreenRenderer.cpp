@@ -0,0 +1,159 @@
+#include "../headers/ScreenRenderer.hpp"
+#include <iostream>
+#include <cstdio>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+#endif
+
+ScreenRenderer::ScreenRenderer() {
+#ifdef _WIN32
+    // Включить обработку ANSI-последовательностей в консоли Windows 10+
+    HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (out != INVALID_HANDLE_VALUE && GetConsoleMode(out, &mode)) {
+        SetConsoleMode(out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+}
+
+void ScreenRenderer::beginFrame() {
+    backBuffer.str("");
+    backBuffer.clear();
+}
+
+std::ostream& ScreenRenderer::frame() {
+    return backBuffer;
+}
+
+std::vector<std::string> ScreenRenderer::splitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            if (start < text.size()) {
+                lines.push_back(text.substr(start));
+            }
+            break;
+        }
+        lines.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    return lines;
+}
+
+std::string ScreenRenderer::fitToWidth(const std::string& line, int width) {
+    // Ширина в кодовых точках UTF-8: длинная строка перенеслась бы и сбила номера строк.
+    // Каждая кодовая точка считается за одну колонку - верно для латиницы, кириллицы
+    // и рамок меню; широкие (CJK, эмодзи) и комбинируемые символы так не учитываются,
+    // а wcwidth без setlocale для не-ASCII ничего не знает
+    int columns = 0;
+    for (size_t i = 0; i < line.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(line[i]);
+        if ((c & 0xC0) != 0x80) {
+            if (columns == width) {
+                return line.substr(0, i);
+            }
+            ++columns;
+        }
+    }
+    return line;
+}
+
+void ScreenRenderer::getTerminalSize(int& rows, int& cols) {
+    rows = 24;
+    cols = 80;
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        cols = info.srWindow.Right - info.srWindow.Left + 1;
+        rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+    }
+#else
+    struct winsize ws;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_row > 0 && ws.ws_col > 0) {
+        rows = ws.ws_row;
+        cols = ws.ws_col;
+    }
+#endif
+}
+
+void ScreenRenderer::writeOut(const std::string& data) {
+    // Все, что уже лежит в буфере cout, должно уйти раньше кадра
+    std::cout.flush();
+#ifdef _WIN32
+    std::fwrite(data.data(), 1, data.size(), stdout);
+    std::fflush(stdout);
+#else
+    std::fflush(stdout);
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(STDOUT_FILENO, data.data() + written, data.size() - written);
+        if (n <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(n);
+    }
+#endif
+}
+
+void ScreenRenderer::present() {
+    int rows, cols;
+    getTerminalSize(rows, cols);
+    // После изменения размера терминал сам переносит и сдвигает старые строки:
+    // сравнивать с frontBuffer бессмысленно, кадр рисуется заново
+    if (rows != frontRows || cols != frontCols) {
+        fullRedraw = true;
+        frontRows = rows;
+        frontCols = cols;
+    }
+
+    std::vector<std::string> lines = splitLines(backBuffer.str());
+    // Последнюю строку терминала не трогаем, чтобы экран не прокручивался
+    if (static_cast<int>(lines.size()) > rows - 1) {
+        lines.resize(rows - 1 > 0 ? rows - 1 : 0);
+    }
+    for (auto& line : lines) {
+        line = fitToWidth(line, cols);
+    }
+
+    std::string out = "\x1b[?25l";
+    if (fullRedraw) {
+        out += "\x1b[H\x1b[2J";
+    }
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (!fullRedraw && i < frontBuffer.size() && frontBuffer[i] == lines[i]) {
+            continue;
+        }
+        out += "\x1b[" + std::to_string(i + 1) + ";1H";
+        out += lines[i];
+        out += "\x1b[K";
+    }
+    if (!fullRedraw) {
+        for (size_t i = lines.size(); i < frontBuffer.size(); ++i) {
+            out += "\x1b[" + std::to_string(i + 1) + ";1H\x1b[K";
+        }
+    }
+
+    out += "\x1b[" + std::to_string(lines.size() + 1) + ";1H\x1b[?25h";
+    writeOut(out);
+
+    frontBuffer = std::move(lines);
+    fullRedraw = false;
+}
+
+void ScreenRenderer::clear() {
+    writeOut("\x1b[H\x1b[2J");
+    invalidate();
+}
+
+void ScreenRenderer::invalidate() {
+    frontBuffer.clear();
+    fullRedraw = true;
+}
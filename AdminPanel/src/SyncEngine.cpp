@@ -0,0 +1,190 @@
+#include "../headers/SyncEngine.hpp"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+bool SyncBatch::empty() const {
+    for (int table = 0; table < SYNC_TABLE_COUNT; ++table) {
+        if (touches(static_cast<SyncTable>(table))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SyncEngine::SyncEngine(std::shared_ptr<DatabaseConnection> connection, std::shared_ptr<User> user,
+                       std::shared_ptr<Game> game, std::shared_ptr<Platform> platform,
+                       std::shared_ptr<Review> review)
+    : db(connection), userMgr(user), gameMgr(game), platformMgr(platform), reviewMgr(review), tombstones(connection) {
+    if (!db || !userMgr || !gameMgr || !platformMgr || !reviewMgr) {
+        throw std::runtime_error("ERROR: Null pointers passed to SyncEngine constructor!");
+    }
+}
+
+const char* SyncEngine::tableName(SyncTable table) {
+    switch (table) {
+        case SYNC_USER: return "user";
+        case SYNC_CATEGORY: return "category";
+        case SYNC_PLATFORM: return "platform";
+        case SYNC_GAME: return "game";
+        case SYNC_GAME_PLATFORM: return "game_s_platfo";
+        case SYNC_REVIEW: return "review";
+        default: return "";
+    }
+}
+
+SyncTable SyncEngine::tableOf(const std::string& name) {
+    for (int table = 0; table < SYNC_TABLE_COUNT; ++table) {
+        if (name == tableName(static_cast<SyncTable>(table))) {
+            return static_cast<SyncTable>(table);
+        }
+    }
+    return SYNC_TABLE_COUNT;
+}
+
+void SyncEngine::start(const std::string& serverTime) {
+    for (std::string& watermark : watermarks) {
+        watermark = serverTime;
+    }
+}
+
+std::string SyncEngine::getLowWatermark() const {
+    // Формат DATETIME ("YYYY-MM-DD HH:MM:SS") сравнивается как строка
+    return *std::min_element(std::begin(watermarks), std::end(watermarks));
+}
+
+bool SyncEngine::pull(SyncBatch& batch) {
+    try {
+        if (!isStarted()) {
+            return false;
+        }
+        DatabaseConnection::PrimaryReads primary(*db);
+
+        // Время сервера берется до запросов: изменения во время pull попадут в следующий
+        ResultSet clock = tombstones.selectRaw("SELECT NOW(), NOW() - INTERVAL " +
+                                               std::to_string(TOMBSTONE_RETENTION_DAYS) + " DAY;");
+        RowView row;
+        if (!clock.next(row)) {
+            return false;
+        }
+        batch.serverTime = row.toString(0);
+        if (getLowWatermark() < row.toString(1)) {
+            batch.stale = true;
+            return false;
+        }
+
+        // Удаления всех таблиц одним запросом, у каждой таблицы своя отметка
+        std::ostringstream condition;
+        for (int table = 0; table < SYNC_TABLE_COUNT; ++table) {
+            condition << (table ? " OR " : "") << "(TableName = '" << tableName(static_cast<SyncTable>(table))
+                      << "' AND DeletedDate >= DATE_SUB('" << tombstones.escape(watermarks[table])
+                      << "', INTERVAL 60 SECOND))";
+        }
+        condition << " ORDER BY idDeleted";
+        ResultSet deleted = tombstones.selectWhere(condition.str());
+        bool tombstonesRead = deleted.isValid();
+        batch.removed = Repository<DeletedRowData>::materializeAll(std::move(deleted));
+
+        batch.changed[SYNC_USER] = userMgr->scanUsersChangedSince(watermarks[SYNC_USER]);
+        batch.changed[SYNC_CATEGORY] = gameMgr->scanCategoriesChangedSince(watermarks[SYNC_CATEGORY]);
+        batch.changed[SYNC_PLATFORM] = platformMgr->scanPlatformsChangedSince(watermarks[SYNC_PLATFORM]);
+        batch.changed[SYNC_GAME] = gameMgr->scanGamesChangedSince(watermarks[SYNC_GAME]);
+        batch.changed[SYNC_GAME_PLATFORM] = platformMgr->scanGamePlatformsChangedSince(watermarks[SYNC_GAME_PLATFORM]);
+        for (int table = 0; table < SYNC_REVIEW; ++table) {
+            batch.pulled[table] = tombstonesRead && batch.changed[table].isValid();
+            batch.changedRows[table] = batch.changed[table] ? batch.changed[table].getRowCount() : 0;
+        }
+
+        // Отзывы в каталоге - только рейтинги: пересчитываем игры с новыми, измененными и удаленными отзывами
+        ResultSet reviewed = reviewMgr->scanReviewedGamesSince(watermarks[SYNC_REVIEW]);
+        bool reviewsRead = tombstonesRead && reviewed.isValid();
+        for (const RowView& reviewedRow : reviewed) {
+            batch.ratedGames.push_back(reviewedRow.asInt(0));
+        }
+        batch.changedRows[SYNC_REVIEW] = batch.ratedGames.size();
+        for (const DeletedRowData& removed : batch.removed) {
+            SyncTable table = tableOf(removed.tableName);
+            if (table == SYNC_TABLE_COUNT) {
+                continue;
+            }
+            ++batch.removedRows[table];
+            if (table == SYNC_REVIEW) {
+                batch.ratedGames.push_back(removed.rowId2);
+            }
+        }
+        std::sort(batch.ratedGames.begin(), batch.ratedGames.end());
+        batch.ratedGames.erase(std::unique(batch.ratedGames.begin(), batch.ratedGames.end()),
+                               batch.ratedGames.end());
+
+        if (reviewsRead && batch.ratedGames.size() > MAX_RATED_GAMES) {
+            batch.ratingsFull = true;
+            batch.ratings = reviewMgr->scanRatingsByGame();
+            reviewsRead = batch.ratings.isValid();
+        } else if (reviewsRead && !batch.ratedGames.empty()) {
+            batch.ratings = reviewMgr->scanRatingsForGames(batch.ratedGames);
+            reviewsRead = batch.ratings.isValid();
+        }
+        batch.pulled[SYNC_REVIEW] = reviewsRead;
+
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in SyncEngine::pull: " << e.what() << "\n";
+        return false;
+    }
+}
+
+void SyncEngine::apply(SyncBatch& batch, Catalog& catalog) {
+    // Удаления раньше upsert: строка, удаленная и вставленная заново, останется
+    std::vector<int> removedGames;
+    std::vector<std::pair<int, int>> removedLinks;
+    for (const DeletedRowData& removed : batch.removed) {
+        SyncTable table = tableOf(removed.tableName);
+        if (table == SYNC_TABLE_COUNT || !batch.pulled[table]) {
+            continue;
+        }
+        switch (table) {
+            case SYNC_USER: catalog.removeUser(removed.rowId); break;
+            case SYNC_CATEGORY: catalog.removeCategory(removed.rowId); break;
+            case SYNC_PLATFORM: catalog.removePlatform(removed.rowId); break;
+            case SYNC_GAME: removedGames.push_back(removed.rowId); break;
+            case SYNC_GAME_PLATFORM: removedLinks.emplace_back(removed.rowId, removed.rowId2); break;
+            default: break;
+        }
+    }
+    catalog.removeGamePlatforms(removedLinks);
+    catalog.removeGames(removedGames);
+
+    // Категории раньше игр, игры раньше связей
+    if (batch.pulled[SYNC_USER]) catalog.applyUsers(std::move(batch.changed[SYNC_USER]));
+    if (batch.pulled[SYNC_CATEGORY]) catalog.applyCategories(std::move(batch.changed[SYNC_CATEGORY]));
+    if (batch.pulled[SYNC_PLATFORM]) catalog.applyPlatforms(std::move(batch.changed[SYNC_PLATFORM]));
+    if (batch.pulled[SYNC_GAME]) catalog.applyGames(std::move(batch.changed[SYNC_GAME]));
+    if (batch.pulled[SYNC_GAME_PLATFORM]) catalog.applyGamePlatforms(std::move(batch.changed[SYNC_GAME_PLATFORM]));
+    catalog.buildIndexes();
+
+    // Игры без оставшихся отзывов в выборку агрегатов не попадут - сначала обнуляем
+    if (batch.pulled[SYNC_REVIEW]) {
+        if (batch.ratingsFull) {
+            const Column<int32_t>& gameIds = catalog.getGames().id;
+            for (size_t i = 0; i < gameIds.size(); ++i) {
+                catalog.setGameRating(gameIds[i], 0, 0);
+            }
+        } else {
+            for (int gameId : batch.ratedGames) {
+                catalog.setGameRating(gameId, 0, 0);
+            }
+        }
+        catalog.applyRatings(std::move(batch.ratings));
+    }
+
+    advance(batch);
+    catalog.setWatermark(getLowWatermark());
+}
+
+void SyncEngine::advance(const SyncBatch& batch) {
+    for (int table = 0; table < SYNC_TABLE_COUNT; ++table) {
+        if (batch.pulled[table]) {
+            watermarks[table] = batch.serverTime;
+        }
+    }
+}
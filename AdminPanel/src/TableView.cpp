@@ -0,0 +1,198 @@
+#include "../headers/TableView.hpp"
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+// Строки экрана вокруг таблицы: заголовок, шапка колонок, подвал
+static const int TABLE_CHROME_ROWS = 10;
+
+TableView::TableView(const std::string& title, std::vector<TableColumn> columns,
+                     TableDataSource source, int pageSize, size_t maxCachedPages)
+    : title(title), columns(std::move(columns)), source(std::move(source)),
+      pageSize(pageSize > 0 ? pageSize : 100),
+      maxCachedPages(maxCachedPages > 0 ? maxCachedPages : 1) {
+    if (!this->source.countRows || !this->source.fetchRows) {
+        throw std::runtime_error("ERROR: TableView requires a data source!");
+    }
+    // Сортировка по умолчанию - первая сортируемая колонка
+    for (size_t i = 0; i < this->columns.size(); ++i) {
+        if (!this->columns[i].sortKey.empty()) {
+            sortColumn = static_cast<int>(i);
+            break;
+        }
+    }
+}
+
+std::string TableView::padCell(const std::string& text, int width) {
+    // Ширина в кодовых точках: setw считает байты и ломает кириллицу
+    std::vector<size_t> starts;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if ((static_cast<unsigned char>(text[i]) & 0xC0) != 0x80) {
+            starts.push_back(i);
+        }
+    }
+
+    int length = static_cast<int>(starts.size());
+    if (length >= width) {
+        int keep = std::max(width - 4, 0);
+        return text.substr(0, keep < length ? starts[keep] : text.size()) + "... ";
+    }
+    return text + std::string(width - length, ' ');
+}
+
+std::string TableView::formatRow(const TableRow& row) const {
+    std::string line;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        line += padCell(i < row.cells.size() ? row.cells[i] : "", columns[i].width);
+    }
+    return line;
+}
+
+std::string TableView::formatHeader() const {
+    std::string line;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        std::string name = columns[i].title;
+        if (static_cast<int>(i) == sortColumn && !columns[i].sortKey.empty()) {
+            name += ascending ? " ▲" : " ▼";
+        }
+        line += padCell(name, columns[i].width);
+    }
+    return line;
+}
+
+void TableView::clearCache() {
+    pages.clear();
+    lru.clear();
+}
+
+const TableView::CachedPage& TableView::getPage(int pageIndex) {
+    auto it = pages.find(pageIndex);
+    if (it != pages.end()) {
+        lru.splice(lru.begin(), lru, it->second.lruPosition);
+        return it->second;
+    }
+
+    // Вытесняем самую старую страницу: память ограничена maxCachedPages * pageSize
+    if (pages.size() >= maxCachedPages && !lru.empty()) {
+        pages.erase(lru.back());
+        lru.pop_back();
+    }
+
+    CachedPage page;
+    try {
+        const std::string& sortKey = columns.empty() ? std::string() : columns[sortColumn].sortKey;
+        std::vector<TableRow> rows = source.fetchRows(pageIndex * pageSize, pageSize,
+                                                      sortKey, ascending);
+        page.ids.reserve(rows.size());
+        page.lines.reserve(rows.size());
+        for (const auto& row : rows) {
+            page.ids.push_back(row.id);
+            page.lines.push_back(formatRow(row));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR in TableView::getPage: " << e.what() << "\n";
+    }
+
+    lru.push_front(pageIndex);
+    page.lruPosition = lru.begin();
+    return pages.emplace(pageIndex, std::move(page)).first->second;
+}
+
+void TableView::render(ScreenRenderer& screen, int visibleRows, bool selectable) {
+    screen.beginFrame();
+    std::ostream& out = screen.frame();
+
+    std::string header = formatHeader();
+    std::string rule;
+    for (int i = 0; i < 70; ++i) rule += "─";
+
+    out << "\n════════════════════════════════════════════════\n";
+    out << " " << title << "\n";
+    out << "════════════════════════════════════════════════\n";
+    out << "  " << header << "\n";
+    out << rule << "\n";
+
+    if (rowCount == 0) {
+        out << "[ℹ] No rows.\n";
+    }
+    for (int r = topRow; r < std::min(topRow + visibleRows, rowCount); ++r) {
+        const CachedPage& page = getPage(r / pageSize);
+        size_t index = static_cast<size_t>(r % pageSize);
+        std::string line = index < page.lines.size() ? page.lines[index] : "";
+        out << (r == cursor ? "▶ " : "  ") << line << "\n";
+    }
+
+    out << rule << "\n";
+    out << " Rows " << (rowCount == 0 ? 0 : cursor + 1) << " / " << rowCount << "\n";
+    out << "[↑/↓ PgUp/PgDn Home/End Scroll] [←/→ Sort column] [R Reverse]"
+        << (selectable ? " [Enter Select]" : "") << " [ESC Back]\n";
+    screen.present();
+}
+
+void TableView::changeSort(int direction) {
+    int count = static_cast<int>(columns.size());
+    for (int step = 1; step <= count; ++step) {
+        int candidate = ((sortColumn + direction * step) % count + count) % count;
+        if (!columns[candidate].sortKey.empty()) {
+            sortColumn = candidate;
+            break;
+        }
+    }
+    clearCache();
+    topRow = cursor = 0;
+}
+
+void TableView::refresh() {
+    clearCache();
+    rowCount = std::max(source.countRows(), 0);
+    cursor = std::min(cursor, std::max(rowCount - 1, 0));
+    topRow = std::min(topRow, cursor);
+}
+
+int TableView::show(ScreenRenderer& screen, TerminalInput& input, bool selectable) {
+    refresh();
+
+    while (true) {
+        int termRows, termCols;
+        ScreenRenderer::getTerminalSize(termRows, termCols);
+        int visibleRows = std::max(termRows - TABLE_CHROME_ROWS, 3);
+
+        // Курсор всегда в видимом окне
+        if (cursor < topRow) topRow = cursor;
+        if (cursor >= topRow + visibleRows) topRow = cursor - visibleRows + 1;
+
+        render(screen, visibleRows, selectable);
+
+        KeyEvent key = input.readKey();
+        switch (key.code) {
+            case KeyCode::ESCAPE: return -1;
+            case KeyCode::UP: cursor--; break;
+            case KeyCode::DOWN: cursor++; break;
+            case KeyCode::PAGE_UP: cursor -= visibleRows; break;
+            case KeyCode::PAGE_DOWN: cursor += visibleRows; break;
+            case KeyCode::HOME: cursor = 0; break;
+            case KeyCode::END: cursor = rowCount - 1; break;
+            case KeyCode::LEFT: changeSort(-1); break;
+            case KeyCode::RIGHT: changeSort(1); break;
+            case KeyCode::CHAR:
+                if (key.text == "r" || key.text == "R") {
+                    ascending = !ascending;
+                    clearCache();
+                    topRow = cursor = 0;
+                }
+                break;
+            case KeyCode::ENTER:
+                if (selectable && rowCount > 0) {
+                    const CachedPage& page = getPage(cursor / pageSize);
+                    size_t index = static_cast<size_t>(cursor % pageSize);
+                    if (index < page.ids.size()) {
+                        return page.ids[index];
+                    }
+                }
+                break;
+            default: break;
+        }
+
+        cursor = std::max(0, std::min(cursor, rowCount - 1));
+    }
+}
@@ -0,0 +1,319 @@
+#include "../headers/TerminalInput.hpp"
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+
+#ifndef _WIN32
+    #include <poll.h>
+#endif
+
+// Сколько ждать продолжения после ESC, прежде чем считать его отдельной клавишей
+static const int ESCAPE_WAIT_MS = 30;
+
+#ifndef _WIN32
+// Исходные настройки общие для процесса: их восстанавливают и обработчик SIGINT, и atexit
+static struct termios originalSettings;
+static volatile sig_atomic_t haveOriginal = 0;
+#endif
+
+TerminalInput::TerminalInput() {
+}
+
+TerminalInput::~TerminalInput() {
+    restoreMode();
+}
+
+void TerminalInput::enterRawMode() {
+    if (rawMode) {
+        return;
+    }
+#ifndef _WIN32
+    if (!isatty(STDIN_FILENO)) {
+        return;
+    }
+    if (!haveOriginal) {
+        if (tcgetattr(STDIN_FILENO, &originalSettings) != 0) {
+            return;
+        }
+        haveOriginal = 1;
+        std::atexit(&TerminalInput::restoreTerminal);
+    }
+
+    // ISIG и OPOST оставляем: Ctrl+C отменяет запрос, '\n' в выводе работает как раньше
+    struct termios raw = originalSettings;
+    raw.c_lflag &= ~(ICANON | ECHO | IEXTEN);
+    raw.c_iflag &= ~(IXON);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+#endif
+    rawMode = true;
+}
+
+void TerminalInput::restoreMode() {
+    if (!rawMode) {
+        return;
+    }
+#ifndef _WIN32
+    if (haveOriginal) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &originalSettings);
+    }
+#endif
+    rawMode = false;
+}
+
+void TerminalInput::restoreTerminal() {
+#ifndef _WIN32
+    if (haveOriginal) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &originalSettings);
+    }
+#endif
+}
+
+// ============= TIMERS =============
+
+int TerminalInput::addTimer(int intervalMs, std::function<void()> callback) {
+    Timer timer;
+    timer.id = nextTimerId++;
+    timer.interval = std::chrono::milliseconds(std::max(intervalMs, 1));
+    timer.due = std::chrono::steady_clock::now() + timer.interval;
+    timer.callback = std::move(callback);
+    timers.push_back(std::move(timer));
+    return timers.back().id;
+}
+
+void TerminalInput::removeTimer(int timerId) {
+    timers.erase(std::remove_if(timers.begin(), timers.end(),
+                                [timerId](const Timer& t) { return t.id == timerId; }),
+                 timers.end());
+}
+
+int TerminalInput::msUntilNextTimer() const {
+    if (timers.empty()) {
+        return -1;
+    }
+    auto now = std::chrono::steady_clock::now();
+    auto next = timers.front().due;
+    for (const auto& timer : timers) {
+        next = std::min(next, timer.due);
+    }
+    if (next <= now) {
+        return 0;
+    }
+    return static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count()) + 1;
+}
+
+void TerminalInput::fireDueTimers() {
+    // Callback может добавить или удалить таймер - сначала собираем
+    auto now = std::chrono::steady_clock::now();
+    std::vector<std::function<void()>> due;
+    for (auto& timer : timers) {
+        if (timer.due <= now) {
+            timer.due = now + timer.interval;
+            due.push_back(timer.callback);
+        }
+    }
+    for (auto& callback : due) {
+        callback();
+    }
+}
+
+// ============= LOW-LEVEL INPUT =============
+
+bool TerminalInput::waitReadable(int timeoutMs) {
+#ifdef _WIN32
+    if (_kbhit()) {
+        return true;
+    }
+    HANDLE in = GetStdHandle(STD_INPUT_HANDLE);
+    DWORD result = WaitForSingleObject(in, timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs));
+    return result == WAIT_OBJECT_0 && _kbhit();
+#else
+    struct pollfd pfd;
+    pfd.fd = STDIN_FILENO;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int ready = poll(&pfd, 1, timeoutMs);
+    return ready > 0 && (pfd.revents & (POLLIN | POLLHUP));
+#endif
+}
+
+bool TerminalInput::fillPending(int timeoutMs) {
+    if (!waitReadable(timeoutMs)) {
+        return false;
+    }
+#ifdef _WIN32
+    // Префикс 0/224 переводим в ANSI, чтобы разбор был один на все ОС
+    while (_kbhit()) {
+        int ch = _getch();
+        if (ch == 0 || ch == 224) {
+            switch (_getch()) {
+                case 72: pending += "\x1b[A"; break;
+                case 80: pending += "\x1b[B"; break;
+                case 77: pending += "\x1b[C"; break;
+                case 75: pending += "\x1b[D"; break;
+                case 73: pending += "\x1b[5~"; break;
+                case 81: pending += "\x1b[6~"; break;
+                case 71: pending += "\x1b[H"; break;
+                case 79: pending += "\x1b[F"; break;
+                case 83: pending += "\x1b[3~"; break;
+                default: break;
+            }
+        } else {
+            pending += static_cast<char>(ch);
+        }
+    }
+    return true;
+#else
+    char buffer[64];
+    ssize_t n = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+    if (n == 0) {
+        endOfInput = true;
+    }
+    if (n <= 0) {
+        return false;
+    }
+    pending.append(buffer, static_cast<size_t>(n));
+    return true;
+#endif
+}
+
+bool TerminalInput::parseKey(KeyEvent& key) {
+    unsigned char c = static_cast<unsigned char>(pending[0]);
+    key = KeyEvent();
+
+    if (c == 27) {
+        if (pending.size() == 1) {
+            return false;
+        }
+        char introducer = pending[1];
+        if (introducer != '[' && introducer != 'O') {
+            // Alt+клавиша - считаем отдельным ESC
+            pending.erase(0, 1);
+            key.code = KeyCode::ESCAPE;
+            return true;
+        }
+
+        // CSI/SS3: параметры 0x30-0x3F, затем финальный байт
+        size_t i = 2;
+        while (i < pending.size() && pending[i] >= 0x30 && pending[i] <= 0x3F) {
+            ++i;
+        }
+        if (i >= pending.size()) {
+            return false;
+        }
+        char final = pending[i];
+        std::string params = pending.substr(2, i - 2);
+        pending.erase(0, i + 1);
+
+        switch (final) {
+            case 'A': key.code = KeyCode::UP; break;
+            case 'B': key.code = KeyCode::DOWN; break;
+            case 'C': key.code = KeyCode::RIGHT; break;
+            case 'D': key.code = KeyCode::LEFT; break;
+            case 'H': key.code = KeyCode::HOME; break;
+            case 'F': key.code = KeyCode::END; break;
+            case '~': {
+                int number = params.empty() ? 0 : std::atoi(params.c_str());
+                switch (number) {
+                    case 1: case 7: key.code = KeyCode::HOME; break;
+                    case 4: case 8: key.code = KeyCode::END; break;
+                    case 3: key.code = KeyCode::DELETE_KEY; break;
+                    case 5: key.code = KeyCode::PAGE_UP; break;
+                    case 6: key.code = KeyCode::PAGE_DOWN; break;
+                    default: break;
+                }
+                break;
+            }
+            default: break;
+        }
+        return true;
+    }
+
+    if (c == '\r' || c == '\n') {
+        size_t length = (c == '\r' && pending.size() > 1 && pending[1] == '\n') ? 2 : 1;
+        pending.erase(0, length);
+        key.code = KeyCode::ENTER;
+        return true;
+    }
+    if (c == 127 || c == 8) {
+        pending.erase(0, 1);
+        key.code = KeyCode::BACKSPACE;
+        return true;
+    }
+    if (c == '\t') {
+        pending.erase(0, 1);
+        key.code = KeyCode::TAB;
+        return true;
+    }
+    if (c < 32) {
+        pending.erase(0, 1);
+        return true;
+    }
+
+    size_t length = 1;
+    if ((c >> 5) == 0x6) length = 2;
+    else if ((c >> 4) == 0xE) length = 3;
+    else if ((c >> 3) == 0x1E) length = 4;
+    if (pending.size() < length) {
+        return false;
+    }
+    key.code = KeyCode::CHAR;
+    key.text = pending.substr(0, length);
+    pending.erase(0, length);
+    return true;
+}
+
+// ============= KEY READING =============
+
+KeyEvent TerminalInput::readKey() {
+    return readKey(-1);
+}
+
+KeyEvent TerminalInput::readKey(int timeoutMs) {
+    enterRawMode();
+
+    auto start = std::chrono::steady_clock::now();
+    while (true) {
+        if (!pending.empty()) {
+            KeyEvent key;
+            if (parseKey(key)) {
+                if (key.code != KeyCode::NONE) {
+                    return key;
+                }
+                continue;
+            }
+            // Неполная последовательность: ждем хвост, иначе это одиночный ESC
+            if (!fillPending(ESCAPE_WAIT_MS)) {
+                bool loneEscape = pending == "\x1b";
+                pending.clear();
+                if (loneEscape) {
+                    key.code = KeyCode::ESCAPE;
+                    return key;
+                }
+            }
+            continue;
+        }
+
+        fireDueTimers();
+
+        int wait = msUntilNextTimer();
+        if (timeoutMs >= 0) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            int remaining = timeoutMs - static_cast<int>(elapsed);
+            if (remaining <= 0) {
+                return KeyEvent();
+            }
+            wait = wait < 0 ? remaining : std::min(wait, remaining);
+        }
+
+        if (!fillPending(wait) && endOfInput) {
+            // stdin закрыт (EOF) - дальше ждать нечего
+            KeyEvent key;
+            key.code = KeyCode::ESCAPE;
+            return key;
+        }
+    }
+}
@@ -0,0 +1,253 @@
+#include "../headers/TrendingGames.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Веса до e^40: сумма миллиардов отзывов далека от переполнения double
+const double MAX_EXPONENT = 40.0;
+// Нечетные множители multiply-shift хеширования, по одному на строку скетча
+const uint64_t SKETCH_SEEDS[TrendingGames::SKETCH_DEPTH] = {
+    0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0xD6E8FEB86659FD93ULL};
+const uint64_t PLATFORM_KEY = 1ULL << 63;
+
+uint64_t gameKey(int gameId) {
+    return static_cast<uint32_t>(gameId);
+}
+
+uint64_t platformGameKey(int platformId, int gameId) {
+    return PLATFORM_KEY | (static_cast<uint64_t>(static_cast<uint32_t>(platformId) & 0x7FFFFFFF) << 32) |
+           static_cast<uint32_t>(gameId);
+}
+}
+
+// ============= COUNT-MIN SKETCH =============
+
+TrendingGames::CountMinSketch::CountMinSketch()
+    : cells(static_cast<size_t>(SKETCH_DEPTH) << SKETCH_WIDTH_BITS, 0.0) {}
+
+size_t TrendingGames::CountMinSketch::cell(uint32_t row, uint64_t key) const {
+    // Перемешивание ключа, затем старшие биты произведения - столбец
+    uint64_t mixed = (key ^ (key >> 29)) * SKETCH_SEEDS[row];
+    mixed ^= mixed >> 32;
+    mixed *= SKETCH_SEEDS[(row + 1) % SKETCH_DEPTH];
+    return (static_cast<size_t>(row) << SKETCH_WIDTH_BITS) + static_cast<size_t>(mixed >> (64 - SKETCH_WIDTH_BITS));
+}
+
+void TrendingGames::CountMinSketch::add(uint64_t key, double weight) {
+    for (uint32_t row = 0; row < SKETCH_DEPTH; ++row) {
+        cells[cell(row, key)] += weight;
+    }
+}
+
+double TrendingGames::CountMinSketch::estimate(uint64_t key) const {
+    double result = cells[cell(0, key)];
+    for (uint32_t row = 1; row < SKETCH_DEPTH; ++row) {
+        result = std::min(result, cells[cell(row, key)]);
+    }
+    return result;
+}
+
+void TrendingGames::CountMinSketch::scale(double factor) {
+    for (double& value : cells) {
+        value *= factor;
+    }
+}
+
+void TrendingGames::CountMinSketch::clear() {
+    std::fill(cells.begin(), cells.end(), 0.0);
+}
+
+// ============= SPACE-SAVING =============
+
+void TrendingGames::SpaceSaving::swapCounters(uint32_t a, uint32_t b) {
+    std::swap(heap[a], heap[b]);
+    position[heap[a].gameId] = a;
+    position[heap[b].gameId] = b;
+}
+
+void TrendingGames::SpaceSaving::siftUp(uint32_t index) {
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (heap[parent].count <= heap[index].count) {
+            return;
+        }
+        swapCounters(parent, index);
+        index = parent;
+    }
+}
+
+void TrendingGames::SpaceSaving::siftDown(uint32_t index) {
+    uint32_t size = static_cast<uint32_t>(heap.size());
+    while (true) {
+        uint32_t smallest = index;
+        uint32_t left = 2 * index + 1;
+        uint32_t right = left + 1;
+        if (left < size && heap[left].count < heap[smallest].count) smallest = left;
+        if (right < size && heap[right].count < heap[smallest].count) smallest = right;
+        if (smallest == index) {
+            return;
+        }
+        swapCounters(index, smallest);
+        index = smallest;
+    }
+}
+
+void TrendingGames::SpaceSaving::add(int gameId, double weight, int mark) {
+    double markSum = mark > 0 ? weight * mark : 0.0;
+    double markWeight = mark > 0 ? weight : 0.0;
+
+    auto it = position.find(gameId);
+    if (it != position.end()) {
+        Counter& counter = heap[it->second];
+        counter.count += weight;
+        counter.markSum += markSum;
+        counter.markWeight += markWeight;
+        siftDown(it->second);
+        return;
+    }
+    if (heap.size() < capacity) {
+        heap.push_back({gameId, weight, 0.0, markSum, markWeight});
+        position[gameId] = static_cast<uint32_t>(heap.size() - 1);
+        siftUp(static_cast<uint32_t>(heap.size() - 1));
+        return;
+    }
+    if (heap.empty()) {
+        return;
+    }
+    // Вытесняется наименьший: его счет - верхняя граница пропущенного у нового ключа
+    position.erase(heap[0].gameId);
+    double evicted = heap[0].count;
+    heap[0] = {gameId, evicted + weight, evicted, markSum, markWeight};
+    position[gameId] = 0;
+    siftDown(0);
+}
+
+void TrendingGames::SpaceSaving::scale(double factor) {
+    for (Counter& counter : heap) {
+        counter.count *= factor;
+        counter.error *= factor;
+        counter.markSum *= factor;
+        counter.markWeight *= factor;
+    }
+}
+
+size_t TrendingGames::SpaceSaving::memoryUsage() const {
+    return heap.capacity() * sizeof(Counter) + position.size() * (sizeof(int) + sizeof(uint32_t) + 2 * sizeof(void*));
+}
+
+// ============= TRENDING GAMES =============
+
+TrendingGames::TrendingGames(double halfLifeSeconds, size_t candidates)
+    : lambda(std::log(2.0) / (halfLifeSeconds > 0 ? halfLifeSeconds : DEFAULT_HALF_LIFE)),
+      candidates(std::max<size_t>(candidates, 1)),
+      all(this->candidates) {}
+
+void TrendingGames::clear() {
+    started = false;
+    landmark = 0;
+    sketch.clear();
+    all = SpaceSaving(candidates);
+    byCategory.clear();
+    byPlatform.clear();
+}
+
+void TrendingGames::rebase(int64_t time) {
+    double factor = std::exp(-lambda * static_cast<double>(time - landmark));
+    sketch.scale(factor);
+    all.scale(factor);
+    for (auto& entry : byCategory) {
+        entry.second.scale(factor);
+    }
+    for (auto& entry : byPlatform) {
+        entry.second.scale(factor);
+    }
+    landmark = time;
+}
+
+double TrendingGames::decayTo(int64_t now) const {
+    return std::exp(-lambda * static_cast<double>(now - landmark));
+}
+
+void TrendingGames::add(int gameId, int categoryId, int platformId, int mark, int64_t time) {
+    if (!started) {
+        landmark = time;
+        started = true;
+    } else if (lambda * static_cast<double>(time - landmark) > MAX_EXPONENT) {
+        rebase(time);
+    }
+    double weight = std::exp(lambda * static_cast<double>(time - landmark));
+    if (weight <= 0) {
+        return;
+    }
+
+    sketch.add(gameKey(gameId), weight);
+    all.add(gameId, weight, mark);
+    if (categoryId > 0) {
+        byCategory.try_emplace(categoryId, SCOPED_CANDIDATES).first->second.add(gameId, weight, mark);
+    }
+    if (platformId > 0) {
+        sketch.add(platformGameKey(platformId, gameId), weight);
+        byPlatform.try_emplace(platformId, SCOPED_CANDIDATES).first->second.add(gameId, weight, mark);
+    }
+}
+
+std::vector<TrendingGame> TrendingGames::rank(const SpaceSaving& summary, bool perPlatform, int platformId,
+                                              size_t limit, int64_t now) const {
+    std::vector<TrendingGame> result;
+    double decay = decayTo(now);
+    for (const SpaceSaving::Counter& counter : summary.counters()) {
+        // Обе оценки завышены: берется меньшая
+        double sketched = sketch.estimate(perPlatform ? platformGameKey(platformId, counter.gameId)
+                                                      : gameKey(counter.gameId));
+        double score = std::min(counter.count, sketched);
+        double error = std::min(counter.error, score);
+        double avgMark = counter.markWeight > 0 ? counter.markSum / counter.markWeight : 0.0;
+        result.push_back({counter.gameId, score * decay, error * decay, avgMark});
+    }
+    std::sort(result.begin(), result.end(), [](const TrendingGame& a, const TrendingGame& b) {
+        return a.score != b.score ? a.score > b.score : a.gameId < b.gameId;
+    });
+    if (result.size() > limit) {
+        result.resize(limit);
+    }
+    return result;
+}
+
+std::vector<TrendingGame> TrendingGames::top(Scope scope, int scopeId, size_t limit, int64_t now) const {
+    if (scope == ALL) {
+        return rank(all, false, 0, limit, now);
+    }
+    const std::map<int, SpaceSaving>& index = scope == CATEGORY ? byCategory : byPlatform;
+    auto it = index.find(scopeId);
+    if (it == index.end()) {
+        return {};
+    }
+    // В категории счет игры тот же, что общий: у игры одна категория
+    return rank(it->second, scope == PLATFORM, scopeId, limit, now);
+}
+
+double TrendingGames::estimate(int gameId, int64_t now) const {
+    return started ? sketch.estimate(gameKey(gameId)) * decayTo(now) : 0.0;
+}
+
+std::vector<int> TrendingGames::scopeIds(Scope scope) const {
+    std::vector<int> ids;
+    const std::map<int, SpaceSaving>* index = scope == CATEGORY ? &byCategory : scope == PLATFORM ? &byPlatform : nullptr;
+    if (index) {
+        for (const auto& entry : *index) {
+            ids.push_back(entry.first);
+        }
+    }
+    return ids;
+}
+
+size_t TrendingGames::memoryUsage() const {
+    size_t total = sketch.memoryUsage() + all.memoryUsage();
+    for (const auto& entry : byCategory) {
+        total += entry.second.memoryUsage();
+    }
+    for (const auto& entry : byPlatform) {
+        total += entry.second.memoryUsage();
+    }
+    return total;
+}
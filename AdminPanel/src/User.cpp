@@ -1,225 +1,119 @@
 ﻿#include "../headers/User.hpp"
-#include <sstream>
+#include <cstdio>
 #include <iostream>
 
-User::User(std::shared_ptr<DatabaseConnection> database) : db(database) {
-    if (!db) {
-        throw std::runtime_error("ERROR: Database connection is null!");
-    }
+User::User(std::shared_ptr<DatabaseConnection> database) : repo(database) {
 }
 
-bool User::addUser(const std::string& username, const std::string& passwordHash,
-                   const std::string& privilege) {
-    try {
-        if (username.empty() || passwordHash.empty()) {
-            std::cerr << "ERROR: Username and password cannot be empty!\n";
-            return false;
-        }
+void User::setEventBus(std::shared_ptr<EventBus> bus) {
+    repo.setEventBus(bus);
+}
 
-        std::ostringstream query;
-        query << "INSERT INTO user (Username, PasswordHash, Privilege) VALUES ('"
-              << username << "', '" << passwordHash << "', '" << privilege << "');";
+void User::setOutbox(bool enabled) {
+    repo.setOutbox(enabled);
+}
 
-        return db->executeQuery(query.str());
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in addUser: " << e.what() << "\n";
+bool User::addUser(const std::string& username, const std::string& passwordHash,
+                   const std::string& privilege) {
+    if (username.empty() || passwordHash.empty()) {
+        std::cerr << "ERROR: Username and password cannot be empty!\n";
         return false;
     }
+
+    UserData user = {0, username, passwordHash, privilege, true};
+    return repo.insert(user);
 }
 
 bool User::deleteUser(int userId) {
-    try {
-        if (userId <= 0) {
-            std::cerr << "ERROR: Invalid user ID!\n";
-            return false;
-        }
-
-        std::ostringstream query;
-        query << "DELETE FROM user WHERE idUser = " << userId << ";";
-
-        return db->executeQuery(query.str());
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in deleteUser: " << e.what() << "\n";
+    if (userId <= 0) {
+        std::cerr << "ERROR: Invalid user ID!\n";
         return false;
     }
+    return repo.removeById(userId);
 }
 
 bool User::updateUserPrivilege(int userId, const std::string& newPrivilege) {
-    try {
-        if (userId <= 0 || newPrivilege.empty()) {
-            std::cerr << "ERROR: Invalid user ID or privilege!\n";
-            return false;
-        }
-
-        std::ostringstream query;
-        query << "UPDATE user SET Privilege = '" << newPrivilege
-              << "' WHERE idUser = " << userId << ";";
-
-        return db->executeQuery(query.str());
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in updateUserPrivilege: " << e.what() << "\n";
+    if (userId <= 0 || newPrivilege.empty()) {
+        std::cerr << "ERROR: Invalid user ID or privilege!\n";
         return false;
     }
+
+    UserData user = {userId, "", "", newPrivilege, true};
+    return repo.update(user, &UserData::privilege);
 }
 
 bool User::updateUser(int userId, const std::string& username, const std::string& privilege) {
-    try {
-        if (userId <= 0 || username.empty() || privilege.empty()) {
-            std::cerr << "ERROR: Invalid parameters!\n";
-            return false;
-        }
-
-        std::ostringstream query;
-        query << "UPDATE user SET Username = '" << username << "', Privilege = '"
-              << privilege << "' WHERE idUser = " << userId << ";";
-
-        return db->executeQuery(query.str());
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in updateUser: " << e.what() << "\n";
+    if (userId <= 0 || username.empty() || privilege.empty()) {
+        std::cerr << "ERROR: Invalid parameters!\n";
         return false;
     }
+
+    UserData user = {userId, username, "", privilege, true};
+    return repo.update(user, &UserData::username, &UserData::privilege);
 }
 
 std::vector<UserData> User::getAllUsers() {
-    std::vector<UserData> users;
-    try {
-        std::string query = "SELECT idUser, Username, PasswordHash, Privilege, IsActive FROM user;";
-        MYSQL_RES* result = db->getQueryResult(query);
-
-        if (!result) {
-            std::cerr << "ERROR: Failed to get users from database!\n";
-            return users;
-        }
-
-        MYSQL_ROW row;
-        while ((row = mysql_fetch_row(result))) {
-            UserData user;
-            user.idUser = std::stoi(row[0] ? row[0] : "0");
-            user.username = row[1] ? row[1] : "";
-            user.passwordHash = row[2] ? row[2] : "";
-            user.privilege = row[3] ? row[3] : "user";
-            user.isActive = (row[4] && std::string(row[4]) == "1");
-            users.push_back(user);
-        }
-
-        db->freeResult(result);
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getAllUsers: " << e.what() << "\n";
-    }
-    return users;
+    return repo.findAll();
 }
 
 UserData User::getUserById(int userId) {
     UserData user = {-1, "", "", "", false};
-    try {
-        if (userId <= 0) {
-            std::cerr << "ERROR: Invalid user ID!\n";
-            return user;
-        }
-
-        std::ostringstream query;
-        query << "SELECT idUser, Username, PasswordHash, Privilege, IsActive FROM user WHERE idUser = " << userId << ";";
-
-        MYSQL_RES* result = db->getQueryResult(query.str());
-        if (!result) {
-            return user;
-        }
-
-        MYSQL_ROW row = mysql_fetch_row(result);
-        if (row) {
-            user.idUser = std::stoi(row[0] ? row[0] : "0");
-            user.username = row[1] ? row[1] : "";
-            user.passwordHash = row[2] ? row[2] : "";
-            user.privilege = row[3] ? row[3] : "user";
-            user.isActive = (row[4] && std::string(row[4]) == "1");
-        }
-
-        db->freeResult(result);
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getUserById: " << e.what() << "\n";
+    if (userId <= 0) {
+        std::cerr << "ERROR: Invalid user ID!\n";
+        return user;
     }
+    repo.findById(userId, user);
     return user;
 }
 
 UserData User::getUserByUsername(const std::string& username) {
     UserData user = {-1, "", "", "", false};
-    try {
-        if (username.empty()) {
-            std::cerr << "ERROR: Username cannot be empty!\n";
-            return user;
-        }
-
-        std::ostringstream query;
-        query << "SELECT idUser, Username, PasswordHash, Privilege, IsActive FROM user WHERE Username = '"
-              << username << "';";
-
-        MYSQL_RES* result = db->getQueryResult(query.str());
-        if (!result) {
-            return user;
-        }
-
-        MYSQL_ROW row = mysql_fetch_row(result);
-        if (row) {
-            user.idUser = std::stoi(row[0] ? row[0] : "0");
-            user.username = row[1] ? row[1] : "";
-            user.passwordHash = row[2] ? row[2] : "";
-            user.privilege = row[3] ? row[3] : "user";
-            user.isActive = (row[4] && std::string(row[4]) == "1");
-        }
+    if (username.empty()) {
+        std::cerr << "ERROR: Username cannot be empty!\n";
+        return user;
+    }
 
-        db->freeResult(result);
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getUserByUsername: " << e.what() << "\n";
+    std::vector<UserData> found = repo.findWhere("Username = '" + repo.escape(username) + "'");
+    if (!found.empty()) {
+        user = found.front();
     }
     return user;
 }
 
-int User::getUserCount() {
-    try {
-        std::string query = "SELECT COUNT(*) FROM user;";
-        MYSQL_RES* result = db->getQueryResult(query);
-
-        if (!result) {
-            return 0;
-        }
+std::vector<UserData> User::getUsersPage(int offset, int limit, const std::string& orderBy,
+                                        bool ascending) {
+    return repo.findPage(offset, limit, orderBy, ascending);
+}
 
-        MYSQL_ROW row = mysql_fetch_row(result);
-        int count = 0;
-        if (row && row[0]) {
-            count = std::stoi(row[0]);
-        }
+ResultSet User::scanAllUsers() {
+    return repo.selectAll();
+}
 
-        db->freeResult(result);
-        return count;
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in getUserCount: " << e.what() << "\n";
-        return 0;
-    }
+ResultSet User::scanUsernames() {
+    return repo.selectRaw("SELECT idUser, Username FROM user;");
 }
 
-bool User::userExists(const std::string& username) {
-    try {
-        if (username.empty()) {
-            return false;
-        }
+ResultSet User::scanUsersChangedSince(const std::string& since) {
+    return repo.selectChangedSince(since);
+}
 
-        std::ostringstream query;
-        query << "SELECT COUNT(*) FROM user WHERE Username = '" << username << "';";
+ResultSet User::scanUsersPage(int offset, int limit, const std::string& orderBy, bool ascending) {
+    return repo.selectPage(offset, limit, orderBy, ascending);
+}
 
-        MYSQL_RES* result = db->getQueryResult(query.str());
-        if (!result) {
-            return false;
-        }
+std::vector<UserData> User::getUsersByIds(const std::vector<int>& ids) {
+    return repo.findByIds(ids);
+}
 
-        MYSQL_ROW row = mysql_fetch_row(result);
-        bool exists = (row && row[0] && std::stoi(row[0]) > 0);
+int User::getUserCount() {
+    return repo.count();
+}
 
-        db->freeResult(result);
-        return exists;
-    } catch (const std::exception& e) {
-        std::cerr << "ERROR in userExists: " << e.what() << "\n";
+bool User::userExists(const std::string& username) {
+    if (username.empty()) {
         return false;
     }
+    return repo.count("Username = '" + repo.escape(username) + "'") > 0;
 }
 
 std::string User::hashPassword(const std::string& password) {
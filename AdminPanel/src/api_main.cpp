@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+#include "../headers/DatabaseConnection.hpp"
+#include "../headers/User.hpp"
+#include "../headers/Game.hpp"
+#include "../headers/Review.hpp"
+#include "../headers/Platform.hpp"
+#include "../headers/HttpServer.hpp"
+#include "../headers/GameApi.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+std::atomic<bool> stopRequested{false};
+
+void handleStop(int) {
+    stopRequested = true;
+}
+}
+
+// Публичное read-only API: GET /api/games, /api/games/trending, /api/games/:id, /api/reviews/game/:gameId
+int main() {
+    try {
+        std::ifstream file("config.json");
+        if (!file.is_open()) {
+            std::cerr << "[✗] ERROR: Could not open config.json\n";
+            return 1;
+        }
+        json obj = json::parse(file);
+
+        const auto& dbConfig = obj["database"];
+        ConnectionOptions options;
+        if (dbConfig.contains("timeouts")) {
+            const auto& timeouts = dbConfig["timeouts"];
+            options.connectTimeoutSec = timeouts.value("connect_sec", options.connectTimeoutSec);
+            options.readTimeoutSec = timeouts.value("read_sec", options.readTimeoutSec);
+            options.writeTimeoutSec = timeouts.value("write_sec", options.writeTimeoutSec);
+            options.queryTimeoutSec = timeouts.value("query_sec", options.queryTimeoutSec);
+        }
+
+        std::shared_ptr<DatabaseConnection> db;
+        try {
+            db = std::make_shared<DatabaseConnection>(
+                dbConfig["host"].get<std::string>(),
+                dbConfig["user"].get<std::string>(),
+                dbConfig["password"].get<std::string>(),
+                dbConfig["database"].get<std::string>(),
+                dbConfig.value("port", 3306u),
+                options);
+        } catch (const std::exception& e) {
+            std::cerr << "[✗] FATAL ERROR: Cannot connect to database: " << e.what() << "\n";
+            return 1;
+        }
+        // Снимок читается целиком: реплика подходит лучше всего
+        if (dbConfig.contains("replicas")) {
+            for (const auto& replica : dbConfig["replicas"]) {
+                db->addReplica(replica["host"].get<std::string>(),
+                               replica.value("port", dbConfig.value("port", 3306u)));
+            }
+        }
+
+        User userMgr(db);
+        Game gameMgr(db);
+        Review reviewMgr(db);
+        Platform platformMgr(db);
+
+        json apiConfig = obj.contains("api_server") ? obj["api_server"] : json::object();
+        uint16_t port = apiConfig.value("port", static_cast<uint16_t>(8080));
+        int threads = apiConfig.value("threads", 0);
+        int refreshSec = std::max(apiConfig.value("refresh_sec", 10), 1);
+        std::vector<std::string> origins = apiConfig.value("allowed_origins", std::vector<std::string>{
+            "http://localhost:3000",
+            "https://kursach-ooop.web.app",
+            "https://kursach-ooop.firebaseapp.com"});
+
+        GameApi api(origins);
+        if (apiConfig.contains("trending")) {
+            const auto& trending = apiConfig["trending"];
+            api.setTrending(trending.value("half_life_hours", 72.0) * 3600,
+                            trending.value("candidates", TrendingGames::DEFAULT_CANDIDATES));
+        }
+        if (!api.reload(gameMgr, reviewMgr, platformMgr, userMgr)) {
+            std::cerr << "[✗] FATAL ERROR: Cannot load games from database\n";
+            return 1;
+        }
+        std::cout << "[✓] Loaded " << api.getGameCount() << " active games\n";
+
+        HttpServer server(port, threads, [&api](const HttpRequest& request, HttpResponse& response) {
+            api.handle(request, response);
+        });
+        if (!server.start()) {
+            return 1;
+        }
+        std::cout << "[✓] API listening on http://0.0.0.0:" << port << " (" << server.getThreadCount()
+                  << " threads, refresh every " << refreshSec << "s)\n";
+
+        std::signal(SIGINT, handleStop);
+        std::signal(SIGTERM, handleStop);
+
+        // Обновление снимка - в главном потоке, единственном пользователе соединения с БД
+        auto nextReload = std::chrono::steady_clock::now() + std::chrono::seconds(refreshSec);
+        while (!stopRequested) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            if (std::chrono::steady_clock::now() < nextReload) {
+                continue;
+            }
+            if (!api.reload(gameMgr, reviewMgr, platformMgr, userMgr)) {
+                std::cerr << "[!] Snapshot reload failed, serving previous data\n";
+            }
+            nextReload = std::chrono::steady_clock::now() + std::chrono::seconds(refreshSec);
+        }
+
+        std::cout << "[*] Shutting down...\n";
+        server.stop();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "[✗] FATAL ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
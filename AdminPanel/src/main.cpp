@@ -11,6 +11,9 @@
 #include "../headers/Review.hpp"
 #include "../headers/Platform.hpp"
 #include "../headers/AdminPanel.hpp"
+#include "../headers/AuditLog.hpp"
+#include "../headers/OutboxRelay.hpp"
+#include "../headers/TerminalInput.hpp"
 
 using json = nlohmann::json;
 namespace fs = std::filesystem;
@@ -48,25 +51,64 @@ int main() {
         std::string user = obj["database"]["user"].get<std::string>();
         std::string password = obj["database"]["password"].get<std::string>();
         std::string database = obj["database"]["database"].get<std::string>();
+        unsigned int port = obj["database"].value("port", 3306u);
+
+        ConnectionOptions options;
+        if (obj["database"].contains("timeouts")) {
+            const auto& timeouts = obj["database"]["timeouts"];
+            options.connectTimeoutSec = timeouts.value("connect_sec", options.connectTimeoutSec);
+            options.readTimeoutSec = timeouts.value("read_sec", options.readTimeoutSec);
+            options.writeTimeoutSec = timeouts.value("write_sec", options.writeTimeoutSec);
+            options.queryTimeoutSec = timeouts.value("query_sec", options.queryTimeoutSec);
+        }
+        if (obj["database"].contains("retry")) {
+            const auto& retry = obj["database"]["retry"];
+            options.maxRetries = retry.value("max_retries", options.maxRetries);
+            options.backoffBaseMs = retry.value("backoff_base_ms", options.backoffBaseMs);
+            options.backoffMaxMs = retry.value("backoff_max_ms", options.backoffMaxMs);
+            options.breakerThreshold = retry.value("breaker_threshold", options.breakerThreshold);
+            options.breakerCooldownMs = retry.value("breaker_cooldown_ms", options.breakerCooldownMs);
+        }
         
         try {
             db = std::make_shared<DatabaseConnection>(
                 host,
                 user,
                 password,  
-                database
+                database,
+                port,
+                options
             );
         } catch (const std::exception& e) {
             std::cerr << "\n[✗] FATAL ERROR: Cannot connect to database!\n";
             std::cerr << "    " << e.what() << "\n";
             std::cerr << "\n    Please check:\n";
             std::cerr << "    1. MySQL Server is running\n";
-            std::cerr << "    2. Database 'game_rating' exists\n";
+            std::cerr << "    2. Database '" << database << "' exists\n";
             std::cerr << "    3. Username and password are correct\n";
-            std::cerr << "    4. Port 3306 is accessible\n\n";
+            std::cerr << "    4. " << host << ":" << port << " is accessible\n\n";
             return 1;
         }
 
+        // Ctrl+C во время запроса отменяет запрос (KILL QUERY), а не всю программу;
+        // вне запроса программа завершается, вернув терминал из raw mode
+        db->cancelOnInterrupt(&TerminalInput::restoreTerminal);
+
+        // ========== READ REPLICAS ==========
+        if (obj["database"].contains("replicas")) {
+            for (const auto& replica : obj["database"]["replicas"]) {
+                db->addReplica(replica["host"].get<std::string>(),
+                               replica.value("port", port));
+            }
+        }
+        db->setReadYourWritesWindow(obj["database"].value("read_your_writes_ms", 2000));
+        if (obj["database"].value("read_consistency", std::string("pin")) == "gtid") {
+            db->setReadConsistency(DatabaseConnection::ReadConsistency::GTID_WAIT);
+        }
+        if (db->getReplicaCount() > 0) {
+            std::cout << "[✓] Routing reads to " << db->getReplicaCount() << " replica(s)\n";
+        }
+
         // ========== MANAGERS INITIALIZATION ==========
         std::cout << "[*] Initializing managers...\n";
         
@@ -106,12 +148,92 @@ int main() {
             return 1;
         }
 
+        // ========== CHANGE EVENTS ==========
+        // Каждая запись менеджеров публикуется в общую шину
+        std::shared_ptr<EventBus> events = std::make_shared<EventBus>();
+        userMgr->setEventBus(events);
+        gameMgr->setEventBus(events);
+        reviewMgr->setEventBus(events);
+        platformMgr->setEventBus(events);
+
+        std::unique_ptr<AuditLog> auditLog;
+        if (obj.contains("features") && obj["features"].value("enable_logging", false)) {
+            std::string logFile = obj["features"].value("log_file", std::string("log.log"));
+            auditLog = std::make_unique<AuditLog>(events, logFile);
+            if (auditLog->isOpen()) {
+                std::cout << "[✓] Logging changes to " << logFile << "\n";
+            }
+        }
+
+        // ========== OUTBOX ==========
+        // Записи менеджеров + событие в outbox_event в одной транзакции; relay переносит их в журнал
+        std::unique_ptr<OutboxRelay> outboxRelay;
+        if (obj.contains("outbox") && obj["outbox"].value("enabled", false)) {
+            const auto& outbox = obj["outbox"];
+            std::string logDir = outbox.value("log_dir", std::string("outbox_log"));
+            try {
+                // У relay свое соединение: он работает в отдельном потоке
+                auto relayDb = std::make_shared<DatabaseConnection>(host, user, password, database, port, options);
+                outboxRelay = std::make_unique<OutboxRelay>(
+                    relayDb, logDir,
+                    outbox.value("segment_mb", 64ull) * 1024 * 1024,
+                    std::chrono::milliseconds(outbox.value("poll_ms", 1000)),
+                    outbox.value("batch_size", static_cast<size_t>(1000)));
+                userMgr->setOutbox(true);
+                gameMgr->setOutbox(true);
+                reviewMgr->setOutbox(true);
+                platformMgr->setOutbox(true);
+                std::cout << "[✓] Relaying outbox events to " << logDir << "\n";
+            } catch (const std::exception& e) {
+                std::cerr << "[✗] Outbox disabled: " << e.what() << "\n";
+            }
+        }
+
+        // ========== GAME SUMMARY ==========
+        std::shared_ptr<GameSummary> gameSummary;
+        if (obj.contains("game_summary") && obj["game_summary"].value("enabled", false)) {
+            try {
+                // Свое соединение: пересчет идет пачками в фоновом потоке
+                auto summaryDb = std::make_shared<DatabaseConnection>(host, user, password, database, port, options);
+                gameSummary = std::make_shared<GameSummary>(summaryDb);
+                gameSummary->setEventBus(events);
+                std::cout << "[✓] Maintaining game_summary\n";
+            } catch (const std::exception& e) {
+                std::cerr << "[✗] Game summary disabled: " << e.what() << "\n";
+            }
+        }
+
         // ========== ADMIN PANEL INITIALIZATION ==========
         std::cout << "[*] Starting Admin Panel...\n\n";
         
         std::shared_ptr<AdminPanel> panel;
         try {
             panel = std::make_shared<AdminPanel>(db, userMgr, gameMgr, reviewMgr, platformMgr);
+            panel->setCatalogSnapshotPath(obj.value("catalog_snapshot", std::string()));
+            if (obj.contains("catalog_sync")) {
+                panel->setCatalogSync(obj["catalog_sync"].value("enabled", false));
+            }
+            if (obj.contains("recommendations")) {
+                const auto& recommendations = obj["recommendations"];
+                panel->setRecommendations(recommendations.value("file", std::string()),
+                                          recommendations.value("neighbors", GameRecommender::DEFAULT_NEIGHBORS));
+            }
+            if (obj.contains("features") && obj["features"].value("enable_export", false)) {
+                panel->setExportPath(obj["features"].value("export_file", std::string("export.json")));
+            }
+            if (obj.contains("review_cardinality")) {
+                panel->setReviewCardinalityPath(obj["review_cardinality"].value("file", std::string()));
+            }
+            if (obj.contains("review_anomalies")) {
+                const auto& anomalies = obj["review_anomalies"];
+                ReviewAnomalyDetector::Settings settings;
+                settings.bucketSeconds = anomalies.value("bucket_minutes", settings.bucketSeconds / 60) * 60;
+                settings.zThreshold = anomalies.value("z_threshold", settings.zThreshold);
+                settings.minReviews = anomalies.value("min_reviews", settings.minReviews);
+                panel->setReviewAnomalies(settings, anomalies.value("backfill_days", 14));
+            }
+            panel->setEventBus(events);
+            panel->setGameSummary(gameSummary);
         } catch (const std::exception& e) {
             std::cerr << "[✗] Failed to initialize Admin Panel: " << e.what() << "\n";
             return 1;
@@ -131,6 +253,9 @@ int main() {
         // ========== CLEANUP ==========
         std::cout << "\n[*] Shutting down...\n";
         panel = nullptr;
+        auditLog = nullptr;
+        outboxRelay = nullptr;
+        gameSummary = nullptr;
         userMgr = nullptr;
         gameMgr = nullptr;
         reviewMgr = nullptr;
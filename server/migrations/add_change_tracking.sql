@@ -0,0 +1,87 @@
+-- Change tracking for incremental sync (AdminPanel SyncEngine)
+-- UpdatedDate is set on insert and on every update; deletes leave a row in deleted_row.
+
+ALTER TABLE user ADD COLUMN UpdatedDate DATETIME DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP,
+    ADD INDEX idx_updated (UpdatedDate);
+ALTER TABLE category ADD COLUMN UpdatedDate DATETIME DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP,
+    ADD INDEX idx_updated (UpdatedDate);
+ALTER TABLE platform ADD COLUMN UpdatedDate DATETIME DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP,
+    ADD INDEX idx_updated (UpdatedDate);
+ALTER TABLE game_s_platfo ADD COLUMN UpdatedDate DATETIME DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP,
+    ADD INDEX idx_updated (UpdatedDate);
+ALTER TABLE review ADD COLUMN UpdatedDate DATETIME DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP,
+    ADD INDEX idx_updated (UpdatedDate);
+
+UPDATE game SET UpdatedDate = CreatedDate WHERE UpdatedDate IS NULL;
+ALTER TABLE game MODIFY COLUMN UpdatedDate DATETIME DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP,
+    ADD INDEX idx_updated (UpdatedDate);
+
+-- Tombstones: RowId - primary key; RowId2 - idPlatform for game_s_platfo, idGame for review
+CREATE TABLE IF NOT EXISTS deleted_row (
+    idDeleted BIGINT AUTO_INCREMENT PRIMARY KEY,
+    TableName VARCHAR(32) NOT NULL,
+    RowId INT NOT NULL,
+    RowId2 INT NOT NULL DEFAULT 0,
+    DeletedDate DATETIME DEFAULT CURRENT_TIMESTAMP,
+    INDEX idx_deleted (DeletedDate)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci;
+
+-- ON DELETE CASCADE does not fire triggers of child tables,
+-- so parent triggers record the rows the cascade is about to remove.
+DELIMITER //
+
+CREATE TRIGGER trg_user_deleted BEFORE DELETE ON user FOR EACH ROW
+BEGIN
+    INSERT INTO deleted_row (TableName, RowId, RowId2)
+        SELECT 'review', idReview, idGame FROM review WHERE idUser = OLD.idUser;
+    INSERT INTO deleted_row (TableName, RowId) VALUES ('user', OLD.idUser);
+END//
+
+CREATE TRIGGER trg_category_deleted BEFORE DELETE ON category FOR EACH ROW
+BEGIN
+    INSERT INTO deleted_row (TableName, RowId, RowId2)
+        SELECT 'review', r.idReview, r.idGame FROM review r
+        JOIN game g ON g.idGame = r.idGame WHERE g.idCategory = OLD.idCategory;
+    INSERT INTO deleted_row (TableName, RowId, RowId2)
+        SELECT 'game_s_platfo', gp.idGame, gp.idPlatform FROM game_s_platfo gp
+        JOIN game g ON g.idGame = gp.idGame WHERE g.idCategory = OLD.idCategory;
+    INSERT INTO deleted_row (TableName, RowId)
+        SELECT 'game', idGame FROM game WHERE idCategory = OLD.idCategory;
+    INSERT INTO deleted_row (TableName, RowId) VALUES ('category', OLD.idCategory);
+END//
+
+CREATE TRIGGER trg_game_deleted BEFORE DELETE ON game FOR EACH ROW
+BEGIN
+    INSERT INTO deleted_row (TableName, RowId, RowId2)
+        SELECT 'review', idReview, idGame FROM review WHERE idGame = OLD.idGame;
+    INSERT INTO deleted_row (TableName, RowId, RowId2)
+        SELECT 'game_s_platfo', idGame, idPlatform FROM game_s_platfo WHERE idGame = OLD.idGame;
+    INSERT INTO deleted_row (TableName, RowId) VALUES ('game', OLD.idGame);
+END//
+
+CREATE TRIGGER trg_platform_deleted BEFORE DELETE ON platform FOR EACH ROW
+BEGIN
+    INSERT INTO deleted_row (TableName, RowId, RowId2)
+        SELECT 'review', idReview, idGame FROM review WHERE idPlatform = OLD.idPlatform;
+    INSERT INTO deleted_row (TableName, RowId, RowId2)
+        SELECT 'game_s_platfo', idGame, idPlatform FROM game_s_platfo WHERE idPlatform = OLD.idPlatform;
+    INSERT INTO deleted_row (TableName, RowId) VALUES ('platform', OLD.idPlatform);
+END//
+
+CREATE TRIGGER trg_game_platform_deleted AFTER DELETE ON game_s_platfo FOR EACH ROW
+BEGIN
+    INSERT INTO deleted_row (TableName, RowId, RowId2) VALUES ('game_s_platfo', OLD.idGame, OLD.idPlatform);
+END//
+
+CREATE TRIGGER trg_review_deleted AFTER DELETE ON review FOR EACH ROW
+BEGIN
+    INSERT INTO deleted_row (TableName, RowId, RowId2) VALUES ('review', OLD.idReview, OLD.idGame);
+END//
+
+DELIMITER ;
+
+-- Tombstones older than the sync retention (SyncEngine::TOMBSTONE_RETENTION_DAYS) are not needed:
+-- a client that has been away longer reloads the catalog in full.
+-- Requires SET GLOBAL event_scheduler = ON;
+CREATE EVENT IF NOT EXISTS evt_purge_deleted_row ON SCHEDULE EVERY 1 DAY DO
+    DELETE FROM deleted_row WHERE DeletedDate < NOW() - INTERVAL 30 DAY;
@@ -0,0 +1,38 @@
+-- Denormalized game listing for GET /api/games: one row per game.
+-- Kept up to date by the AdminPanel (GameSummary, config.json: game_summary.enabled)
+-- and by server/services/gameSummary.js after the API's own writes (GAME_SUMMARY_ENABLED=true);
+-- enable both switches together, the listing reads this table only then.
+-- Full rebuild: AdminPanel -> Game Management -> Rebuild Game Summary.
+
+CREATE TABLE IF NOT EXISTS game_summary (
+    idGame INT PRIMARY KEY,
+    Name VARCHAR(255) NOT NULL,
+    Release_year INT,
+    Description TEXT,
+    Production_cost DECIMAL(12,2),
+    idCategory INT,
+    CreatedDate DATETIME,
+    ImageURL VARCHAR(500),
+    IsActive TINYINT DEFAULT 1,
+    CategoryName VARCHAR(100),
+    AvgMark DECIMAL(6,4) NOT NULL DEFAULT 0,
+    ReviewCount INT NOT NULL DEFAULT 0,
+    Platforms VARCHAR(1024),
+    INDEX idx_rating (IsActive, AvgMark, ReviewCount),
+    INDEX idx_reviews (IsActive, ReviewCount),
+    INDEX idx_year (IsActive, Release_year),
+    INDEX idx_name (IsActive, Name),
+    INDEX idx_category (idCategory),
+    CONSTRAINT fk_game_summary_game FOREIGN KEY (idGame) REFERENCES game (idGame) ON DELETE CASCADE
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci;
+
+REPLACE INTO game_summary (idGame, Name, Release_year, Description, Production_cost, idCategory,
+    CreatedDate, ImageURL, IsActive, CategoryName, AvgMark, ReviewCount, Platforms)
+SELECT g.idGame, g.Name, g.Release_year, g.Description, g.Production_cost, g.idCategory,
+    g.CreatedDate, g.ImageURL, g.IsActive, c.CategoryName, COALESCE(AVG(r.Mark), 0),
+    COUNT(DISTINCT r.idReview), GROUP_CONCAT(DISTINCT p.Platform_name)
+FROM game g
+LEFT JOIN category c ON g.idCategory = c.idCategory
+LEFT JOIN review r ON g.idGame = r.idGame AND r.IsActive = 1
+LEFT JOIN platform p ON r.idPlatform = p.idPlatform
+GROUP BY g.idGame;
@@ -0,0 +1,15 @@
+-- Transactional outbox (AdminPanel, config.json: outbox.enabled)
+-- Every manager write inserts its event here in the same transaction;
+-- OutboxRelay moves events to the append-only log and deletes them.
+-- Payload is the row as JSON: after the change, or before it for DELETE.
+-- Rows removed by ON DELETE CASCADE get no event of their own: consumers apply the cascade.
+
+CREATE TABLE IF NOT EXISTS outbox_event (
+    idEvent BIGINT AUTO_INCREMENT PRIMARY KEY,
+    TableName VARCHAR(32) NOT NULL,
+    ChangeType VARCHAR(8) NOT NULL,
+    RowId INT NOT NULL,
+    RowId2 INT NOT NULL DEFAULT 0,
+    Payload JSON NOT NULL,
+    CreatedDate DATETIME(3) DEFAULT CURRENT_TIMESTAMP(3)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci;
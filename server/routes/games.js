@@ -1,6 +1,7 @@
 const express = require('express');
 const pool = require('../config/database');
 const { authenticateToken, requireAdmin, requireModerator } = require('../middleware/auth');
+const { gameSummaryEnabled, refreshGameSummary } = require('../services/gameSummary');
 
 const router = express.Router();
 
@@ -9,7 +10,25 @@ router.get('/', async (req, res) => {
   try {
     const { category, platform, search, sortBy = 'rating', minRating } = req.query;
 
-    let query = `
+    // Precomputed rating, review count and platforms (server/migrations/add_game_summary.sql),
+    // or aggregated per request while game_summary is not maintained
+    let query = gameSummaryEnabled ? `
+      SELECT 
+        g.idGame,
+        g.Name,
+        g.Release_year,
+        g.Description,
+        g.Production_cost,
+        g.idCategory,
+        g.CreatedDate,
+        g.ImageURL,
+        g.CategoryName,
+        g.AvgMark,
+        g.ReviewCount as reviewCount,
+        g.Platforms as platforms
+      FROM game_summary g
+      WHERE g.IsActive = 1
+    ` : `
       SELECT 
         g.idGame,
         g.Name,
@@ -47,17 +66,23 @@ router.get('/', async (req, res) => {
       params.push(`%${search}%`);
     }
 
-    query += ' GROUP BY g.idGame';
+    if (!gameSummaryEnabled) {
+      query += ' GROUP BY g.idGame';
+    }
+
+    // Summary columns filter and sort through the table's index; aggregates only by alias
+    const avgMark = gameSummaryEnabled ? 'g.AvgMark' : 'AvgMark';
+    const reviewCount = gameSummaryEnabled ? 'g.ReviewCount' : 'reviewCount';
 
     if (minRating) {
-      query += ' HAVING AvgMark >= ?';
+      query += gameSummaryEnabled ? ' AND g.AvgMark >= ?' : ' HAVING AvgMark >= ?';
       params.push(minRating);
     }
 
     // Sorting
     switch (sortBy) {
       case 'rating':
-        query += ' ORDER BY AvgMark DESC, reviewCount DESC';
+        query += ` ORDER BY ${avgMark} DESC, ${reviewCount} DESC`;
         break;
       case 'newest':
         query += ' ORDER BY g.Release_year DESC';
@@ -66,10 +91,10 @@ router.get('/', async (req, res) => {
         query += ' ORDER BY g.Name ASC';
         break;
       case 'reviews':
-        query += ' ORDER BY reviewCount DESC';
+        query += ` ORDER BY ${reviewCount} DESC`;
         break;
       default:
-        query += ' ORDER BY AvgMark DESC';
+        query += ` ORDER BY ${avgMark} DESC`;
     }
 
     const [games] = await pool.execute(query, params);
@@ -140,6 +165,8 @@ router.post('/', authenticateToken, requireModerator, async (req, res) => {
       [req.user.idUser, 'CREATE', 'game', result.insertId, JSON.stringify(req.body)]
     );
 
+    await refreshGameSummary(result.insertId);
+
     res.status(201).json({ message: 'Game created successfully', idGame: result.insertId });
   } catch (error) {
     console.error('Create game error:', error);
@@ -170,6 +197,8 @@ router.put('/:id', authenticateToken, requireModerator, async (req, res) => {
       [req.user.idUser, 'UPDATE', 'game', id, JSON.stringify(oldGames[0]), JSON.stringify(req.body)]
     );
 
+    await refreshGameSummary(id);
+
     res.json({ message: 'Game updated successfully' });
   } catch (error) {
     console.error('Update game error:', error);
@@ -197,6 +226,8 @@ router.delete('/:id', authenticateToken, requireAdmin, async (req, res) => {
       [req.user.idUser, 'DELETE', 'game', id, JSON.stringify(oldGames[0])]
     );
 
+    await refreshGameSummary(id);
+
     res.json({ message: 'Game deleted successfully' });
   } catch (error) {
     console.error('Delete game error:', error);
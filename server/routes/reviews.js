@@ -1,6 +1,7 @@
 const express = require('express');
 const pool = require('../config/database');
 const { authenticateToken, requireModerator } = require('../middleware/auth');
+const { refreshGameSummary } = require('../services/gameSummary');
 
 const router = express.Router();
 
@@ -79,6 +80,8 @@ router.post('/game/:gameId', authenticateToken, async (req, res) => {
       [avgMark, gameId]
     );
 
+    await refreshGameSummary(gameId);
+
     // Log activity (optional, may fail if table doesn't exist)
     try {
       await pool.execute(
@@ -113,7 +116,7 @@ router.delete('/:id', authenticateToken, async (req, res) => {
 
     // Check if review exists and get owner
     const [reviews] = await pool.execute(
-      'SELECT idUser FROM review WHERE idReview = ?',
+      'SELECT idUser, idGame FROM review WHERE idReview = ?',
       [id]
     );
 
@@ -131,6 +134,7 @@ router.delete('/:id', authenticateToken, async (req, res) => {
 
     // Soft delete
     await pool.execute('UPDATE review SET IsActive = 0 WHERE idReview = ?', [id]);
+    await refreshGameSummary(reviews[0].idGame);
 
     // Log activity
     await pool.execute(
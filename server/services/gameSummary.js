@@ -0,0 +1,34 @@
+const pool = require('../config/database');
+
+// Same row as AdminPanel GameSummary (server/migrations/add_game_summary.sql)
+const REFRESH_SQL = `
+  REPLACE INTO game_summary (idGame, Name, Release_year, Description, Production_cost, idCategory,
+    CreatedDate, ImageURL, IsActive, CategoryName, AvgMark, ReviewCount, Platforms)
+  SELECT g.idGame, g.Name, g.Release_year, g.Description, g.Production_cost, g.idCategory,
+    g.CreatedDate, g.ImageURL, g.IsActive, c.CategoryName, COALESCE(AVG(r.Mark), 0),
+    COUNT(DISTINCT r.idReview), GROUP_CONCAT(DISTINCT p.Platform_name)
+  FROM game g
+  LEFT JOIN category c ON g.idCategory = c.idCategory
+  LEFT JOIN review r ON g.idGame = r.idGame AND r.IsActive = 1
+  LEFT JOIN platform p ON r.idPlatform = p.idPlatform
+  WHERE g.idGame = ?
+  GROUP BY g.idGame
+`;
+
+// Same switch as AdminPanel config.json game_summary.enabled: turn both on together,
+// after server/migrations/add_game_summary.sql has been applied
+const gameSummaryEnabled = process.env.GAME_SUMMARY_ENABLED === 'true';
+
+// Recalculate one game's summary row after a write; the write itself has already succeeded
+async function refreshGameSummary(gameId) {
+  if (!gameSummaryEnabled) {
+    return;
+  }
+  try {
+    await pool.execute(REFRESH_SQL, [gameId]);
+  } catch (error) {
+    console.warn('Failed to refresh game summary:', error.message);
+  }
+}
+
+module.exports = { gameSummaryEnabled, refreshGameSummary };